@@ -0,0 +1,260 @@
+/**
+ * @file AnimChannelBenchmarks.cpp
+ * @author Shawn_Porto
+ *
+ * Benchmarks for animation channel evaluation and loading
+ */
+
+#include <pch.h>
+#include <benchmark/benchmark.h>
+
+#include <wx/filename.h>
+
+#include <Timeline.h>
+#include <AnimChannelAngle.h>
+#include <AnimBinary.h>
+#include <AnimXmlReader.h>
+#include <AnimXmlWriter.h>
+
+#include "BenchmarkSupport.h"
+
+/// Frames between keyframes in the channel benchmarks
+const int ChannelKeyframeSpacing = 10;
+
+/**
+ * Fill a channel with keyframes
+ * @param timeline Timeline the channel is on
+ * @param channel Channel to fill
+ * @param numKeyframes Number of keyframes to create
+ */
+static void FillChannel(Timeline &timeline, AnimChannelAngle &channel, int numKeyframes)
+{
+    timeline.AddChannel(&channel);
+    timeline.SetNumFrames(numKeyframes * ChannelKeyframeSpacing);
+
+    for (int k = 0; k < numKeyframes; k++)
+    {
+        timeline.SetCurrentTime((double)(k * ChannelKeyframeSpacing) / timeline.GetFrameRate());
+        channel.SetKeyframe(k * 0.1);
+    }
+}
+
+/**
+ * Evaluate a channel frame after frame, as playback does
+ * @param state Benchmark state, range(0) is the number of keyframes
+ */
+static void BM_AnimChannelSetFrameSequential(benchmark::State& state)
+{
+    Timeline timeline;
+    AnimChannelAngle channel;
+    FillChannel(timeline, channel, (int)state.range(0));
+
+    int numFrames = timeline.GetNumFrames();
+    int frame = 0;
+    for (auto _ : state)
+    {
+        frame = (frame + 1) % numFrames;
+        timeline.SetCurrentTime((double)frame / timeline.GetFrameRate());
+        benchmark::DoNotOptimize(channel.GetAngle());
+    }
+}
+BENCHMARK(BM_AnimChannelSetFrameSequential)->RangeMultiplier(4)->Range(2, 4096);
+
+/**
+ * Evaluate a channel at frames scattered across the timeline, as scrubbing does
+ * @param state Benchmark state, range(0) is the number of keyframes
+ */
+static void BM_AnimChannelSetFrameRandom(benchmark::State& state)
+{
+    Timeline timeline;
+    AnimChannelAngle channel;
+    FillChannel(timeline, channel, (int)state.range(0));
+
+    unsigned numFrames = timeline.GetNumFrames();
+    unsigned seed = 12345;
+    for (auto _ : state)
+    {
+        // Small LCG so every run visits the same frames
+        seed = seed * 1103515245u + 12345u;
+        int frame = (int)((seed >> 8) % numFrames);
+        timeline.SetCurrentTime((double)frame / timeline.GetFrameRate());
+        benchmark::DoNotOptimize(channel.GetAngle());
+    }
+}
+BENCHMARK(BM_AnimChannelSetFrameRandom)->RangeMultiplier(4)->Range(2, 4096);
+
+/**
+ * Evaluate a channel at scattered frames without moving the timeline
+ * @param state Benchmark state, range(0) is the number of keyframes
+ */
+static void BM_AnimChannelEvaluateRandom(benchmark::State& state)
+{
+    Timeline timeline;
+    AnimChannelAngle channel;
+    FillChannel(timeline, channel, (int)state.range(0));
+
+    unsigned numFrames = timeline.GetNumFrames();
+    unsigned seed = 12345;
+    for (auto _ : state)
+    {
+        seed = seed * 1103515245u + 12345u;
+        int frame = (int)((seed >> 8) % numFrames);
+        benchmark::DoNotOptimize(channel.Evaluate((double)frame / timeline.GetFrameRate()));
+    }
+}
+BENCHMARK(BM_AnimChannelEvaluateRandom)->RangeMultiplier(4)->Range(2, 4096);
+
+/// Number of channels in the animation load benchmark
+const int LoadNumChannels = 200;
+
+/**
+ * Load a timeline with many channels from an XML tree already in memory,
+ * so only the channel lookup and keyframe insertion are measured
+ * @param state Benchmark state, range(0) is the number of keyframes per channel
+ */
+static void BM_TimelineLoad(benchmark::State& state)
+{
+    int numKeyframes = (int)state.range(0);
+
+    Timeline timeline;
+    std::vector<std::unique_ptr<AnimChannelAngle>> channels;
+    for (int c = 0; c < LoadNumChannels; c++)
+    {
+        auto channel = std::make_unique<AnimChannelAngle>();
+        channel->SetName(L"channel" + std::to_wstring(c));
+        timeline.AddChannel(channel.get());
+        channels.push_back(std::move(channel));
+    }
+
+    wxXmlNode root(wxXML_ELEMENT_NODE, L"anim");
+    root.AddAttribute(L"numframes", wxString::Format(wxT("%i"), numKeyframes * ChannelKeyframeSpacing));
+    root.AddAttribute(L"framerate", L"30");
+
+    // Channels in reverse order, so a list search would be at its worst
+    for (int c = LoadNumChannels - 1; c >= 0; c--)
+    {
+        auto channelNode = new wxXmlNode(wxXML_ELEMENT_NODE, L"channel");
+        channelNode->AddAttribute(L"name", L"channel" + std::to_wstring(c));
+        root.AddChild(channelNode);
+
+        // AddChild walks the child list, so append after the last node instead
+        wxXmlNode *last = nullptr;
+        for (int k = 0; k < numKeyframes; k++)
+        {
+            auto keyframeNode = new wxXmlNode(wxXML_ELEMENT_NODE, L"keyframe");
+            keyframeNode->AddAttribute(L"frame", wxString::Format(wxT("%i"), k * ChannelKeyframeSpacing));
+            keyframeNode->AddAttribute(L"angle", wxString::Format(wxT("%f"), k * 0.1));
+            if (last == nullptr)
+            {
+                channelNode->AddChild(keyframeNode);
+            }
+            else
+            {
+                channelNode->InsertChildAfter(keyframeNode, last);
+            }
+            last = keyframeNode;
+        }
+    }
+
+    for (auto _ : state)
+    {
+        timeline.Load(&root);
+        benchmark::DoNotOptimize(channels.front()->GetNumKeyframes());
+    }
+
+    state.SetItemsProcessed(state.iterations() * LoadNumChannels * numKeyframes);
+}
+BENCHMARK(BM_TimelineLoad)->Arg(500)->Arg(5000)->Unit(benchmark::kMillisecond);
+
+/**
+ * Add the load benchmark channels to a timeline and fill them with keyframes
+ * @param timeline Timeline to add the channels to
+ * @param channels Receives the channels, which the timeline does not own
+ * @param numKeyframes Number of keyframes per channel
+ */
+static void FillLoadChannels(Timeline &timeline, std::vector<std::unique_ptr<AnimChannelAngle>> &channels, int numKeyframes)
+{
+    timeline.SetNumFrames(numKeyframes * ChannelKeyframeSpacing);
+    for (int c = 0; c < LoadNumChannels; c++)
+    {
+        auto channel = std::make_unique<AnimChannelAngle>();
+        channel->SetName(L"channel" + std::to_wstring(c));
+        timeline.AddChannel(channel.get());
+
+        for (int k = 0; k < numKeyframes; k++)
+        {
+            channel->SetKeyframe(k * ChannelKeyframeSpacing, k * 0.1);
+        }
+
+        channels.push_back(std::move(channel));
+    }
+}
+
+/**
+ * Load a long animation from an XML .anim file, streaming it in
+ * @param state Benchmark state, range(0) is the number of keyframes per channel
+ */
+static void BM_AnimFileLoadXml(benchmark::State& state)
+{
+    Timeline timeline;
+    std::vector<std::unique_ptr<AnimChannelAngle>> channels;
+    FillLoadChannels(timeline, channels, (int)state.range(0));
+
+    auto filename = BenchmarkTempFile(L".anim");
+    {
+        AnimXmlWriter writer;
+        writer.Open(filename);
+        wxXmlNode root(wxXML_ELEMENT_NODE, L"anim");
+        timeline.XmlSaveAttributes(&root);
+        writer.StartElement(&root);
+        timeline.Save(&writer);
+        writer.EndElement();
+        writer.Close();
+    }
+
+    for (auto _ : state)
+    {
+        AnimXmlReader reader;
+        reader.Parse(filename, [&timeline](wxXmlNode *element, int depth) {
+            if (depth == 0)
+            {
+                timeline.XmlStartLoad(element);
+            }
+            else
+            {
+                timeline.XmlLoadElement(element, depth);
+            }
+        });
+        timeline.XmlEndLoad();
+        benchmark::DoNotOptimize(channels.front()->GetNumKeyframes());
+    }
+
+    wxRemoveFile(filename);
+    state.SetItemsProcessed(state.iterations() * LoadNumChannels * state.range(0));
+}
+BENCHMARK(BM_AnimFileLoadXml)->Arg(500)->Arg(5000)->Unit(benchmark::kMillisecond);
+
+/**
+ * Load the same animation from a memory mapped binary .animb file
+ * @param state Benchmark state, range(0) is the number of keyframes per channel
+ */
+static void BM_AnimFileLoadBinary(benchmark::State& state)
+{
+    Timeline timeline;
+    std::vector<std::unique_ptr<AnimChannelAngle>> channels;
+    FillLoadChannels(timeline, channels, (int)state.range(0));
+
+    auto filename = BenchmarkTempFile(L".animb");
+    AnimBinary binary;
+    binary.Save(filename, &timeline);
+
+    for (auto _ : state)
+    {
+        binary.Load(filename, &timeline);
+        benchmark::DoNotOptimize(channels.front()->GetNumKeyframes());
+    }
+
+    wxRemoveFile(filename);
+    state.SetItemsProcessed(state.iterations() * LoadNumChannels * state.range(0));
+}
+BENCHMARK(BM_AnimFileLoadBinary)->Arg(500)->Arg(5000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,151 @@
+/**
+ * @file BenchmarkSupport.cpp
+ * @author Shawn_Porto
+ */
+
+#include <pch.h>
+#include <wx/filename.h>
+
+#include "BenchmarkSupport.h"
+
+#include <Picture.h>
+#include <PictureFactory.h>
+#include <Actor.h>
+#include <PolyDrawable.h>
+
+/// Jointed segments in each actor of the crowd picture
+const int CrowdSegments = 6;
+
+/**
+ * Constructor
+ * @param width Bitmap width in pixels
+ * @param height Bitmap height in pixels
+ */
+OffscreenGraphics::OffscreenGraphics(int width, int height) : mBitmap(width, height, 32)
+{
+    mDC.SelectObject(mBitmap);
+    mDC.SetBackground(*wxWHITE_BRUSH);
+    mDC.Clear();
+    mGraphics = std::shared_ptr<wxGraphicsContext>(wxGraphicsContext::Create(mDC));
+}
+
+/**
+ * Destructor
+ */
+OffscreenGraphics::~OffscreenGraphics()
+{
+    mGraphics.reset();
+    mDC.SelectObject(wxNullBitmap);
+}
+
+/**
+ * Create the standard picture with keyframes on every actor.
+ *
+ * Actor positions wander a little between keyframes so
+ * every keyframe holds a distinct value.
+ * @param numFrames Number of frames in the timeline
+ * @param keyframeSpacing Frames between keyframes
+ * @return The created picture
+ */
+std::shared_ptr<Picture> CreateKeyedPicture(int numFrames, int keyframeSpacing)
+{
+    PictureFactory factory;
+    auto picture = factory.Create(BenchmarkResourcesDir);
+
+    auto timeline = picture->GetTimeline();
+    timeline->SetNumFrames(numFrames);
+
+    for (int frame = 0; frame <= numFrames; frame += keyframeSpacing)
+    {
+        picture->SetAnimationTime((double)frame / timeline->GetFrameRate());
+
+        int i = 0;
+        for (auto actor : *picture)
+        {
+            i++;
+            actor->SetPosition(actor->GetPosition() + wxPoint((frame + i) % 7 - 3, (frame * i) % 5 - 2));
+            actor->SetKeyframe();
+        }
+    }
+
+    picture->SetAnimationTime(0);
+    return picture;
+}
+
+/**
+ * Create a picture of a crowd of actors, each a chain of jointed
+ * segments whose position and rotations are all keyframed.
+ * @param numActors Number of actors in the crowd
+ * @param numFrames Number of frames in the timeline
+ * @param keyframeSpacing Frames between keyframes
+ * @return The created picture
+ */
+std::shared_ptr<Picture> CreateCrowdPicture(int numActors, int numFrames, int keyframeSpacing)
+{
+    auto picture = std::make_shared<Picture>();
+    for (int a = 0; a < numActors; a++)
+    {
+        auto actor = std::make_shared<Actor>(L"Extra" + std::to_wstring(a));
+        actor->SetPosition(wxPoint((a * 37) % 1500, 200 + (a * 11) % 500));
+
+        std::shared_ptr<Drawable> parent;
+        for (int s = 0; s < CrowdSegments; s++)
+        {
+            auto segment = std::make_shared<PolyDrawable>(L"Segment" + std::to_wstring(s));
+            segment->AddPoint(wxPoint(-4, 0));
+            segment->AddPoint(wxPoint(4, 0));
+            segment->AddPoint(wxPoint(4, 20));
+            segment->AddPoint(wxPoint(-4, 20));
+            actor->AddDrawable(segment);
+            if (parent == nullptr)
+            {
+                actor->SetRoot(segment);
+            }
+            else
+            {
+                segment->SetPosition(wxPoint(0, 20));
+                parent->AddChild(segment);
+            }
+
+            parent = segment;
+        }
+
+        picture->AddActor(actor);
+    }
+
+    auto timeline = picture->GetTimeline();
+    timeline->SetNumFrames(numFrames);
+
+    for (int frame = 0; frame <= numFrames; frame += keyframeSpacing)
+    {
+        picture->SetAnimationTime((double)frame / timeline->GetFrameRate());
+
+        int i = 0;
+        for (auto actor : *picture)
+        {
+            i++;
+            actor->SetPosition(actor->GetPosition() + wxPoint((frame + i) % 7 - 3, (frame * i) % 5 - 2));
+            for (auto &drawable : actor->GetDrawables())
+            {
+                drawable->SetRotation(0.1 * (((frame + i) % 9) - 4));
+            }
+
+            actor->SetKeyframe();
+        }
+    }
+
+    picture->SetAnimationTime(0);
+    return picture;
+}
+
+/**
+ * Get a temporary file name for benchmarks that save files
+ * @param extension File extension including the period
+ * @return Path to a file that does not exist yet
+ */
+std::wstring BenchmarkTempFile(const std::wstring &extension)
+{
+    auto name = wxFileName::CreateTempFileName(L"canadian-benchmark");
+    wxRemoveFile(name);
+    return (name + extension).ToStdWstring();
+}
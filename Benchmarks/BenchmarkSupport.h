@@ -0,0 +1,56 @@
+/**
+ * @file BenchmarkSupport.h
+ * @author Shawn_Porto
+ *
+ * Fixtures shared by the benchmarks
+ */
+
+#ifndef CANADIANEXPERIENCE_BENCHMARKSUPPORT_H
+#define CANADIANEXPERIENCE_BENCHMARKSUPPORT_H
+
+#include <memory>
+#include <string>
+
+class Picture;
+
+/// Resources directory relative to the benchmark working directory
+const std::wstring BenchmarkResourcesDir = L".";
+
+/**
+ * An offscreen bitmap selected into a wxMemoryDC with a
+ * graphics context to draw on it.
+ */
+class OffscreenGraphics
+{
+private:
+    /// The bitmap we draw into
+    wxBitmap mBitmap;
+
+    /// Memory device context for the bitmap
+    wxMemoryDC mDC;
+
+    /// Graphics context on the memory DC
+    std::shared_ptr<wxGraphicsContext> mGraphics;
+
+public:
+    OffscreenGraphics(int width, int height);
+    ~OffscreenGraphics();
+
+    /** Copy constructor disabled */
+    OffscreenGraphics(const OffscreenGraphics &) = delete;
+    /** Assignment operator disabled */
+    void operator=(const OffscreenGraphics &) = delete;
+
+    /**
+     * Get the graphics context
+     * @return Graphics context that draws into the bitmap
+     */
+    std::shared_ptr<wxGraphicsContext> GetGraphics() { return mGraphics; }
+};
+
+std::shared_ptr<Picture> CreateKeyedPicture(int numFrames, int keyframeSpacing);
+std::shared_ptr<Picture> CreateCrowdPicture(int numActors, int numFrames, int keyframeSpacing);
+
+std::wstring BenchmarkTempFile(const std::wstring &extension);
+
+#endif //CANADIANEXPERIENCE_BENCHMARKSUPPORT_H
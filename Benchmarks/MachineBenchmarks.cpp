@@ -0,0 +1,149 @@
+/**
+ * @file MachineBenchmarks.cpp
+ * @author Shawn_Porto
+ *
+ * Benchmarks for the machine simulation and drawing
+ */
+
+#include <pch.h>
+#include <benchmark/benchmark.h>
+
+#include <MachineSystem.h>
+#include <MachineFactories.h>
+#include <Machine.h>
+#include <MachineStateCache.h>
+
+#include "BenchmarkSupport.h"
+
+/// Frame rate used by the machine benchmarks
+const double MachineFrameRate = 30;
+
+/// Frame the forward stepping benchmark wraps around at
+const int ForwardWrapFrame = 3000;
+
+/**
+ * Step the machine forward one frame at a time, as playback does
+ * @param state Benchmark state, range(0) is the machine number
+ */
+static void BM_MachineSetFrameForward(benchmark::State& state)
+{
+    MachineSystem system(BenchmarkResourcesDir);
+    system.ChooseMachine((int)state.range(0));
+    system.SetFrameRate(MachineFrameRate);
+
+    int frame = 0;
+    for (auto _ : state)
+    {
+        frame++;
+        if (frame > ForwardWrapFrame)
+        {
+            state.PauseTiming();
+            frame = 1;
+            system.SetMachineFrame(0);
+            state.ResumeTiming();
+        }
+
+        system.SetMachineFrame(frame);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MachineSetFrameForward)->Arg(1)->Arg(2);
+
+/**
+ * Step the machine back one frame, which replays from the start
+ * @param state Benchmark state, range(0) is the frame we step back from
+ */
+static void BM_MachineSetFrameBackward(benchmark::State& state)
+{
+    MachineSystem system(BenchmarkResourcesDir);
+    system.SetFrameRate(MachineFrameRate);
+
+    int frame = (int)state.range(0);
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        system.SetMachineFrame(frame);
+        state.ResumeTiming();
+
+        system.SetMachineFrame(frame - 1);
+    }
+}
+BENCHMARK(BM_MachineSetFrameBackward)->Arg(30)->Arg(300)->Arg(900);
+
+/**
+ * Jump from the start of the animation to a distant frame
+ * @param state Benchmark state, range(0) is the frame to jump to
+ */
+static void BM_MachineSetFrameJump(benchmark::State& state)
+{
+    MachineSystem system(BenchmarkResourcesDir);
+    system.SetFrameRate(MachineFrameRate);
+
+    int frame = (int)state.range(0);
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        system.SetMachineFrame(0);
+        state.ResumeTiming();
+
+        system.SetMachineFrame(frame);
+    }
+
+    state.SetItemsProcessed(state.iterations() * frame);
+}
+BENCHMARK(BM_MachineSetFrameJump)->Arg(300)->Arg(3000)->Arg(9000);
+
+/**
+ * Scrub back and forth near a distant frame through the
+ * checkpoints, as the edit view does when the playhead is dragged
+ * @param state Benchmark state, range(0) is the frame scrubbed around
+ */
+static void BM_MachineScrubCached(benchmark::State& state)
+{
+    auto system = std::make_shared<MachineSystem>(BenchmarkResourcesDir);
+    MachineStateCache cache;
+    cache.SetSystem(system);
+    cache.SetFrameRate(MachineFrameRate);
+
+    int frame = (int)state.range(0);
+    cache.SetMachineFrame(frame);
+
+    // Steps back one frame at a time, then jumps back
+    // up, so every step resumes from a checkpoint
+    int step = 0;
+    for (auto _ : state)
+    {
+        step = (step + 1) % MachineCheckpointSpacing;
+        cache.SetMachineFrame(frame - step);
+    }
+}
+BENCHMARK(BM_MachineScrubCached)->Arg(300)->Arg(3000)->Arg(10000)->Unit(benchmark::kMicrosecond);
+
+/**
+ * Draw a machine into a wxMemoryDC
+ * @param state Benchmark state, range(0) is the machine number
+ */
+static void BM_MachineDraw(benchmark::State& state)
+{
+    std::shared_ptr<Machine> machine;
+    if (state.range(0) == 2)
+    {
+        Machine2Factory factory(BenchmarkResourcesDir);
+        machine = factory.CreateMachine(wxPoint(400, 500));
+    }
+    else
+    {
+        Machine1Factory factory(BenchmarkResourcesDir);
+        machine = factory.CreateMachine(wxPoint(400, 500));
+    }
+
+    OffscreenGraphics offscreen(800, 600);
+    auto graphics = offscreen.GetGraphics();
+
+    for (auto _ : state)
+    {
+        machine->Draw(graphics);
+    }
+}
+BENCHMARK(BM_MachineDraw)->Arg(1)->Arg(2);
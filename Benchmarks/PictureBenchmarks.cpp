@@ -0,0 +1,137 @@
+/**
+ * @file PictureBenchmarks.cpp
+ * @author Shawn_Porto
+ *
+ * Benchmarks for whole picture evaluation and file I/O
+ */
+
+#include <pch.h>
+#include <benchmark/benchmark.h>
+#include <wx/filename.h>
+
+#include <Picture.h>
+
+#include "BenchmarkSupport.h"
+
+/// Number of frames in the picture benchmarks' timeline
+const int PictureNumFrames = 9000;
+
+/// Number of frames in the crowd benchmark's timeline
+const int PictureCrowdNumFrames = 600;
+
+/// Frames between keyframes in the crowd benchmark
+const int PictureCrowdKeyframeSpacing = 5;
+
+/**
+ * Advance the whole picture one frame at a time, as playback does
+ * @param state Benchmark state, range(0) is the frames between keyframes
+ */
+static void BM_PictureSetAnimationTime(benchmark::State& state)
+{
+    auto picture = CreateKeyedPicture(PictureNumFrames, (int)state.range(0));
+    auto timeline = picture->GetTimeline();
+
+    int frame = 0;
+    for (auto _ : state)
+    {
+        frame = (frame + 1) % PictureNumFrames;
+        picture->SetAnimationTime((double)frame / timeline->GetFrameRate());
+    }
+}
+BENCHMARK(BM_PictureSetAnimationTime)->Arg(1)->Arg(30);
+
+/**
+ * Advance a crowd scene one frame at a time on a number of threads.
+ *
+ * Comparing items_per_second across the thread counts for the
+ * same number of actors shows how the work scales with cores.
+ * Thread counts above the number of cores only add overhead.
+ * @param state Benchmark state, range(0) is the number of actors
+ * and range(1) the number of threads
+ */
+static void BM_PictureCrowdSetAnimationTime(benchmark::State& state)
+{
+    int numActors = (int)state.range(0);
+    auto picture = CreateCrowdPicture(numActors, PictureCrowdNumFrames, PictureCrowdKeyframeSpacing);
+    picture->GetThreadPool()->SetNumThreads((int)state.range(1));
+    auto timeline = picture->GetTimeline();
+
+    int frame = 0;
+    for (auto _ : state)
+    {
+        frame = (frame + 1) % PictureCrowdNumFrames;
+        picture->SetAnimationTime((double)frame / timeline->GetFrameRate());
+    }
+
+    state.SetItemsProcessed(state.iterations() * numActors);
+}
+BENCHMARK(BM_PictureCrowdSetAnimationTime)
+    ->ArgsProduct({{100, 400, 1600}, {1, 2, 4, 8}})->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+/**
+ * Advance a crowd scene where nothing moves on a number of threads.
+ *
+ * The crowd only has keyframes at the start, so every frame
+ * evaluates the channels and nothing is placed again. This is
+ * the part of a frame that is paid for every actor whether it
+ * moves or not.
+ * @param state Benchmark state, range(0) is the number of actors
+ * and range(1) the number of threads
+ */
+static void BM_PictureHeldCrowdSetAnimationTime(benchmark::State& state)
+{
+    int numActors = (int)state.range(0);
+    auto picture = CreateCrowdPicture(numActors, PictureCrowdNumFrames, PictureCrowdNumFrames + 1);
+    picture->GetThreadPool()->SetNumThreads((int)state.range(1));
+    auto timeline = picture->GetTimeline();
+
+    int frame = 0;
+    for (auto _ : state)
+    {
+        frame = (frame + 1) % PictureCrowdNumFrames;
+        picture->SetAnimationTime((double)frame / timeline->GetFrameRate());
+    }
+
+    state.SetItemsProcessed(state.iterations() * numActors);
+}
+BENCHMARK(BM_PictureHeldCrowdSetAnimationTime)
+    ->ArgsProduct({{1600}, {1, 2, 4, 8}})->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+/**
+ * Save a large animation file
+ * @param state Benchmark state, range(0) is the frames between keyframes
+ */
+static void BM_PictureSave(benchmark::State& state)
+{
+    auto picture = CreateKeyedPicture(PictureNumFrames, (int)state.range(0));
+    auto filename = BenchmarkTempFile(L".anim");
+
+    for (auto _ : state)
+    {
+        picture->Save(filename);
+    }
+
+    state.SetBytesProcessed(state.iterations() * wxFileName::GetSize(filename).GetValue());
+    wxRemoveFile(filename);
+}
+BENCHMARK(BM_PictureSave)->Arg(1)->Arg(30)->Unit(benchmark::kMillisecond);
+
+/**
+ * Load a large animation file
+ * @param state Benchmark state, range(0) is the frames between keyframes
+ */
+static void BM_PictureLoad(benchmark::State& state)
+{
+    auto picture = CreateKeyedPicture(PictureNumFrames, (int)state.range(0));
+    auto filename = BenchmarkTempFile(L".anim");
+    picture->Save(filename);
+
+    for (auto _ : state)
+    {
+        picture->Load(filename);
+    }
+
+    state.SetBytesProcessed(state.iterations() * wxFileName::GetSize(filename).GetValue());
+    wxRemoveFile(filename);
+}
+BENCHMARK(BM_PictureLoad)->Arg(1)->Arg(30)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,83 @@
+/**
+ * @file PolygonBenchmarks.cpp
+ * @author Shawn_Porto
+ *
+ * Benchmarks for the machine drawing primitives
+ */
+
+#include <pch.h>
+#include <benchmark/benchmark.h>
+
+#include <Polygon.h>
+#include <Cylinder.h>
+
+#include "BenchmarkSupport.h"
+
+/// Image used for the image polygon benchmark
+const std::wstring PolygonImage = BenchmarkResourcesDir + L"/images/box-lid.png";
+
+/**
+ * Draw a solid color polygon
+ * @param state Benchmark state
+ */
+static void BM_PolygonDrawColor(benchmark::State& state)
+{
+    cse335::Polygon polygon;
+    polygon.Rectangle(-100, 0, 200, 200);
+    polygon.SetColor(*wxBLUE);
+
+    OffscreenGraphics offscreen(400, 400);
+    auto graphics = offscreen.GetGraphics();
+
+    double rotation = 0;
+    for (auto _ : state)
+    {
+        polygon.DrawPolygon(graphics, 200, 300, rotation);
+        rotation += 0.01;
+    }
+}
+BENCHMARK(BM_PolygonDrawColor);
+
+/**
+ * Draw an image mapped polygon
+ * @param state Benchmark state
+ */
+static void BM_PolygonDrawImage(benchmark::State& state)
+{
+    cse335::Polygon polygon;
+    polygon.Rectangle(-100, 0, 200, 200);
+    polygon.SetImage(PolygonImage);
+
+    OffscreenGraphics offscreen(400, 400);
+    auto graphics = offscreen.GetGraphics();
+
+    double rotation = 0;
+    for (auto _ : state)
+    {
+        polygon.DrawPolygon(graphics, 200, 300, rotation);
+        rotation += 0.01;
+    }
+}
+BENCHMARK(BM_PolygonDrawImage);
+
+/**
+ * Draw a cylinder with turning lines
+ * @param state Benchmark state
+ */
+static void BM_CylinderDraw(benchmark::State& state)
+{
+    cse335::Cylinder cylinder;
+    cylinder.SetSize(40, 200);
+    cylinder.SetLines(*wxBLACK, 2, 8);
+
+    OffscreenGraphics offscreen(400, 400);
+    auto graphics = offscreen.GetGraphics();
+
+    double rotation = 0;
+    for (auto _ : state)
+    {
+        cylinder.Draw(graphics, 100, 200, rotation);
+        rotation += 0.01;
+    }
+}
+BENCHMARK(BM_CylinderDraw);
@@ -0,0 +1,67 @@
+/**
+ * @file benchmark_main.cpp
+ * @author Shawn_Porto
+ *
+ * Entry point for the benchmark suite.
+ *
+ * Unless told otherwise on the command line, results are
+ * written as JSON to benchmarks.json in the working directory
+ * so runs can be compared across releases.
+ */
+
+#include <pch.h>
+#include <benchmark/benchmark.h>
+#include <wx/filefn.h>
+
+#include <string>
+#include <vector>
+
+/// File results are written to when no --benchmark_out is given
+const char *DefaultOutputFile = "--benchmark_out=benchmarks.json";
+
+/// Output format used with the default output file
+const char *DefaultOutputFormat = "--benchmark_out_format=json";
+
+int main(int argc, char** argv)
+{
+    // The drawing benchmarks need the GUI toolkit initialized
+    wxApp::SetInstance(new wxApp());
+    int wxArgc = 1;
+    if (!wxEntryStart(wxArgc, argv))
+    {
+        return 1;
+    }
+
+    wxSetWorkingDirectory(L"..");
+    wxInitAllImageHandlers();
+
+    std::vector<char *> args(argv, argv + argc);
+    bool hasOutput = false;
+    for (auto arg : args)
+    {
+        if (std::string(arg).rfind("--benchmark_out=", 0) == 0)
+        {
+            hasOutput = true;
+        }
+    }
+
+    if (!hasOutput)
+    {
+        args.push_back(const_cast<char *>(DefaultOutputFile));
+        args.push_back(const_cast<char *>(DefaultOutputFormat));
+    }
+
+    int benchmarkArgc = (int)args.size();
+    benchmark::Initialize(&benchmarkArgc, args.data());
+    if (benchmark::ReportUnrecognizedArguments(benchmarkArgc, args.data()))
+    {
+        wxEntryCleanup();
+        return 1;
+    }
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    wxEntryCleanup();
+    return 0;
+}
@@ -6,10 +6,16 @@
 #include "pch.h"
 
 #include <sstream>
+#include <typeinfo>
+
+#include "TextureAtlas.h"
 
 #include "Actor.h"
 #include "Drawable.h"
+#include "ImageDrawable.h"
+#include "PolyDrawable.h"
 #include "Picture.h"
+#include "Trace.h"
 
 /**
  * Constructor
@@ -18,6 +24,7 @@ Actor::Actor(const std::wstring &name) : mName(name)
 {
     // Set the channel name
     mChannel.SetName(name + L":position");
+    mChannel.SetObserver(this);
 }
 
 
@@ -28,27 +35,211 @@ Actor::Actor(const std::wstring &name) : mName(name)
 void Actor::SetRoot(std::shared_ptr<Drawable> root)
 {
    mRoot = root;
+   mRenderListDirty = true;
 }
 
 /**
  * Draw this actor
  * @param graphics The Graphics object we are drawing on
+ * @param viewport Part of the drawing that is visible. Drawables
+ * entirely outside of it are skipped. An empty viewport draws everything.
  */
-void Actor::Draw(std::shared_ptr<wxGraphicsContext> graphics)
+void Actor::Draw(std::shared_ptr<wxGraphicsContext> graphics, const wxRect &viewport)
 {
     // Don't draw if not enabled
     if (!mEnabled)
         return;
 
-    // This takes care of determining the absolute placement
-    // of all of the child drawables. We have to determine this
-    // in tree order, which may not be the order we draw.
+    TraceSpan span("Actor::Draw");
+
+    Place();
+
+    if (mRenderListDirty)
+    {
+        BuildRenderList();
+    }
+
+    auto renderer = graphics->GetRenderer();
+    for (auto &command : mRenderList)
+    {
+        if (command.kind == RenderKind::Custom)
+        {
+            auto bounds = command.drawable->GetBounds();
+            if (viewport.IsEmpty() || bounds.IsEmpty() || bounds.Intersects(viewport))
+            {
+                command.drawable->Draw(graphics);
+            }
+
+            continue;
+        }
+
+        // Images and polygons are drawn from the command itself,
+        // which only has to be updated when the drawable moved
+        if (command.placement != command.drawable->GetPlacement() || command.renderer != renderer)
+        {
+            UpdateRenderCommand(command, graphics);
+        }
+
+        if (!viewport.IsEmpty() && !command.bounds.IsEmpty() && !command.bounds.Intersects(viewport))
+        {
+            continue;
+        }
+
+        graphics->PushState();
+        graphics->ConcatTransform(command.matrix);
+        if (command.kind == RenderKind::Image)
+        {
+            command.atlas->Draw(graphics, command.image, command.origin.x, command.origin.y);
+        }
+        else if (!command.path->IsNull())
+        {
+            graphics->SetBrush(*command.brush);
+            graphics->FillPath(*command.path);
+        }
+        graphics->PopState();
+    }
+}
+
+
+/**
+ * Determine the absolute placement of all of the drawables.
+ *
+ * We have to determine this in tree order, which may not be
+ * the order we draw. Drawables that did not move since the
+ * last time cost nothing.
+ * @return true if any drawable was placed somewhere new
+ */
+bool Actor::Place()
+{
     if (mRoot != nullptr)
-        mRoot->Place(mPosition, 0);
+    {
+        TraceSpan placeSpan("Drawable::Place");
+        if (mRoot->Place(mPosition, 0))
+        {
+            mPlacedBoundsDirty = true;
+            return true;
+        }
+    }
 
-    for (auto drawable : mDrawablesInOrder)
+    return false;
+}
+
+
+/**
+ * Get the bounding rectangle of everything the actor draws.
+ * @return Bounding rectangle, empty if any drawable's bounds are not known
+ */
+wxRect Actor::GetBounds()
+{
+    Place();
+    return GetPlacedBounds();
+}
+
+
+/**
+ * Get the bounding rectangle of the drawables where they were
+ * last placed, without placing them again.
+ *
+ * The bounds are only computed again after the drawables moved.
+ * @return Bounding rectangle, empty if any drawable's bounds are not known
+ */
+wxRect Actor::GetPlacedBounds()
+{
+    if (!mPlacedBoundsDirty)
+    {
+        return mPlacedBounds;
+    }
+
+    mPlacedBoundsDirty = false;
+    mPlacedBounds = wxRect();
+    for (auto &drawable : mDrawablesInOrder)
+    {
+        auto drawableBounds = drawable->GetBounds();
+        if (drawableBounds.IsEmpty())
+        {
+            mPlacedBounds = wxRect();
+            break;
+        }
+
+        mPlacedBounds.Union(drawableBounds);
+    }
+
+    return mPlacedBounds;
+}
+
+
+/**
+ * Build the render list from the drawables in drawing order.
+ *
+ * This only happens when drawables are added or the actor
+ * is put in a picture, not every frame.
+ */
+void Actor::BuildRenderList()
+{
+    mRenderList.clear();
+    mRenderList.reserve(mDrawablesInOrder.size());
+
+    for (auto &drawable : mDrawablesInOrder)
+    {
+        RenderCommand command;
+        command.kind = RenderKind::Custom;
+        command.drawable = drawable.get();
+
+        // Only the exact types can be drawn from a command, a
+        // derived class may draw differently.
+        auto &type = typeid(*drawable);
+        if (type == typeid(ImageDrawable))
+        {
+            auto image = static_cast<ImageDrawable *>(drawable.get());
+            if (image->GetAtlasImage() >= 0)
+            {
+                command.kind = RenderKind::Image;
+                command.atlas = image->GetAtlas();
+                command.image = image->GetAtlasImage();
+            }
+        }
+        else if (type == typeid(PolyDrawable))
+        {
+            auto poly = static_cast<PolyDrawable *>(drawable.get());
+            command.kind = RenderKind::Polygon;
+            command.brush = &poly->GetBrush();
+        }
+
+        mRenderList.push_back(command);
+    }
+
+    mRenderListDirty = false;
+}
+
+
+/**
+ * Update a render command from the placement of its drawable.
+ * @param command Command to update
+ * @param graphics Graphics context the command is drawn on
+ */
+void Actor::UpdateRenderCommand(RenderCommand &command, std::shared_ptr<wxGraphicsContext> graphics)
+{
+    auto drawable = command.drawable;
+    auto position = drawable->GetPlacedPosition();
+
+    // The same transformation the drawables apply when they draw themselves
+    command.matrix = graphics->CreateMatrix();
+    command.matrix.Translate(position.x, position.y);
+    command.matrix.Rotate(-drawable->GetPlacedRotation());
+
+    command.bounds = drawable->GetBounds();
+    command.placement = drawable->GetPlacement();
+    command.renderer = graphics->GetRenderer();
+
+    if (command.kind == RenderKind::Image)
+    {
+        auto center = static_cast<ImageDrawable *>(drawable)->GetCenter();
+        command.origin = wxPoint(-center.x, -center.y);
+    }
+    else
     {
-        drawable->Draw(graphics);
+        // Adding points starts a new path and moves the drawable
+        command.path = &static_cast<PolyDrawable *>(drawable)->GetPath(graphics);
     }
 }
 
@@ -64,11 +255,15 @@ std::shared_ptr<Drawable> Actor::HitTest(wxPoint pos)
     if (!mClickable || !mEnabled)
         return nullptr;
 
+    // Make sure the placement is current, we may
+    // not have been drawn since something moved.
+    Place();
+
     // Since this list is in drawing order, we realy want to know the last thing drawn
     // under the mouse, since it will be on top. So, we reverse iterate over the list.
     for (auto d = mDrawablesInOrder.rbegin(); d != mDrawablesInOrder.rend(); d++)
     {
-        auto drawable = *d;
+        auto &drawable = *d;
         if (drawable->HitTest(pos))
             return drawable;
     }
@@ -85,6 +280,9 @@ void Actor::AddDrawable(std::shared_ptr<Drawable> drawable)
 {
     mDrawablesInOrder.push_back(drawable);
     drawable->SetActor(this);
+    mRenderListDirty = true;
+    mPlacedBoundsDirty = true;
+    mChangesWithTime |= drawable->ChangesWithTime();
 }
 
 
@@ -94,12 +292,14 @@ void Actor::AddDrawable(std::shared_ptr<Drawable> drawable)
  * This is telling the actor what
  * picture to use.
  *
- * Also tells all child drawables what the timeline is.
+ * Also tells all child drawables what the timeline
+ * and texture atlas are.
  * @param picture The picture we are using.
  */
 void Actor::SetPicture(Picture *picture)
 {
     mPicture = picture;
+    mRenderListDirty = true;
 
     // Add the animation channel to the timeline
     mPicture->GetTimeline()->AddChannel(&mChannel);
@@ -109,6 +309,7 @@ void Actor::SetPicture(Picture *picture)
     for (auto drawable : mDrawablesInOrder)
     {
         drawable->SetTimeline(mPicture->GetTimeline());
+        drawable->SetAtlas(mPicture->GetAtlas());
     }
 }
 
@@ -140,4 +341,14 @@ void Actor::GetKeyframe()
     {
         drawable->GetKeyframe();
     }
+}
+
+/**
+ * Take the new value of the position channel when the
+ * timeline evaluates it.
+ * @param channel Channel that changed
+ */
+void Actor::OnChannelChanged(AnimChannel *channel)
+{
+    mPosition = mChannel.GetPoint();
 }
\ No newline at end of file
@@ -9,9 +9,11 @@
 #define CANADIANEXPERIENCE_ACTOR_H
 
 #include "AnimChannelPoint.h"
+#include "AnimChannelObserver.h"
 
 class Drawable;
 class Picture;
+class TextureAtlas;
 
 /**
  * Class for actors in our drawings.
@@ -19,7 +21,7 @@ class Picture;
  * An actor is some graphical object that consists of
  * one or more parts. Actors can be animated.
  */
-class Actor {
+class Actor : public AnimChannelObserver {
 private:
     /// The actor name
     std::wstring mName;
@@ -39,12 +41,70 @@ private:
     /// The drawables in drawing order
     std::vector<std::shared_ptr<Drawable>> mDrawablesInOrder;
 
+    /// How an entry in the render list is drawn
+    enum class RenderKind {Image, Polygon, Custom};
+
+    /// One entry in the render list
+    struct RenderCommand
+    {
+        /// How the entry is drawn
+        RenderKind kind;
+
+        /// The drawable the entry is for
+        Drawable *drawable;
+
+        /// Placement of the drawable the matrix and bounds are for, -1 if none yet
+        int placement = -1;
+
+        /// Renderer the matrix and path were created with
+        wxGraphicsRenderer *renderer = nullptr;
+
+        /// The placed position and rotation of the drawable
+        wxGraphicsMatrix matrix;
+
+        /// Bounds of the drawable in the drawing
+        wxRect bounds;
+
+        /// Atlas an image is drawn from
+        TextureAtlas *atlas = nullptr;
+
+        /// Index of an image in the atlas
+        int image = -1;
+
+        /// Top left of an image relative to the placed position
+        wxPoint origin;
+
+        /// Path of a polygon in its own coordinates
+        const wxGraphicsPath *path = nullptr;
+
+        /// Brush a polygon is filled with
+        const wxBrush *brush = nullptr;
+    };
+
+    /// The drawables in drawing order, flattened into draw commands
+    std::vector<RenderCommand> mRenderList;
+
+    /// True if the render list has to be rebuilt
+    bool mRenderListDirty = true;
+
+    /// Bounds of the drawables where they were last placed
+    wxRect mPlacedBounds;
+
+    /// True if the drawables were placed since mPlacedBounds was computed
+    bool mPlacedBoundsDirty = true;
+
+    /// True if any of the drawables changes with time
+    bool mChangesWithTime = false;
+
     /// The picture this actor is associated with
     Picture *mPicture = nullptr;
 
     /// The actor position channel
     AnimChannelPoint mChannel;
 
+    void BuildRenderList();
+    void UpdateRenderCommand(RenderCommand &command, std::shared_ptr<wxGraphicsContext> graphics);
+
 public:
     virtual ~Actor() {}
 
@@ -59,10 +119,32 @@ public:
 
 
     void SetRoot(std::shared_ptr<Drawable> root);
-    void Draw(std::shared_ptr<wxGraphicsContext> graphics);
+    void Draw(std::shared_ptr<wxGraphicsContext> graphics, const wxRect &viewport = wxRect());
+    bool Place();
+    wxRect GetBounds();
+    wxRect GetPlacedBounds();
     std::shared_ptr<Drawable> HitTest(wxPoint pos);
     void AddDrawable(std::shared_ptr<Drawable> drawable);
 
+    /**
+     * Get the drawables of this actor
+     * @return The drawables in drawing order
+     */
+    const std::vector<std::shared_ptr<Drawable>> &GetDrawables() const { return mDrawablesInOrder; }
+
+    /**
+     * Indicate a drawable was given new bounds, so the
+     * bounds of the actor have to be computed again.
+     */
+    void InvalidateBounds() { mPlacedBoundsDirty = true; }
+
+    /**
+     * Does anything this actor draws change with time
+     * even when the actor is not placed somewhere new?
+     * @return true if it has to be repainted every frame
+     */
+    bool ChangesWithTime() const { return mChangesWithTime; }
+
     /**
      * Get the actor name
      * @return Actor name
@@ -79,7 +161,7 @@ public:
      * The actor position
      * @param pos The new actor position
      */
-    void SetPosition(wxPoint pos) { mPosition = pos; }
+    void SetPosition(wxPoint pos) { mPosition = pos; mChannel.Invalidate(); }
 
 
     /**
@@ -117,6 +199,8 @@ public:
     void SetKeyframe();
     void GetKeyframe();
 
+    void OnChannelChanged(AnimChannel *channel) override;
+
     /**
      * The position animation channel
      * @return Pointer to animation channel
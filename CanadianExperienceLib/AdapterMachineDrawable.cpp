@@ -9,6 +9,14 @@
 
 #include "StartFrameDlg.h"
 #include "Timeline.h"
+#include "Trace.h"
+
+/// Scale the machines are drawn at in the picture
+const double MachineScale = 0.75;
+
+/// Extent of any of the machines relative to the machine location
+/// before it is scaled, with the lid open and Sparty popped up
+const wxRect MachineExtent(-300, -550, 600, 600);
 
 /**
  * Constructor
@@ -19,7 +27,8 @@ AdapterMachineDrawable::AdapterMachineDrawable(const std::wstring& name, const s
 {
     MachineSystemFactory factory(resourcesDir);
     mSystem = factory.CreateMachineSystem();
-
+    mStateCache.SetSystem(mSystem);
+    UpdateMachineBounds();
 }
 
 /**
@@ -32,7 +41,8 @@ bool AdapterMachineDrawable::SetMachineNumber(wxWindow* frame)
     MachineDialog dialog(frame, mSystem);
     if (dialog.ShowModal() == wxID_OK)
     {
-
+        // The dialog builds the machine again
+        mStateCache.Clear();
         return true;
     }
     return false;
@@ -55,15 +65,59 @@ bool AdapterMachineDrawable::SetMachineStart(wxWindow* frame)
  */
 void AdapterMachineDrawable::Draw(std::shared_ptr<wxGraphicsContext> graphics)
 {
-    double scale = 0.75f;
+    TraceSpan span("AdapterMachineDrawable::Draw");
 
     graphics->PushState();
-    graphics->Scale(scale, scale);
-    mSystem->SetMachineFrame(mTimeline->GetCurrentFrame() - mFrameStart);
-    mSystem->DrawMachine(graphics);
+    graphics->Scale(MachineScale, MachineScale);
+
+    {
+        TraceSpan simulateSpan("MachineSystem::SetMachineFrame");
+        // The frame rate can be changed in the timeline dialog
+        mStateCache.SetFrameRate(mTimeline->GetFrameRate());
+        mStateCache.SetMachineFrame(mTimeline->GetCurrentFrame() - mFrameStart);
+    }
+
+    {
+        TraceSpan drawSpan("MachineSystem::DrawMachine");
+        mSystem->DrawMachine(graphics);
+    }
+
     graphics->PopState();
 }
 
+/**
+ * Compute the bounds of the machine in the drawing.
+ *
+ * The machine is drawn at its own location rather than where
+ * the drawable is placed, so the bounds come from the scaled
+ * machine extent around that location.
+ */
+void AdapterMachineDrawable::UpdateMachineBounds()
+{
+    auto location = mSystem->GetLocation();
+    int left = (int)floor((location.x + MachineExtent.GetLeft()) * MachineScale);
+    int top = (int)floor((location.y + MachineExtent.GetTop()) * MachineScale);
+    int right = (int)ceil((location.x + MachineExtent.GetRight() + 1) * MachineScale);
+    int bottom = (int)ceil((location.y + MachineExtent.GetBottom() + 1) * MachineScale);
+    SetBounds(wxRect(left, top, right - left, bottom - top));
+}
+
+
+/**
+ * Get the per-component cost counters for the machine
+ * @return Pointer to the statistics or nullptr if the machine system does not keep any
+ */
+const MachineStatistics* AdapterMachineDrawable::GetStatistics()
+{
+    auto statistics = std::dynamic_pointer_cast<IMachineStatistics>(mSystem);
+    if (statistics == nullptr)
+    {
+        return nullptr;
+    }
+
+    return &statistics->GetStatistics();
+}
+
 /**
  * Hit test for the machine
  * @param pos the position the mouse is at
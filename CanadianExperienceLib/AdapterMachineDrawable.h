@@ -10,6 +10,7 @@
 #include "Drawable.h"
 #include "Timeline.h"
 #include "../MachineLib/MachineSystem.h"
+#include "MachineStateCache.h"
 
 /**
  * Creates the Adapter for the Machines to a drawable
@@ -23,6 +24,11 @@ private:
     std::shared_ptr<IMachineSystem> mSystem;
     /// The timeline this machine is on
     Timeline* mTimeline;
+    /// Checkpoints of the machine for stepping back and scrubbing
+    MachineStateCache mStateCache;
+
+    void UpdateMachineBounds();
+
 public:
     AdapterMachineDrawable(const std::wstring& name, const std::wstring& resourcesDir);
 
@@ -52,7 +58,11 @@ public:
      * Sets the machine number
      * @param machineNumber the frame the machine starts
      */
-    void SetMachineNumberInt(int machineNumber) { mSystem->ChooseMachine(machineNumber); }
+    void SetMachineNumberInt(int machineNumber)
+    {
+        mSystem->ChooseMachine(machineNumber);
+        mStateCache.Clear();
+    }
 
     /**
      * Gets the machineNumber
@@ -60,6 +70,19 @@ public:
      */
     int GetMachineNumber() { return mSystem->GetMachineNumber(); }
 
+    /**
+     * Give the sounds of the machine to a handler instead of playing them
+     * @param handler Handler for the sounds, or an empty handler to play them
+     */
+    void SetSoundHandler(const IMachineAudio::SoundHandler &handler)
+    {
+        auto audio = std::dynamic_pointer_cast<IMachineAudio>(mSystem);
+        if (audio != nullptr)
+        {
+            audio->SetSoundHandler(handler);
+        }
+    }
+
 
 
     /**
@@ -70,7 +93,7 @@ public:
     {
         Drawable::SetTimeline(timeline);
         mTimeline = timeline;
-        mSystem->SetFrameRate(mTimeline->GetFrameRate());
+        mStateCache.SetFrameRate(mTimeline->GetFrameRate());
     }
 
     /**
@@ -89,11 +112,27 @@ public:
         if (mSystem != nullptr)
         {
             mSystem->SetLocation(pos);
+            UpdateMachineBounds();
         }
     }
 
+    /**
+     * The machine runs with the timeline, so it
+     * changes even when it is not moved
+     * @return true
+     */
+    bool ChangesWithTime() override { return true; }
+
     void Draw(std::shared_ptr<wxGraphicsContext> graphics) override;
     bool HitTest(wxPoint pos) override;
+
+    const MachineStatistics* GetStatistics();
+
+    /**
+     * Get the checkpoints of the machine
+     * @return Machine state cache
+     */
+    const MachineStateCache &GetStateCache() const { return mStateCache; }
 };
 
 
@@ -0,0 +1,236 @@
+/**
+ * @file AnimBinary.cpp
+ * @author Shawn_Porto
+ */
+
+#include "pch.h"
+#include "AnimBinary.h"
+
+#include <algorithm>
+#include <cstring>
+#include <wx/file.h>
+
+#include "AnimChannel.h"
+#include "MappedFile.h"
+#include "Timeline.h"
+
+static_assert(sizeof(AnimBinaryHeader) == 48, "Binary animation header layout");
+static_assert(sizeof(AnimBinaryChannel) == 40, "Binary animation channel layout");
+static_assert(sizeof(AnimBinaryMachine) == 8, "Binary animation machine layout");
+static_assert(sizeof(int) == sizeof(int32_t), "Keyframe frames are stored as int32");
+
+/// Every block in the file starts on a multiple of this
+const uint64_t AnimBinaryAlignment = 8;
+
+/**
+ * Size in bytes of one keyframe value
+ * @param type AnimChannel::ValueType of the value
+ * @return Size, or 0 if the type is unknown
+ */
+static uint64_t ValueSize(uint32_t type)
+{
+    switch ((AnimChannel::ValueType)type)
+    {
+    case AnimChannel::ValueType::Angle:
+        return sizeof(double);
+
+    case AnimChannel::ValueType::Point:
+        return 2 * sizeof(int32_t);
+    }
+
+    return 0;
+}
+
+/**
+ * Append bytes to the file image, padded to the alignment
+ * @param data File image
+ * @param bytes Bytes to append
+ * @param size Number of bytes
+ * @return Offset the bytes were written at
+ */
+static uint64_t Append(std::vector<char> &data, const void *bytes, uint64_t size)
+{
+    uint64_t offset = data.size();
+    data.resize(offset + (size + AnimBinaryAlignment - 1) / AnimBinaryAlignment * AnimBinaryAlignment, 0);
+    if (size > 0)
+    {
+        memcpy(data.data() + offset, bytes, size);
+    }
+
+    return offset;
+}
+
+/**
+ * Is a block inside the file and aligned?
+ * @param file The mapped file
+ * @param offset Offset of the block
+ * @param size Size of the block in bytes
+ * @return true if the block can be read
+ */
+static bool ValidBlock(const MappedFile &file, uint64_t offset, uint64_t size)
+{
+    return offset % AnimBinaryAlignment == 0 && offset <= file.GetSize() && size <= file.GetSize() - offset;
+}
+
+/**
+ * Is a file a binary animation file?
+ * @param filename File to check
+ * @return true if it starts with the binary animation magic
+ */
+bool AnimBinary::IsBinaryFile(const std::wstring &filename)
+{
+    wxFile file;
+    if (!wxFile::Exists(filename) || !file.Open(filename))
+    {
+        return false;
+    }
+
+    char magic[sizeof(AnimBinaryMagic)];
+    return file.Read(magic, sizeof(magic)) == sizeof(magic) &&
+            memcmp(magic, AnimBinaryMagic, sizeof(magic)) == 0;
+}
+
+/**
+ * Save a timeline and the machine settings to a binary animation file
+ * @param filename File to write
+ * @param timeline Timeline to save
+ * @return true if successful
+ */
+bool AnimBinary::Save(const std::wstring &filename, Timeline *timeline)
+{
+    int numChannels = timeline->GetNumChannels();
+
+    AnimBinaryHeader header = {};
+    memcpy(header.mMagic, AnimBinaryMagic, sizeof(AnimBinaryMagic));
+    header.mVersion = AnimBinaryVersion;
+    header.mByteOrder = AnimBinaryByteOrder;
+    header.mNumFrames = timeline->GetNumFrames();
+    header.mFrameRate = timeline->GetFrameRate();
+    header.mNumChannels = numChannels;
+    header.mNumMachines = (uint32_t)mMachines.size();
+
+    std::vector<char> data;
+    Append(data, &header, sizeof(header));
+
+    // Room for the tables, filled in once the blocks are placed
+    std::vector<AnimBinaryChannel> channels(numChannels);
+    header.mChannelsOffset = Append(data, channels.data(), channels.size() * sizeof(AnimBinaryChannel));
+    header.mMachinesOffset = Append(data, mMachines.data(), mMachines.size() * sizeof(AnimBinaryMachine));
+
+    for (int c = 0; c < numChannels; c++)
+    {
+        auto channel = timeline->GetChannel(c);
+        auto &entry = channels[c];
+
+        auto name = wxString(channel->GetName()).ToUTF8();
+        entry.mNameLength = (uint32_t)name.length();
+        entry.mNameOffset = Append(data, name.data(), name.length());
+
+        int numKeyframes = channel->GetNumKeyframes();
+        entry.mValueType = (uint32_t)channel->GetValueType();
+        entry.mNumKeyframes = numKeyframes;
+        entry.mFramesOffset = Append(data, channel->GetKeyframeFrames(), numKeyframes * sizeof(int32_t));
+        entry.mValuesOffset = Append(data, channel->GetKeyframeValues(), numKeyframes * ValueSize(entry.mValueType));
+    }
+
+    memcpy(data.data(), &header, sizeof(header));
+    if (numChannels > 0)
+    {
+        memcpy(data.data() + header.mChannelsOffset, channels.data(), channels.size() * sizeof(AnimBinaryChannel));
+    }
+
+    wxFile file;
+    if (!file.Create(filename, true))
+    {
+        return false;
+    }
+
+    return file.Write(data.data(), data.size()) == data.size();
+}
+
+/**
+ * Load a timeline and the machine settings from a binary animation file.
+ *
+ * The whole file is checked before anything is changed, so
+ * a damaged file, or one written on a machine of the other
+ * byte order, leaves the timeline as it was.
+ * @param filename File to read
+ * @param timeline Timeline to load into
+ * @return true if successful
+ */
+bool AnimBinary::Load(const std::wstring &filename, Timeline *timeline)
+{
+    MappedFile file;
+    if (!file.Open(filename) || file.GetSize() < sizeof(AnimBinaryHeader))
+    {
+        return false;
+    }
+
+    auto data = file.GetData();
+    auto header = (const AnimBinaryHeader *)data;
+    if (memcmp(header->mMagic, AnimBinaryMagic, sizeof(AnimBinaryMagic)) != 0 ||
+            header->mVersion != AnimBinaryVersion ||
+            header->mByteOrder != AnimBinaryByteOrder ||
+            header->mNumFrames <= 0 || header->mNumFrames > AnimBinaryMaxFrames ||
+            header->mFrameRate <= 0 ||
+            !ValidBlock(file, header->mChannelsOffset, (uint64_t)header->mNumChannels * sizeof(AnimBinaryChannel)) ||
+            !ValidBlock(file, header->mMachinesOffset, (uint64_t)header->mNumMachines * sizeof(AnimBinaryMachine)))
+    {
+        return false;
+    }
+
+    auto entries = (const AnimBinaryChannel *)(data + header->mChannelsOffset);
+    auto byName = timeline->GetChannelsByName();
+
+    // Pair each table entry with its channel, checking the blocks
+    std::vector<AnimChannel *> channels(header->mNumChannels, nullptr);
+    for (uint32_t c = 0; c < header->mNumChannels; c++)
+    {
+        auto &entry = entries[c];
+        uint64_t valueSize = ValueSize(entry.mValueType);
+        if (valueSize == 0 ||
+                entry.mNameOffset > file.GetSize() || entry.mNameLength > file.GetSize() - entry.mNameOffset ||
+                !ValidBlock(file, entry.mFramesOffset, (uint64_t)entry.mNumKeyframes * sizeof(int32_t)) ||
+                !ValidBlock(file, entry.mValuesOffset, entry.mNumKeyframes * valueSize))
+        {
+            return false;
+        }
+
+        // The keyframes have to be in increasing order, which
+        // LoadKeyframes would otherwise find after the clear
+        auto frames = (const int32_t *)(data + entry.mFramesOffset);
+        if (std::adjacent_find(frames, frames + entry.mNumKeyframes, std::greater_equal<int32_t>()) !=
+                frames + entry.mNumKeyframes)
+        {
+            return false;
+        }
+
+        auto name = wxString::FromUTF8(data + entry.mNameOffset, entry.mNameLength);
+        auto channel = byName.find(name.ToStdWstring());
+        if (channel != byName.end() && (uint32_t)channel->second->GetValueType() == entry.mValueType)
+        {
+            channels[c] = channel->second;
+        }
+    }
+
+    timeline->Clear();
+    timeline->SetNumFrames(header->mNumFrames);
+    timeline->SetFrameRate(header->mFrameRate);
+
+    bool valid = true;
+    for (uint32_t c = 0; c < header->mNumChannels; c++)
+    {
+        auto &entry = entries[c];
+        if (channels[c] != nullptr)
+        {
+            valid = channels[c]->LoadKeyframes((const int *)(data + entry.mFramesOffset),
+                    data + entry.mValuesOffset, entry.mNumKeyframes) && valid;
+        }
+    }
+
+    auto machines = (const AnimBinaryMachine *)(data + header->mMachinesOffset);
+    mMachines.assign(machines, machines + header->mNumMachines);
+
+    timeline->SetCurrentTime(timeline->GetCurrentTime());
+    return valid;
+}
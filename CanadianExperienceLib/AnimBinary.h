@@ -0,0 +1,126 @@
+/**
+ * @file AnimBinary.h
+ * @author Shawn_Porto
+ *
+ * Binary animation file format.
+ *
+ * The binary format holds the same information as an XML .anim
+ * file, laid out so it can be memory mapped and copied straight
+ * into the channels without parsing each keyframe:
+ *
+ *     AnimBinaryHeader
+ *     AnimBinaryChannel[numChannels]      channel table
+ *     AnimBinaryMachine[numMachines]      machine adapter table
+ *     per channel: UTF-8 name, int32 frames[], packed values[]
+ *
+ * Values are doubles for angle channels and x, y int32 pairs for
+ * point channels. Everything is in the byte order of the machine that
+ * wrote the file, which the header records, and every block starts
+ * on an 8 byte boundary.
+ */
+
+#ifndef CANADIANEXPERIENCE_ANIMBINARY_H
+#define CANADIANEXPERIENCE_ANIMBINARY_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class Timeline;
+
+/// Magic bytes at the start of a binary animation file
+const char AnimBinaryMagic[8] = {'C', 'E', 'A', 'N', 'I', 'M', 'B', '\x1a'};
+
+/// Current version of the binary animation format. Version 2
+/// records the byte order the file was written in.
+const uint32_t AnimBinaryVersion = 2;
+
+/// Byte order marker. It reads back as this value only on a
+/// machine with the byte order of the one that wrote the file.
+const uint32_t AnimBinaryByteOrder = 0x01020304;
+
+/// Most frames a binary animation file may have
+const int32_t AnimBinaryMaxFrames = 1000000;
+
+/// File extension used for binary animation files
+const std::wstring AnimBinaryExtension = L"animb";
+
+/**
+ * Header at the start of a binary animation file
+ */
+struct AnimBinaryHeader
+{
+    char mMagic[8];             ///< AnimBinaryMagic
+    uint32_t mVersion;          ///< Format version
+    int32_t mNumFrames;         ///< Number of frames in the animation
+    int32_t mFrameRate;         ///< Frame rate in frames per second
+    uint32_t mNumChannels;      ///< Number of entries in the channel table
+    uint32_t mNumMachines;      ///< Number of entries in the machine table
+    uint32_t mByteOrder;        ///< AnimBinaryByteOrder
+    uint64_t mChannelsOffset;   ///< File offset of the channel table
+    uint64_t mMachinesOffset;   ///< File offset of the machine table
+};
+
+/**
+ * Entry in the channel table of a binary animation file
+ */
+struct AnimBinaryChannel
+{
+    uint64_t mNameOffset;       ///< File offset of the UTF-8 channel name
+    uint32_t mNameLength;       ///< Length of the name in bytes
+    uint32_t mValueType;        ///< AnimChannel::ValueType of the values
+    uint32_t mNumKeyframes;     ///< Number of keyframes
+    uint32_t mReserved;         ///< Zero
+    uint64_t mFramesOffset;     ///< File offset of the int32 keyframe frames
+    uint64_t mValuesOffset;     ///< File offset of the packed keyframe values
+};
+
+/**
+ * Entry in the machine adapter table of a binary animation file
+ */
+struct AnimBinaryMachine
+{
+    int32_t mFrameStart;        ///< Frame the machine starts on
+    int32_t mMachineNumber;     ///< Machine number
+};
+
+/**
+ * Reads and writes binary animation files.
+ *
+ * The machine adapter settings are carried alongside the
+ * timeline, since the picture owns the adapters.
+ */
+class AnimBinary {
+private:
+    /// The machine adapter settings
+    std::vector<AnimBinaryMachine> mMachines;
+
+public:
+    AnimBinary() {}
+
+    /** Copy constructor disabled */
+    AnimBinary(const AnimBinary &) = delete;
+
+    /** Assignment operator disabled */
+    void operator=(const AnimBinary &) = delete;
+
+    static bool IsBinaryFile(const std::wstring &filename);
+
+    bool Save(const std::wstring &filename, Timeline *timeline);
+    bool Load(const std::wstring &filename, Timeline *timeline);
+
+    /**
+     * Add the settings of a machine adapter to save
+     * @param frameStart Frame the machine starts on
+     * @param machineNumber Machine number
+     */
+    void AddMachine(int frameStart, int machineNumber) { mMachines.push_back({frameStart, machineNumber}); }
+
+    /**
+     * Get the machine adapter settings
+     * @return Settings in machine adapter order
+     */
+    const std::vector<AnimBinaryMachine> &GetMachines() const { return mMachines; }
+};
+
+#endif //CANADIANEXPERIENCE_ANIMBINARY_H
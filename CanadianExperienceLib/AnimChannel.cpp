@@ -6,76 +6,56 @@
 #include "pch.h"
 #include "AnimChannel.h"
 
+#include <algorithm>
+
 #include "Timeline.h"
+#include "AnimXmlWriter.h"
 
 
 /**
- * Determine how we should insert a keyframe into our keyframe list.
- * @param keyframe The keyframe to insert
+ * Make room for a keyframe at a frame.
+ *
+ * The keyframe frames are kept sorted, so the position is
+ * found with a binary search. Keyframes after the last one,
+ * which is how files are loaded, are simply appended. If there
+ * is already a keyframe on the frame, its slot is reused. The
+ * cursor is left on the new keyframe.
+ * @param frame Frame for the keyframe
+ * @param keyframe Set to the index of the keyframe slot
+ * @return true if a new slot was inserted, false if an existing keyframe is replaced
  */
-void AnimChannel::InsertKeyframe(std::shared_ptr<Keyframe> keyframe)
+bool AnimChannel::InsertKeyframe(int frame, int &keyframe)
 {
-    // Get the current frame and tell it to the keyframe we are setting.
-    int currFrame = mTimeline->GetCurrentFrame();
-    keyframe->SetFrame(currFrame);
-
-    // The possible options for keyframe insertion
-    enum class Action { Append, Replace, Insert } action;
-
-    // Determine the action we will do
-    if (mKeyframe1 < 0)
+    bool inserted = true;
+    if (mFrames.empty() || mFrames.back() < frame)
     {
-        // There is no first keyframe. This means
-        // we are before any keyframes or there are no keyframes.
-        // If before a keyframe, we insert, otherwise, we append
-        action = mKeyframe2 >= 0 ? Action::Insert : Action::Append;
+        keyframe = (int)mFrames.size();
+        mFrames.push_back(frame);
     }
     else
     {
-        // We know mKeyframe1 is valid
-        // So, we are after it.
-        int frame1 = mKeyframes[mKeyframe1]->GetFrame();
+        auto loc = std::lower_bound(mFrames.begin(), mFrames.end(), frame);
+        keyframe = (int)(loc - mFrames.begin());
 
-        if (mKeyframe2 < 0)
+        inserted = *loc != frame;
+        if (inserted)
         {
-            // There is no second keyframe.
-            // If we are after the current frame, we append.
-            // If we are on the current frame, we replace.
-            action = frame1 < currFrame ? Action::Append : Action::Replace;
-        }
-        else
-        {
-            // There is a second keyframe
-            // If we are before the first frame, we insert
-            // If not, we replace
-            action = frame1 < currFrame ? Action::Insert : Action::Replace;
+            mFrames.insert(loc, frame);
         }
     }
 
-    //
-    // And do the appropriate action
-    //
-    switch (action)
+    if (inserted)
     {
-    case Action::Append:
-        // Add to end and the keyframe to the left becomes the new keyframe
-        mKeyframes.push_back(keyframe);
-        mKeyframe1 = (int)mKeyframes.size() - 1;
-        break;
+        mTimeline->GetKeyframeSummary().Add(frame);
+    }
 
-    case Action::Replace:
-        // Replace the current keyframe
-        mKeyframes[mKeyframe1] = keyframe;
-        break;
+    mTimeline->InvalidateIndex();
 
-    case Action::Insert:
-        // Insert after mKeyframe1
-        // and mKeyframe1 becomes this new insertion (frame we are on)
-        mKeyframes.insert(mKeyframes.begin() + (mKeyframe1 + 1), keyframe);
-        mKeyframe1++;
-        break;
-    }
+    // We are now on this keyframe
+    mKeyframe1 = keyframe;
+    mKeyframe2 = keyframe + 1 < (int)mFrames.size() ? keyframe + 1 : -1;
 
+    return inserted;
 }
 
 
@@ -88,89 +68,164 @@ void AnimChannel::InsertKeyframe(std::shared_ptr<Keyframe> keyframe)
  * time. Note that the time may be before or after the first or last
  * item in the list.  We indicate that with values of -1 for the
  * indices.
+ *
+ * During playback the cursor is usually still valid or has
+ * moved by one keyframe; anything else is found with a binary search.
  * @param currFrame The frame we are on.
  */
 void AnimChannel::SetFrame(int currFrame)
 {
-    // Should we move forward in time?
-    while (mKeyframe2 >= 0 && mKeyframes[mKeyframe2]->GetFrame() <= currFrame)
+    int numKeyframes = (int)mFrames.size();
+    if (numKeyframes == 0)
     {
-        mKeyframe1 = mKeyframe2;
-        mKeyframe2++;
-        if (mKeyframe2 >= (int)mKeyframes.size())
-            mKeyframe2 = -1;
+        return;
     }
 
-    // Should we move backwards in time?
-    while (mKeyframe1 >= 0 && mKeyframes[mKeyframe1]->GetFrame() > currFrame)
+    int next = mKeyframe1 + 1;
+    bool valid = (mKeyframe1 < 0 || mFrames[mKeyframe1] <= currFrame) &&
+            (next >= numKeyframes || mFrames[next] > currFrame);
+
+    if (!valid && next < numKeyframes && mFrames[next] <= currFrame &&
+            (next + 1 >= numKeyframes || mFrames[next + 1] > currFrame))
     {
-        mKeyframe2 = mKeyframe1;
-        mKeyframe1--;
+        // Stepped forward onto the next keyframe
+        mKeyframe1 = next;
+        valid = true;
     }
 
-    // Four possibilities here:
-    // No keyframes  (mKeyframe1 < 0 and mKeyframe2 < 0)
+    if (!valid)
+    {
+        auto loc = std::upper_bound(mFrames.begin(), mFrames.end(), currFrame);
+        mKeyframe1 = (int)(loc - mFrames.begin()) - 1;
+    }
+
+    mKeyframe2 = mKeyframe1 + 1 < numKeyframes ? mKeyframe1 + 1 : -1;
+
+    // Three possibilities here:
     // Only a keyframe to the left (mKeyframe1 >= 0 and mKeyframe2 < 0)
     // Between two keyframes (mKeyframe1 >= 0 and mKeyframe2 >= 0)
     // Only a keyframe to the right (mKeyframe1 < 0 and mKeyframe2 >= 0)
     if (mKeyframe1 >= 0 && mKeyframe2 >= 0)
     {
         // Between two keyframes
-        // So we have to tween
-        mKeyframes[mKeyframe1]->UseAs1();
-        mKeyframes[mKeyframe2]->UseAs2();
-
         // Compute the t value
         double frameRate = GetTimeline()->GetFrameRate();
-        double time1 = mKeyframes[mKeyframe1]->GetFrame() / frameRate;
-        double time2 = mKeyframes[mKeyframe2]->GetFrame() / frameRate;
+        double time1 = mFrames[mKeyframe1] / frameRate;
+        double time2 = mFrames[mKeyframe2] / frameRate;
         double t = (GetTimeline()->GetCurrentTime() - time1) / (time2 - time1);
 
         // And tween
-        Tween(t);
+        Tween(mKeyframe1, mKeyframe2, t);
     }
     else if (mKeyframe1 >= 0)
     {
         // We are only using keyframe 1
-        mKeyframes[mKeyframe1]->UseOnly();
+        UseOnly(mKeyframe1);
     }
-    else if (mKeyframe2 >= 0)
+    else
     {
         // We are only using keyframe 2
-        mKeyframes[mKeyframe2]->UseOnly();
+        UseOnly(mKeyframe2);
     }
 }
 
 /**
- * Clear the current keyframe.
+ * Find where a time falls among the keyframes.
+ *
+ * Unlike SetFrame this is a binary search that leaves the
+ * channel untouched, so any number of threads can locate
+ * different times at once without disturbing the current value.
+ * The frame is found the way the timeline finds it, so the
+ * result matches what SetFrame computes at the same time.
+ * @param time Animation time in seconds, frame f is at f / frame rate
+ * @param keyframe1 Set to the keyframe at or before the time, or the first if there is none before
+ * @param keyframe2 Set to the keyframe after the time to tween with, or -1 to use keyframe1 alone
+ * @param t Set to the T value (0 to 1) between keyframe1 and keyframe2
+ * @return false if the channel has no keyframes
  */
-void AnimChannel::ClearKeyframe()
+bool AnimChannel::Locate(double time, int &keyframe1, int &keyframe2, double &t) const
 {
-    // If there is no keyframe1, we are not on a keyframe
-    if (mKeyframe1 < 0)
-        return;
+    int numKeyframes = (int)mFrames.size();
+    if (numKeyframes == 0)
+    {
+        return false;
+    }
+
+    double frameRate = mTimeline->GetFrameRate();
+    int frame = int(time * frameRate);
+
+    auto loc = std::upper_bound(mFrames.begin(), mFrames.end(), frame);
+    int next = (int)(loc - mFrames.begin());
+
+    t = 0;
+    if (next == 0)
+    {
+        // Before the first keyframe
+        keyframe1 = 0;
+        keyframe2 = -1;
+    }
+    else if (next == numKeyframes)
+    {
+        // After the last keyframe
+        keyframe1 = numKeyframes - 1;
+        keyframe2 = -1;
+    }
+    else
+    {
+        keyframe1 = next - 1;
+        keyframe2 = next;
+
+        double time1 = mFrames[keyframe1] / frameRate;
+        double time2 = mFrames[keyframe2] / frameRate;
+        t = (time - time1) / (time2 - time1);
+    }
 
-    // We know mKeyframe1 is valid
-    // Determine the frame number for the first keyframe
-    int frame1 = mKeyframes[mKeyframe1]->GetFrame();
+    return true;
+}
 
-    // What is the current frame?
+/**
+ * Clear the current keyframe.
+ *
+ * The cursor is not used to find the keyframe, since the
+ * timeline does not evaluate channels that are constant
+ * at the current time and their cursors may be stale.
+ */
+void AnimChannel::ClearKeyframe()
+{
     int currFrame = GetTimeline()->GetCurrentFrame();
 
-    // This is only valid if we are on a keyframe, as
-    // indicated by mKeyframe1 equal to the current frame.
-    if (frame1 != currFrame)
+    // This is only valid if we are on a keyframe
+    auto loc = std::lower_bound(mFrames.begin(), mFrames.end(), currFrame);
+    if (loc == mFrames.end() || *loc != currFrame)
         return;
 
-    mKeyframes.erase(mKeyframes.begin() + mKeyframe1);
+    int keyframe = (int)(loc - mFrames.begin());
+    mFrames.erase(loc);
+    RemoveKeyframe(keyframe);
+
+    // The cursor is found again on the next SetFrame
+    mKeyframe1 = -1;
+    mKeyframe2 = -1;
+
+    GetTimeline()->GetKeyframeSummary().Remove(currFrame);
+    GetTimeline()->InvalidateIndex();
+}
 
-    // The current frame becomes the previous frame
-    // or -1 if we are on frame 0
-    mKeyframe1--;
 
-    // If the next frame is valid, it will be decreased by 1
-    if (mKeyframe2 >= 0)
-        mKeyframe2--;
+/**
+ * Indicate the object using this channel has been changed
+ * by something other than the animation.
+ *
+ * The channel will be evaluated and its observer told the
+ * next time the timeline time is set, so edits that are not
+ * keyframed are replaced by the animation as before.
+ */
+void AnimChannel::Invalidate()
+{
+    if (mTimeline != nullptr)
+    {
+        mTimeline->InvalidateChannel(this);
+    }
 }
 
 
@@ -185,26 +240,14 @@ wxXmlNode* AnimChannel::XmlSave(wxXmlNode* node)
 
     itemNode->AddAttribute(L"name", mName);
 
-    for (auto keyframe : mKeyframes)
+    for (int k = 0; k < (int)mFrames.size(); k++)
     {
-        keyframe->XmlSave(itemNode);
-    }
-
-    return itemNode;
-}
+        auto keyframeNode = new wxXmlNode(wxXML_ELEMENT_NODE, L"keyframe");
+        itemNode->AddChild(keyframeNode);
 
-
-/**
- * Save this keyframe to an XML node
- * @param node The node we are going to be a child of
- * @return Allocated XML node
- */
-wxXmlNode* AnimChannel::Keyframe::XmlSave(wxXmlNode* node)
-{
-    auto itemNode = new wxXmlNode(wxXML_ELEMENT_NODE, L"keyframe");
-    node->AddChild(itemNode);
-
-    itemNode->AddAttribute(L"frame", wxString::Format(wxT("%i"), mFrame));
+        keyframeNode->AddAttribute(L"frame", wxString::Format(wxT("%i"), mFrames[k]));
+        XmlSaveKeyframe(keyframeNode, k);
+    }
 
     return itemNode;
 }
@@ -213,6 +256,9 @@ wxXmlNode* AnimChannel::Keyframe::XmlSave(wxXmlNode* node)
 
 /**
 * Handle loading this channel from a channel tag.
+*
+* The keyframes go straight into the sorted storage without
+* moving the timeline, which is evaluated once after loading.
 * @param node channel tag node
 */
 void AnimChannel::XmlLoad(wxXmlNode* node)
@@ -223,18 +269,96 @@ void AnimChannel::XmlLoad(wxXmlNode* node)
     auto child = node->GetChildren();
     for( ; child; child=child->GetNext())
     {
-        auto name = child->GetName();
-        if(name == L"keyframe")
+        if(child->GetName() == L"keyframe")
         {
-            int frame = wxAtoi(child->GetAttribute(L"frame", L"0"));
+            XmlLoadKeyframeNode(child);
+        }
+    }
+}
+
+
+/**
+ * Stream this channel to an XML animation file.
+ *
+ * Each keyframe is written as soon as it is formatted,
+ * so no document is built in memory.
+ * @param writer Writer for the file
+ */
+void AnimChannel::XmlSave(AnimXmlWriter* writer)
+{
+    wxXmlNode itemNode(wxXML_ELEMENT_NODE, L"channel");
+    itemNode.AddAttribute(L"name", mName);
+    writer->StartElement(&itemNode);
+
+    for (int k = 0; k < (int)mFrames.size(); k++)
+    {
+        wxXmlNode keyframeNode(wxXML_ELEMENT_NODE, L"keyframe");
+        keyframeNode.AddAttribute(L"frame", wxString::Format(wxT("%i"), mFrames[k]));
+        XmlSaveKeyframe(&keyframeNode, k);
+        writer->WriteElement(&keyframeNode);
+    }
+
+    writer->EndElement();
+}
+
+
+/**
+ * Load one keyframe tag
+ * @param node keyframe tag node
+ */
+void AnimChannel::XmlLoadKeyframeNode(wxXmlNode* node)
+{
+    int frame = wxAtoi(node->GetAttribute(L"frame", L"0"));
+
+    // Have the derived class set the keyframe
+    XmlLoadKeyframe(node, frame);
+}
 
-            // Pretend we are at that time
-            GetTimeline()->SetCurrentTime(double(frame) / double(GetTimeline()->GetFrameRate()));
 
-            // Have the derived class set the keyframe
-            XmlLoadKeyframe(child);
+/**
+ * Replace all keyframes with packed arrays, as they are
+ * stored in binary animation files.
+ *
+ * The arrays are copied in bulk without looking at each
+ * keyframe, other than checking they are in order.
+ * @param frames Frame numbers, in increasing order
+ * @param values Values of the channel value type
+ * @param count Number of keyframes
+ * @return false if the frames are not in increasing order
+ */
+bool AnimChannel::LoadKeyframes(const int *frames, const void *values, int count)
+{
+    if (std::adjacent_find(frames, frames + count, std::greater_equal<int>()) != frames + count)
+    {
+        return false;
+    }
+
+    if (mTimeline != nullptr)
+    {
+        auto &summary = mTimeline->GetKeyframeSummary();
+        for (auto frame : mFrames)
+        {
+            summary.Remove(frame);
         }
+
+        for (int k = 0; k < count; k++)
+        {
+            summary.Add(frames[k]);
+        }
+    }
+
+    mFrames.assign(frames, frames + count);
+    AssignKeyframeValues(values, count);
+
+    mKeyframe1 = -1;
+    mKeyframe2 = -1;
+
+    if (mTimeline != nullptr)
+    {
+        mTimeline->InvalidateIndex();
     }
+
+    return true;
 }
 
 
@@ -243,7 +367,20 @@ void AnimChannel::XmlLoad(wxXmlNode* node)
  */
 void AnimChannel::Clear()
 {
-    mKeyframes.clear();
+    if (mTimeline != nullptr)
+    {
+        for (auto frame : mFrames)
+        {
+            mTimeline->GetKeyframeSummary().Remove(frame);
+        }
+    }
+
+    mFrames.clear();
     mKeyframe1 = -1;
     mKeyframe2 = -1;
+
+    if (mTimeline != nullptr)
+    {
+        mTimeline->InvalidateIndex();
+    }
 }
\ No newline at end of file
@@ -11,11 +11,17 @@
 
 
 class Timeline;
+class AnimChannelObserver;
+class AnimXmlWriter;
 
 /**
  * Base class for an animation channel
  */
 class AnimChannel {
+public:
+    /// Type of the keyframe values, as stored in binary animation files
+    enum class ValueType {Angle = 1, Point = 2};
+
 private:
     /// The channel name
     std::wstring mName;
@@ -29,58 +35,16 @@ private:
     /// The timeline object
     Timeline *mTimeline = nullptr;
 
+    /// Object that takes its value from this channel
+    AnimChannelObserver *mObserver = nullptr;
+
+    /// Frame numbers of the keyframes, sorted in increasing order.
+    /// Derived classes keep the keyframe values in parallel arrays.
+    std::vector<int> mFrames;
+
 protected:
     /// Default constructor
     AnimChannel() {}
-    
-    /// Class that represents a keyframe
-    class Keyframe
-    {
-    public:
-        /** Default constructor disabled */
-        Keyframe() = delete;
-        /** Copy constructor disabled */
-        Keyframe(const Keyframe &) = delete;
-        /** Assignment operator disabled */
-        void operator=(const Keyframe &) = delete;
-
-        /**
-         * Get the frame for this keyframe
-         * @return The keyframe frame number
-         */
-        int GetFrame() const { return mFrame; }
-
-        /**
-         * Set the frame for this keyframe
-         * @param f The new frame number to set
-         */
-        void SetFrame(int f) { mFrame = f; }
-
-        /// Indicates this keyframe is used as Keyframe1
-        virtual void UseAs1() = 0;
-
-        /// Indicates this keyframe is used as Keyframe2
-        virtual void UseAs2() = 0;
-
-        /// Indicates this is the only keyframe
-        virtual void UseOnly() = 0;
-
-        virtual wxXmlNode* XmlSave(wxXmlNode* node);
-
-    private:
-        /// The channel this keyframe is associated with
-        AnimChannel *mChannel;
-
-        int mFrame; ///< The frame number for the keyframe
-
-    protected:
-        /**
-         * Constructor
-         * @param channel Channel we are associated with
-         */
-        Keyframe(AnimChannel *channel) : mChannel(channel) {}
-
-    };
 
 public:
     /// Destructor
@@ -88,6 +52,7 @@ public:
 
     /** Copy constructor disabled */
     AnimChannel(const AnimChannel &) = delete;
+
     /** Assignment operator disabled */
     void operator=(const AnimChannel &) = delete;
 
@@ -113,37 +78,125 @@ public:
      */
     Timeline *GetTimeline() { return mTimeline; }
 
+    /**
+     * Set the object that takes its value from this channel
+     * @param observer Observer to tell when the channel changes
+     */
+    void SetObserver(AnimChannelObserver *observer) { mObserver = observer; }
+
+    /**
+     * Get the object that takes its value from this channel
+     * @return Observer or nullptr if none
+     */
+    AnimChannelObserver *GetObserver() { return mObserver; }
+
     void SetFrame(int currFrame);
 
+    void Invalidate();
+
     /**
      * Is the channel valid, meaning has keyframes?
      * @return true if the channel is valid.
      */
-    bool IsValid() { return mKeyframe1 >= 0 || mKeyframe2 >= 0; }
+    bool IsValid() { return !mFrames.empty(); }
+
+    /**
+     * Get the number of keyframes in this channel
+     * @return Number of keyframes
+     */
+    int GetNumKeyframes() const { return (int)mFrames.size(); }
+
+    /**
+     * Get the frame number of a keyframe
+     * @param keyframe Index of the keyframe
+     * @return Frame number
+     */
+    int GetKeyframeFrame(int keyframe) const { return mFrames[keyframe]; }
+
+    /**
+     * Get the frame numbers of all keyframes
+     * @return Pointer to GetNumKeyframes() sorted frame numbers
+     */
+    const int *GetKeyframeFrames() const { return mFrames.data(); }
+
+    /**
+     * Get the type of the keyframe values
+     * @return Value type
+     */
+    virtual ValueType GetValueType() const = 0;
+
+    /**
+     * Get the values of all keyframes, packed in keyframe order
+     * @return Pointer to GetNumKeyframes() values of the channel value type
+     */
+    virtual const void *GetKeyframeValues() const = 0;
+
+    bool LoadKeyframes(const int *frames, const void *values, int count);
+
+    /**
+     * Does the value of this channel change over time?
+     *
+     * With fewer than two keyframes it is constant.
+     * @return true if the channel has at least two keyframes
+     */
+    bool IsAnimated() const { return mFrames.size() > 1; }
+
     void ClearKeyframe();
 
+    bool Locate(double time, int &keyframe1, int &keyframe2, double &t) const;
+
     virtual void Clear();
+
     virtual wxXmlNode* XmlSave(wxXmlNode* node);
     virtual void XmlLoad(wxXmlNode* node);
 
-private:
-    /// The collection of keyframes for this channel
-    std::vector<std::shared_ptr<Keyframe>> mKeyframes;
+    void XmlSave(AnimXmlWriter* writer);
+    void XmlLoadKeyframeNode(wxXmlNode* node);
 
 protected:
-    void InsertKeyframe(std::shared_ptr<Keyframe> keyframe);
+    bool InsertKeyframe(int frame, int &keyframe);
 
     /**
      * Channel type specific loading and keyframe creation
      * @param node Node to load from
+     * @param frame Frame the keyframe is on
      */
-    virtual void XmlLoadKeyframe(wxXmlNode* node) = 0;
+    virtual void XmlLoadKeyframe(wxXmlNode* node, int frame) = 0;
+
+    /**
+     * Channel type specific saving of a keyframe value
+     * @param node The keyframe node to add attributes to
+     * @param keyframe Index of the keyframe
+     */
+    virtual void XmlSaveKeyframe(wxXmlNode* node, int keyframe) = 0;
+
+    /**
+     * Replace all keyframe values with packed values
+     * @param values Pointer to count values of the channel value type
+     * @param count Number of values
+     */
+    virtual void AssignKeyframeValues(const void *values, int count) = 0;
+
+    /**
+     * Remove the value for a keyframe that is being deleted
+     * @param keyframe Index of the keyframe
+     */
+    virtual void RemoveKeyframe(int keyframe) = 0;
 
     /**
      * Tween between two keyframes
+     * @param keyframe1 Index of the keyframe before the current frame
+     * @param keyframe2 Index of the keyframe after the current frame
      * @param t The T value (0 to 1)
      * */
-    virtual void Tween(double t) = 0;
+    virtual void Tween(int keyframe1, int keyframe2, double t) = 0;
+
+    /**
+     * Use a single keyframe value, when we are before
+     * the first or after the last keyframe
+     * @param keyframe Index of the keyframe
+     */
+    virtual void UseOnly(int keyframe) = 0;
 };
 
 #endif //CANADIANEXPERIENCE_ANIMCHANNEL_H
@@ -6,22 +6,39 @@
 #include "pch.h"
 #include "AnimChannelAngle.h"
 
+#include <cstring>
+
+#include "Timeline.h"
+
 
 /**
- * Set a keyframe
- *
- * This function allocates a new keyframe and sends it to
- * AnimChannel, which will insert it into the collection of keyframes.
+ * Set a keyframe at the current frame
  * @param angle Angle for the keyframe.
  */
 void AnimChannelAngle::SetKeyframe(double angle)
 {
-    // Create a keyframe of the appropriate type
-    // Telling it this channel and the angle
-    auto keyframe = std::make_shared<KeyframeAngle>(this, angle);
+    SetKeyframe(GetTimeline()->GetCurrentFrame(), angle);
+}
 
-    // Insert it into the collection
-    InsertKeyframe(keyframe);
+/**
+ * Set a keyframe at a frame
+ *
+ * AnimChannel finds the slot for the frame and
+ * we store the angle in the parallel array.
+ * @param frame Frame for the keyframe
+ * @param angle Angle for the keyframe.
+ */
+void AnimChannelAngle::SetKeyframe(int frame, double angle)
+{
+    int keyframe;
+    if (InsertKeyframe(frame, keyframe))
+    {
+        mAngles.insert(mAngles.begin() + keyframe, angle);
+    }
+    else
+    {
+        mAngles[keyframe] = angle;
+    }
 }
 
 
@@ -29,30 +46,91 @@ void AnimChannelAngle::SetKeyframe(double angle)
  * Compute an angle that is an interpolation
  * between two keyframes
  *
- * This function is called after Use1 and Use2,
- * so we have pointers to valid keyframes of the
- * type KeyframeAngle. This function computes the
- * tweening.
- *
+ * @param keyframe1 Index of the keyframe before the current frame
+ * @param keyframe2 Index of the keyframe after the current frame
  * @param t A t value. t=0 means keyframe1, t=1 means keyframe2.
  * Other values interpolate between.
  */
-void AnimChannelAngle::Tween(double t)
+void AnimChannelAngle::Tween(int keyframe1, int keyframe2, double t)
 {
-    mAngle = mKeyframe1->GetAngle() * (1 - t) +
-            mKeyframe2->GetAngle() * t;
+    mAngle = Interpolate(keyframe1, keyframe2, t);
 }
 
-/** Save this keyframe to an XML node
-* @param node The node we are going to be a child of
-* @return Allocated XML node.
-*/
-wxXmlNode* AnimChannelAngle::KeyframeAngle::XmlSave(wxXmlNode* node)
+/**
+ * Interpolate between the angles of two keyframes
+ * @param keyframe1 Index of the first keyframe
+ * @param keyframe2 Index of the second keyframe, or -1 for the angle of keyframe1
+ * @param t A t value. t=0 means keyframe1, t=1 means keyframe2.
+ * @return Angle in radians
+ */
+double AnimChannelAngle::Interpolate(int keyframe1, int keyframe2, double t) const
 {
-    auto itemNode = AnimChannel::Keyframe::XmlSave(node);
-    itemNode->AddAttribute(L"angle", wxString::Format(wxT("%f"), mAngle));
+    if (keyframe2 < 0)
+    {
+        return mAngles[keyframe1];
+    }
 
-    return itemNode;
+    return mAngles[keyframe1] * (1 - t) +
+            mAngles[keyframe2] * t;
+}
+
+/**
+ * Compute the angle at any time without changing the channel.
+ *
+ * The current angle is left alone, so this can be called
+ * from several threads at once or for frames other than the
+ * current one, such as neighboring frames of onion-skinning.
+ * @param time Animation time in seconds
+ * @return Angle in radians, 0 if the channel has no keyframes
+ */
+double AnimChannelAngle::Evaluate(double time) const
+{
+    int keyframe1, keyframe2;
+    double t;
+    if (!Locate(time, keyframe1, keyframe2, t))
+    {
+        return 0;
+    }
+
+    return Interpolate(keyframe1, keyframe2, t);
+}
+
+/**
+ * Remove the angle of a keyframe that is being deleted
+ * @param keyframe Index of the keyframe
+ */
+void AnimChannelAngle::RemoveKeyframe(int keyframe)
+{
+    mAngles.erase(mAngles.begin() + keyframe);
+}
+
+/**
+ * Replace all keyframe angles with packed angles
+ * @param values Pointer to count doubles
+ * @param count Number of angles
+ */
+void AnimChannelAngle::AssignKeyframeValues(const void *values, int count)
+{
+    mAngles.resize(count);
+    memcpy(mAngles.data(), values, count * sizeof(double));
+}
+
+/**
+ * Clear all keyframes for this channel.
+ */
+void AnimChannelAngle::Clear()
+{
+    AnimChannel::Clear();
+    mAngles.clear();
+}
+
+/** Save the angle of a keyframe to an XML node
+* @param node The keyframe node
+* @param keyframe Index of the keyframe
+*/
+void AnimChannelAngle::XmlSaveKeyframe(wxXmlNode* node, int keyframe)
+{
+    node->AddAttribute(L"angle", wxString::Format(wxT("%f"), mAngles[keyframe]));
 }
 
 
@@ -60,8 +138,9 @@ wxXmlNode* AnimChannelAngle::KeyframeAngle::XmlSave(wxXmlNode* node)
 /**
 * Handle loading this channel's keyframe type
 * @param node keyframe tag node
+* @param frame Frame the keyframe is on
 */
-void AnimChannelAngle::XmlLoadKeyframe(wxXmlNode* node)
+void AnimChannelAngle::XmlLoadKeyframe(wxXmlNode* node, int frame)
 {
     auto angleStr = node->GetAttribute(L"angle", L"0");
 
@@ -69,6 +148,5 @@ void AnimChannelAngle::XmlLoadKeyframe(wxXmlNode* node)
     angleStr.ToDouble(&angle);
 
     // Set a keyframe there
-    SetKeyframe(angle);
+    SetKeyframe(frame, angle);
 }
-
@@ -17,64 +17,30 @@ class AnimChannelAngle : public AnimChannel {
 private:
     double mAngle = 0;  ///< The computed animation angle
 
-protected:
-    /// A keyframe for an angle channel
-    class KeyframeAngle : public Keyframe
-    {
-    public:
-        /**
-         * Constructor
-         * @param channel The channel we are for
-         * @param angle The angle for the keyframe
-         */
-        KeyframeAngle(AnimChannelAngle *channel, double angle) :
-            Keyframe(channel), mChannel(channel), mAngle(angle) {}
-
-        /** Default constructor disabled */
-        KeyframeAngle() = delete;
-        /** Copy constructor disabled */
-        KeyframeAngle(const KeyframeAngle &) = delete;
-        /** Assignment operator disabled */
-        void operator=(const KeyframeAngle &) = delete;
-
-        /**
-         * Get the angle at this keyframe
-         * @return Angle in radians
-         */
-        double GetAngle() { return mAngle; }
-
-        /// Use this keyframe as keyframe 1
-        void UseAs1() override { mChannel->mKeyframe1 = this; }
-
-        /// Use this keyframe as keyfraem 2
-        void UseAs2() override { mChannel->mKeyframe2 = this; }
-
-        /// Use this keyframe as the angle
-        void UseOnly() override { mChannel->mAngle = mAngle; }
-
-    private:
-        double mAngle;  ///< The angle for this keyframe
-
-        /// The channel this keyframe is associated with
-        AnimChannelAngle *mChannel;
-
-        wxXmlNode* XmlSave(wxXmlNode* node) override;
-    };
+    /// The keyframe angles, parallel to the keyframe frames in AnimChannel
+    std::vector<double> mAngles;
 
-protected:
-    void XmlLoadKeyframe(wxXmlNode* node) override;
+    double Interpolate(int keyframe1, int keyframe2, double t) const;
 
-    /// The first angle keyframe
-    KeyframeAngle *mKeyframe1 = nullptr;
+protected:
+    void XmlLoadKeyframe(wxXmlNode* node, int frame) override;
+    void AssignKeyframeValues(const void *values, int count) override;
+    void XmlSaveKeyframe(wxXmlNode* node, int keyframe) override;
+    void RemoveKeyframe(int keyframe) override;
+    void Tween(int keyframe1, int keyframe2, double t) override;
 
-    /// The second angle keyframe
-    KeyframeAngle *mKeyframe2 = nullptr;
+    /**
+     * Use a single keyframe angle
+     * @param keyframe Index of the keyframe
+     */
+    void UseOnly(int keyframe) override { mAngle = mAngles[keyframe]; }
 
 public:
     AnimChannelAngle() {}
 
     /** Copy constructor disabled */
     AnimChannelAngle(const AnimChannelAngle &) = delete;
+
     /** Assignment operator disabled */
     void operator=(const AnimChannelAngle &) = delete;
 
@@ -84,8 +50,30 @@ public:
      */
     double GetAngle() { return mAngle; }
 
+    double Evaluate(double time) const;
+
+    /**
+     * Get the angle of a keyframe
+     * @param keyframe Index of the keyframe
+     * @return Angle in radians
+     */
+    double GetKeyframeAngle(int keyframe) const { return mAngles[keyframe]; }
+
     void SetKeyframe(double angle);
-    void Tween(double t) override;
+    void SetKeyframe(int frame, double angle);
+    void Clear() override;
+
+    /**
+     * Get the type of the keyframe values
+     * @return ValueType::Angle, the values are doubles
+     */
+    ValueType GetValueType() const override { return ValueType::Angle; }
+
+    /**
+     * Get the angles of all keyframes
+     * @return Pointer to the packed angles
+     */
+    const void *GetKeyframeValues() const override { return mAngles.data(); }
 };
 
 #endif //CANADIANEXPERIENCE_ANIMCHANNELANGLE_H
@@ -0,0 +1,42 @@
+/**
+ * @file AnimChannelObserver.h
+ * @author Shawn_Porto
+ *
+ * Interface for objects that take their values from an animation channel.
+ */
+
+#ifndef CANADIANEXPERIENCE_ANIMCHANNELOBSERVER_H
+#define CANADIANEXPERIENCE_ANIMCHANNELOBSERVER_H
+
+class AnimChannel;
+
+/**
+ * Interface for objects that take their values from an animation channel.
+ *
+ * The timeline only tells an observer about a channel when the
+ * channel was evaluated for a new time, so objects whose channels
+ * are constant over the current span of frames are left alone.
+ */
+class AnimChannelObserver {
+protected:
+    /// Constructor (protected)
+    AnimChannelObserver() {}
+
+public:
+    /// Destructor
+    virtual ~AnimChannelObserver() {}
+
+    /** Copy constructor disabled */
+    AnimChannelObserver(const AnimChannelObserver &) = delete;
+
+    /** Assignment operator disabled */
+    void operator=(const AnimChannelObserver &) = delete;
+
+    /**
+     * Called when a channel has been evaluated for a new time
+     * @param channel Channel that has a new value
+     */
+    virtual void OnChannelChanged(AnimChannel *channel) = 0;
+};
+
+#endif //CANADIANEXPERIENCE_ANIMCHANNELOBSERVER_H
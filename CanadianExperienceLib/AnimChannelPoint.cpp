@@ -6,47 +6,130 @@
 #include "pch.h"
 #include "AnimChannelPoint.h"
 
+#include <cstring>
+
+#include "Timeline.h"
+
 /**
- * Set a keyframe
- *
- * This function allocates a new keyframe and sends it to
- * AnimChannel, which will insert it into the collection of keyframes.
- * @param point The point for the keyframe
+ * Set a keyframe at the current frame
+ * @param point Point for the keyframe.
  */
 void AnimChannelPoint::SetKeyframe(wxPoint point)
 {
-    // Create a keyframe of the appropriate type
-    // Telling it this channel and the angle
-    std::shared_ptr<KeyframePoint> keyframe = std::make_shared<KeyframePoint>(this, point);
+    SetKeyframe(GetTimeline()->GetCurrentFrame(), point);
+}
 
-    // Insert it into the collection
-    InsertKeyframe(keyframe);
+/**
+ * Set a keyframe at a frame
+ *
+ * AnimChannel finds the slot for the frame and
+ * we store the point in the parallel array.
+ * @param frame Frame for the keyframe
+ * @param point Point for the keyframe.
+ */
+void AnimChannelPoint::SetKeyframe(int frame, wxPoint point)
+{
+    int keyframe;
+    if (InsertKeyframe(frame, keyframe))
+    {
+        mPoints.insert(mPoints.begin() + keyframe, point);
+    }
+    else
+    {
+        mPoints[keyframe] = point;
+    }
 }
 
 /** Compute a tweened point between to points
- * @param t The tweening t value 
+ * @param keyframe1 Index of the keyframe before the current frame
+ * @param keyframe2 Index of the keyframe after the current frame
+ * @param t The tweening t value
+ */
+void AnimChannelPoint::Tween(int keyframe1, int keyframe2, double t)
+{
+    mPoint = Interpolate(keyframe1, keyframe2, t);
+}
+
+/**
+ * Interpolate between the points of two keyframes
+ * @param keyframe1 Index of the first keyframe
+ * @param keyframe2 Index of the second keyframe, or -1 for the point of keyframe1
+ * @param t The tweening t value
+ * @return The point
  */
-void AnimChannelPoint::Tween(double t)
+wxPoint AnimChannelPoint::Interpolate(int keyframe1, int keyframe2, double t) const
 {
-    auto a = mKeyframe1->GetPoint();
-    auto b = mKeyframe2->GetPoint();
+    auto a = mPoints[keyframe1];
+    if (keyframe2 < 0)
+    {
+        return a;
+    }
 
-    mPoint = wxPoint(int(a.x + t * (b.x - a.x)),
+    auto b = mPoints[keyframe2];
+    return wxPoint(int(a.x + t * (b.x - a.x)),
             int(a.y + t * (b.y - a.y)));
 }
 
+/**
+ * Compute the point at any time without changing the channel.
+ *
+ * The current point is left alone, so several threads can
+ * evaluate different frames of the channel at once.
+ * @param time Animation time in seconds
+ * @return The point, (0, 0) if the channel has no keyframes
+ */
+wxPoint AnimChannelPoint::Evaluate(double time) const
+{
+    int keyframe1, keyframe2;
+    double t;
+    if (!Locate(time, keyframe1, keyframe2, t))
+    {
+        return wxPoint(0, 0);
+    }
+
+    return Interpolate(keyframe1, keyframe2, t);
+}
 
-/** Save this keyframe to an XML node
-* @param node The node we are going to be a child of
-* @return Allocated XML node.
-*/
-wxXmlNode* AnimChannelPoint::KeyframePoint::XmlSave(wxXmlNode* node)
+/**
+ * Remove the point of a keyframe that is being deleted
+ * @param keyframe Index of the keyframe
+ */
+void AnimChannelPoint::RemoveKeyframe(int keyframe)
+{
+    mPoints.erase(mPoints.begin() + keyframe);
+}
+
+/**
+ * Replace all keyframe points with packed points
+ * @param values Pointer to count pairs of x and y ints
+ * @param count Number of points
+ */
+void AnimChannelPoint::AssignKeyframeValues(const void *values, int count)
+{
+    static_assert(sizeof(wxPoint) == 2 * sizeof(int), "wxPoint has to be two packed ints");
+
+    mPoints.resize(count);
+    memcpy(mPoints.data(), values, count * sizeof(wxPoint));
+}
+
+/**
+ * Clear all keyframes for this channel.
+ */
+void AnimChannelPoint::Clear()
 {
-    auto itemNode = AnimChannel::Keyframe::XmlSave(node);
-    itemNode->AddAttribute(L"x", wxString::Format(wxT("%i"), mPoint.x));
-    itemNode->AddAttribute(L"y", wxString::Format(wxT("%i"), mPoint.y));
+    AnimChannel::Clear();
+    mPoints.clear();
+}
+
 
-    return itemNode;
+/** Save the point of a keyframe to an XML node
+* @param node The keyframe node
+* @param keyframe Index of the keyframe
+*/
+void AnimChannelPoint::XmlSaveKeyframe(wxXmlNode* node, int keyframe)
+{
+    node->AddAttribute(L"x", wxString::Format(wxT("%i"), mPoints[keyframe].x));
+    node->AddAttribute(L"y", wxString::Format(wxT("%i"), mPoints[keyframe].y));
 }
 
 
@@ -54,15 +137,13 @@ wxXmlNode* AnimChannelPoint::KeyframePoint::XmlSave(wxXmlNode* node)
 /**
 * Handle loading this channel's keyframe type
 * @param node keyframe tag node
+* @param frame Frame the keyframe is on
 */
-void AnimChannelPoint::XmlLoadKeyframe(wxXmlNode* node)
+void AnimChannelPoint::XmlLoadKeyframe(wxXmlNode* node, int frame)
 {
     int x = wxAtoi(node->GetAttribute(L"x", L"0"));
     int y = wxAtoi(node->GetAttribute(L"y", L"0"));
 
     // Set a keyframe there
-    SetKeyframe(wxPoint(x, y));
+    SetKeyframe(frame, wxPoint(x, y));
 }
-
-
-
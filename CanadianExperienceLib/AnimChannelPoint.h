@@ -18,6 +18,11 @@ private:
     /// The point we compute
     wxPoint mPoint = wxPoint(0, 0);
 
+    /// The keyframe points, parallel to the keyframe frames in AnimChannel
+    std::vector<wxPoint> mPoints;
+
+    wxPoint Interpolate(int keyframe1, int keyframe2, double t) const;
+
 public:
     AnimChannelPoint() = default;
 
@@ -27,60 +32,43 @@ public:
      */
     wxPoint GetPoint() { return mPoint; }
 
-    /// A keyframe for a point channel
-    class KeyframePoint : public Keyframe
-    {
-    private:
-        /// The keyframe point
-        wxPoint mPoint = wxPoint(0, 0);
-
-        /// The channel this keyframe is associated with
-        AnimChannelPoint *mChannel;
-
-    public:
-        /**
-         * Constructor
-         * @param channel The channel we are for
-         * @param point The animation position for the keyframe
-         */
-        KeyframePoint(AnimChannelPoint *channel, wxPoint point) :
-                Keyframe(channel), mChannel(channel), mPoint(point) {}
-
-        /** Default constructor disabled */
-        KeyframePoint() = delete;
-        /** Copy constructor disabled */
-        KeyframePoint(const KeyframePoint &) = delete;
-        /** Assignment operator disabled */
-        void operator=(const KeyframePoint &) = delete;
+    wxPoint Evaluate(double time) const;
 
-        /// The keyframe point
-        /// @return The keyframe point
-        wxPoint GetPoint() { return mPoint; }
-
-        /** Use this keyframe as keyframe 1 */
-        void UseAs1() override { mChannel->mKeyframe1 = this; }
-
-        /** Use this keyframe as keyfraem 2 */
-        void UseAs2() override { mChannel->mKeyframe2 = this; }
-
-        /** Use this keyframe as the angle */
-        void UseOnly() override { mChannel->mPoint = mPoint; }
-
-        wxXmlNode* XmlSave(wxXmlNode* node) override;
-    };
+    /**
+     * Get the point of a keyframe
+     * @param keyframe Index of the keyframe
+     * @return The keyframe point
+     */
+    wxPoint GetKeyframePoint(int keyframe) const { return mPoints[keyframe]; }
 
     void SetKeyframe(wxPoint point);
-    void Tween(double t) override;
+    void SetKeyframe(int frame, wxPoint point);
+    void Clear() override;
 
-private:
-    /// The first angle keyframe
-    KeyframePoint *mKeyframe1 = nullptr;
+    /**
+     * Get the type of the keyframe values
+     * @return ValueType::Point, the values are pairs of ints
+     */
+    ValueType GetValueType() const override { return ValueType::Point; }
 
-    /// The second angle keyframe
-    KeyframePoint *mKeyframe2 = nullptr;
+    /**
+     * Get the points of all keyframes
+     * @return Pointer to the packed points
+     */
+    const void *GetKeyframeValues() const override { return mPoints.data(); }
 
 protected:
-    void XmlLoadKeyframe(wxXmlNode* node) override;
+    void XmlLoadKeyframe(wxXmlNode* node, int frame) override;
+    void AssignKeyframeValues(const void *values, int count) override;
+    void XmlSaveKeyframe(wxXmlNode* node, int keyframe) override;
+    void RemoveKeyframe(int keyframe) override;
+    void Tween(int keyframe1, int keyframe2, double t) override;
+
+    /**
+     * Use a single keyframe point
+     * @param keyframe Index of the keyframe
+     */
+    void UseOnly(int keyframe) override { mPoint = mPoints[keyframe]; }
 };
 
 #endif //CANADIANEXPERIENCE_ANIMCHANNELPOINT_H
@@ -0,0 +1,384 @@
+/**
+ * @file AnimXmlReader.cpp
+ * @author Shawn_Porto
+ */
+
+#include "pch.h"
+#include "AnimXmlReader.h"
+
+#include <cstring>
+
+/// Number of bytes read from the file at a time
+const size_t AnimXmlReaderChunkSize = 1 << 16;
+
+/**
+ * Is a character XML white space?
+ * @param c Character to test
+ * @return true if white space
+ */
+static bool IsSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+/**
+ * Append a code point to a string as UTF-8
+ * @param text String to append to
+ * @param code Unicode code point
+ */
+static void AppendUtf8(std::string &text, unsigned long code)
+{
+    if (code < 0x80)
+    {
+        text += (char)code;
+    }
+    else if (code < 0x800)
+    {
+        text += (char)(0xc0 | (code >> 6));
+        text += (char)(0x80 | (code & 0x3f));
+    }
+    else if (code < 0x10000)
+    {
+        text += (char)(0xe0 | (code >> 12));
+        text += (char)(0x80 | ((code >> 6) & 0x3f));
+        text += (char)(0x80 | (code & 0x3f));
+    }
+    else
+    {
+        text += (char)(0xf0 | (code >> 18));
+        text += (char)(0x80 | ((code >> 12) & 0x3f));
+        text += (char)(0x80 | ((code >> 6) & 0x3f));
+        text += (char)(0x80 | (code & 0x3f));
+    }
+}
+
+/**
+ * Replace the entity and character references in an attribute value
+ * @param value Raw attribute value
+ * @param decoded Receives the value as UTF-8
+ * @return false if there is an unknown or unterminated reference
+ */
+static bool Decode(const std::string &value, std::string &decoded)
+{
+    decoded.clear();
+    for (size_t i = 0; i < value.size(); i++)
+    {
+        if (value[i] != '&')
+        {
+            decoded += value[i];
+            continue;
+        }
+
+        auto semicolon = value.find(';', i);
+        if (semicolon == std::string::npos)
+        {
+            return false;
+        }
+
+        auto entity = value.substr(i + 1, semicolon - i - 1);
+        if (entity == "lt")
+        {
+            decoded += '<';
+        }
+        else if (entity == "gt")
+        {
+            decoded += '>';
+        }
+        else if (entity == "amp")
+        {
+            decoded += '&';
+        }
+        else if (entity == "quot")
+        {
+            decoded += '"';
+        }
+        else if (entity == "apos")
+        {
+            decoded += '\'';
+        }
+        else if (entity.size() > 1 && entity[0] == '#')
+        {
+            bool hex = entity[1] == 'x';
+            char *end;
+            auto code = strtoul(entity.c_str() + (hex ? 2 : 1), &end, hex ? 16 : 10);
+            if (*end != 0)
+            {
+                return false;
+            }
+            AppendUtf8(decoded, code);
+        }
+        else
+        {
+            return false;
+        }
+
+        i = semicolon;
+    }
+
+    return true;
+}
+
+/**
+ * Parse an XML animation file
+ * @param filename File to read
+ * @param handler Called for each element as its start tag is read
+ * @return true if the file was read and is well formed
+ */
+bool AnimXmlReader::Parse(const std::wstring &filename, const ElementHandler &handler)
+{
+    mBuffer.clear();
+    mPosition = 0;
+    mOpen.clear();
+
+    if (!wxFile::Exists(filename) || !mFile.Open(filename))
+    {
+        return false;
+    }
+
+    bool sawRoot = false;
+    while (true)
+    {
+        auto start = mBuffer.find('<', mPosition);
+        if (start == std::string::npos)
+        {
+            // Only text left in the buffer
+            mPosition = mBuffer.size();
+            if (!Fill())
+            {
+                break;
+            }
+            continue;
+        }
+
+        mPosition = start;
+        size_t end;
+        if (!FindTagEnd(start, end))
+        {
+            if (!Fill())
+            {
+                // Unterminated tag
+                return false;
+            }
+            continue;
+        }
+
+        auto tag = mBuffer.substr(start + 1, end - start - 1);
+        mPosition = end + 1;
+
+        if (tag.empty() || tag[0] == '?' || tag[0] == '!')
+        {
+            // Declaration, comment or doctype
+            continue;
+        }
+
+        if (tag[0] == '/')
+        {
+            if (!EndTag(tag))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            if (sawRoot && mOpen.empty())
+            {
+                // A second root element
+                return false;
+            }
+
+            sawRoot = true;
+            if (!StartTag(tag, handler))
+            {
+                return false;
+            }
+        }
+    }
+
+    mFile.Close();
+    return sawRoot && mOpen.empty();
+}
+
+/**
+ * Read the next chunk of the file into the buffer.
+ *
+ * The processed part of the buffer is discarded first,
+ * so the buffer only ever holds about one chunk.
+ * @return false at the end of the file
+ */
+bool AnimXmlReader::Fill()
+{
+    mBuffer.erase(0, mPosition);
+    mPosition = 0;
+
+    auto size = mBuffer.size();
+    mBuffer.resize(size + AnimXmlReaderChunkSize);
+    auto read = mFile.Read(&mBuffer[size], AnimXmlReaderChunkSize);
+    if (read <= 0)
+    {
+        mBuffer.resize(size);
+        return false;
+    }
+
+    mBuffer.resize(size + read);
+    return true;
+}
+
+/**
+ * Find the end of the tag that starts at a '<'
+ * @param start Position of the '<'
+ * @param end Receives the position of the closing '>'
+ * @return false if the tag is not all in the buffer yet
+ */
+bool AnimXmlReader::FindTagEnd(size_t start, size_t &end)
+{
+    const char *terminator = ">";
+    if (mBuffer.compare(start, 4, "<!--") == 0)
+    {
+        terminator = "-->";
+    }
+    else if (mBuffer.compare(start, 2, "<?") == 0)
+    {
+        terminator = "?>";
+    }
+
+    if (terminator[1] != 0)
+    {
+        auto found = mBuffer.find(terminator, start + 2);
+        if (found == std::string::npos)
+        {
+            return false;
+        }
+
+        end = found + strlen(terminator) - 1;
+        return true;
+    }
+
+    // A '>' inside a quoted attribute value does not end the tag
+    char quote = 0;
+    for (size_t i = start + 1; i < mBuffer.size(); i++)
+    {
+        char c = mBuffer[i];
+        if (quote != 0)
+        {
+            if (c == quote)
+            {
+                quote = 0;
+            }
+        }
+        else if (c == '"' || c == '\'')
+        {
+            quote = c;
+        }
+        else if (c == '>')
+        {
+            end = i;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Handle a start tag or empty element tag
+ * @param tag Text between the '<' and '>'
+ * @param handler Callback for the element
+ * @return false if the tag is malformed
+ */
+bool AnimXmlReader::StartTag(const std::string &tag, const ElementHandler &handler)
+{
+    size_t length = tag.size();
+    bool empty = tag.back() == '/';
+    if (empty)
+    {
+        length--;
+    }
+
+    size_t i = 0;
+    while (i < length && !IsSpace(tag[i]))
+    {
+        i++;
+    }
+
+    auto name = tag.substr(0, i);
+    wxXmlNode element(wxXML_ELEMENT_NODE, wxString::FromUTF8(name.data(), name.size()));
+
+    std::string decoded;
+    while (true)
+    {
+        while (i < length && IsSpace(tag[i]))
+        {
+            i++;
+        }
+
+        if (i >= length)
+        {
+            break;
+        }
+
+        auto equals = tag.find('=', i);
+        if (equals == std::string::npos || equals >= length)
+        {
+            return false;
+        }
+
+        auto attribute = tag.substr(i, equals - i);
+        while (!attribute.empty() && IsSpace(attribute.back()))
+        {
+            attribute.pop_back();
+        }
+
+        i = equals + 1;
+        while (i < length && IsSpace(tag[i]))
+        {
+            i++;
+        }
+
+        if (i >= length || (tag[i] != '"' && tag[i] != '\''))
+        {
+            return false;
+        }
+
+        auto close = tag.find(tag[i], i + 1);
+        if (close == std::string::npos || close >= length ||
+                !Decode(tag.substr(i + 1, close - i - 1), decoded))
+        {
+            return false;
+        }
+
+        element.AddAttribute(wxString::FromUTF8(attribute.data(), attribute.size()),
+                wxString::FromUTF8(decoded.data(), decoded.size()));
+        i = close + 1;
+    }
+
+    handler(&element, (int)mOpen.size());
+
+    if (!empty)
+    {
+        mOpen.push_back(name);
+    }
+
+    return true;
+}
+
+/**
+ * Handle an end tag
+ * @param tag Text between the '<' and '>', starting with '/'
+ * @return false if it does not end the innermost open element
+ */
+bool AnimXmlReader::EndTag(const std::string &tag)
+{
+    auto name = tag.substr(1);
+    while (!name.empty() && IsSpace(name.back()))
+    {
+        name.pop_back();
+    }
+
+    if (mOpen.empty() || mOpen.back() != name)
+    {
+        return false;
+    }
+
+    mOpen.pop_back();
+    return true;
+}
@@ -0,0 +1,65 @@
+/**
+ * @file AnimXmlReader.h
+ * @author Shawn_Porto
+ *
+ * Streaming (SAX style) reader for XML animation files.
+ */
+
+#ifndef CANADIANEXPERIENCE_ANIMXMLREADER_H
+#define CANADIANEXPERIENCE_ANIMXMLREADER_H
+
+#include <functional>
+#include <string>
+#include <vector>
+#include <wx/file.h>
+
+/**
+ * Streaming (SAX style) reader for XML animation files.
+ *
+ * The file is read in fixed size chunks and each element is
+ * handed to a callback as soon as its start tag has been read,
+ * so a whole document is never held in memory. The callback gets
+ * a wxXmlNode with the element name and attributes only; it is
+ * destroyed when the callback returns.
+ *
+ * This handles the subset of XML animation files use: elements,
+ * attributes, character references and the predefined entities.
+ * Text, comments, processing instructions and doctype declarations
+ * are skipped.
+ */
+class AnimXmlReader {
+public:
+    /// Callback for an element: the element and its depth, 0 for the root
+    typedef std::function<void(wxXmlNode *element, int depth)> ElementHandler;
+
+private:
+    /// The file being read
+    wxFile mFile;
+
+    /// Unprocessed input
+    std::string mBuffer;
+
+    /// Position of the next unprocessed character in mBuffer
+    size_t mPosition = 0;
+
+    /// Names of the open elements, innermost last
+    std::vector<std::string> mOpen;
+
+    bool Fill();
+    bool FindTagEnd(size_t start, size_t &end);
+    bool StartTag(const std::string &tag, const ElementHandler &handler);
+    bool EndTag(const std::string &tag);
+
+public:
+    AnimXmlReader() {}
+
+    /** Copy constructor disabled */
+    AnimXmlReader(const AnimXmlReader &) = delete;
+
+    /** Assignment operator disabled */
+    void operator=(const AnimXmlReader &) = delete;
+
+    bool Parse(const std::wstring &filename, const ElementHandler &handler);
+};
+
+#endif //CANADIANEXPERIENCE_ANIMXMLREADER_H
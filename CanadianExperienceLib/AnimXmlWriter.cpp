@@ -0,0 +1,169 @@
+/**
+ * @file AnimXmlWriter.cpp
+ * @author Shawn_Porto
+ */
+
+#include "pch.h"
+#include "AnimXmlWriter.h"
+
+/// Output is written to the file once the buffer is this large
+const size_t AnimXmlWriterBufferSize = 1 << 16;
+
+/**
+ * Create the file and write the XML declaration
+ * @param filename File to write
+ * @return true if the file was created
+ */
+bool AnimXmlWriter::Open(const std::wstring &filename)
+{
+    mBuffer.clear();
+    mOpen.clear();
+    mFailed = false;
+
+    if (!mFile.Create(filename, true))
+    {
+        return false;
+    }
+
+    mBuffer.reserve(AnimXmlWriterBufferSize);
+    mBuffer += "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+    return true;
+}
+
+/**
+ * Write the start tag of an element that will have children
+ * @param node Element name and attributes
+ */
+void AnimXmlWriter::StartElement(const wxXmlNode *node)
+{
+    WriteTag(node, false);
+    mOpen.push_back(node->GetName().ToUTF8().data());
+}
+
+/**
+ * Write the end tag of the most recently started element
+ */
+void AnimXmlWriter::EndElement()
+{
+    if (mOpen.empty())
+    {
+        mFailed = true;
+        return;
+    }
+
+    mBuffer += "</";
+    mBuffer += mOpen.back();
+    mBuffer += ">";
+    mOpen.pop_back();
+
+    if (mBuffer.size() >= AnimXmlWriterBufferSize)
+    {
+        Flush();
+    }
+}
+
+/**
+ * Write an element with no children
+ * @param node Element name and attributes
+ */
+void AnimXmlWriter::WriteElement(const wxXmlNode *node)
+{
+    WriteTag(node, true);
+}
+
+/**
+ * Write whatever is buffered and close the file
+ * @return true if the whole file was written and every element was ended
+ */
+bool AnimXmlWriter::Close()
+{
+    Flush();
+    mFile.Close();
+    return !mFailed && mOpen.empty();
+}
+
+/**
+ * Write a start tag or empty element tag
+ * @param node Element name and attributes
+ * @param empty True for an element with no children
+ */
+void AnimXmlWriter::WriteTag(const wxXmlNode *node, bool empty)
+{
+    mBuffer += "<";
+    mBuffer += node->GetName().ToUTF8().data();
+
+    for (auto attribute = node->GetAttributes(); attribute != nullptr; attribute = attribute->GetNext())
+    {
+        mBuffer += " ";
+        mBuffer += attribute->GetName().ToUTF8().data();
+        mBuffer += "=\"";
+        WriteEscaped(attribute->GetValue());
+        mBuffer += "\"";
+    }
+
+    mBuffer += empty ? "/>" : ">";
+
+    if (mBuffer.size() >= AnimXmlWriterBufferSize)
+    {
+        Flush();
+    }
+}
+
+/**
+ * Write an attribute value, escaping the characters XML reserves
+ * @param text Text to write
+ */
+void AnimXmlWriter::WriteEscaped(const wxString &text)
+{
+    auto utf8 = text.ToUTF8();
+    for (const char *c = utf8.data(); *c != 0; c++)
+    {
+        switch (*c)
+        {
+        case '&':
+            mBuffer += "&amp;";
+            break;
+
+        case '<':
+            mBuffer += "&lt;";
+            break;
+
+        case '>':
+            mBuffer += "&gt;";
+            break;
+
+        case '"':
+            mBuffer += "&quot;";
+            break;
+
+        case '\n':
+            mBuffer += "&#xA;";
+            break;
+
+        case '\r':
+            mBuffer += "&#xD;";
+            break;
+
+        case '\t':
+            mBuffer += "&#x9;";
+            break;
+
+        default:
+            mBuffer += *c;
+            break;
+        }
+    }
+}
+
+/**
+ * Write the buffered output to the file
+ */
+void AnimXmlWriter::Flush()
+{
+    if (!mBuffer.empty() && mFile.IsOpened() && mFile.Write(mBuffer.data(), mBuffer.size()) != mBuffer.size())
+    {
+        mFailed = true;
+    }
+
+    mBuffer.clear();
+}
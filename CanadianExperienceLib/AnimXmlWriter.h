@@ -0,0 +1,58 @@
+/**
+ * @file AnimXmlWriter.h
+ * @author Shawn_Porto
+ *
+ * Streaming writer for XML animation files.
+ */
+
+#ifndef CANADIANEXPERIENCE_ANIMXMLWRITER_H
+#define CANADIANEXPERIENCE_ANIMXMLWRITER_H
+
+#include <string>
+#include <vector>
+#include <wx/file.h>
+
+/**
+ * Streaming writer for XML animation files.
+ *
+ * Elements are written to a buffered file as they are produced,
+ * so saving never holds more than one element in memory. Each
+ * element is described by a wxXmlNode, which is only used for
+ * its name and attributes, so the files are the same as those
+ * written by wxXmlDocument.
+ */
+class AnimXmlWriter {
+private:
+    /// The file being written
+    wxFile mFile;
+
+    /// Output waiting to be written to the file
+    std::string mBuffer;
+
+    /// Names of the elements that are open, innermost last
+    std::vector<std::string> mOpen;
+
+    /// True if a write to the file failed
+    bool mFailed = false;
+
+    void WriteTag(const wxXmlNode *node, bool empty);
+    void WriteEscaped(const wxString &text);
+    void Flush();
+
+public:
+    AnimXmlWriter() {}
+
+    /** Copy constructor disabled */
+    AnimXmlWriter(const AnimXmlWriter &) = delete;
+
+    /** Assignment operator disabled */
+    void operator=(const AnimXmlWriter &) = delete;
+
+    bool Open(const std::wstring &filename);
+    void StartElement(const wxXmlNode *node);
+    void EndElement();
+    void WriteElement(const wxXmlNode *node);
+    bool Close();
+};
+
+#endif //CANADIANEXPERIENCE_ANIMXMLWRITER_H
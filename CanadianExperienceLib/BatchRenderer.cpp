@@ -0,0 +1,179 @@
+/**
+ * @file BatchRenderer.cpp
+ * @author Shawn_Porto
+ */
+
+#include "pch.h"
+#include "BatchRenderer.h"
+
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#include "Picture.h"
+#include "Timeline.h"
+
+/**
+ * Constructor
+ * @param factory Creates the picture each thread renders
+ */
+BatchRenderer::BatchRenderer(PictureFactory factory) : mFactory(factory)
+{
+}
+
+/**
+ * Render a range of frames.
+ *
+ * Returns once every frame has been handed to the output,
+ * the output asked to stop, or a picture could not be made.
+ * @param first First frame to render
+ * @param last Last frame to render
+ * @param output Takes each frame in order
+ * @return true if every frame was rendered and taken by the output
+ */
+bool BatchRenderer::Render(int first, int last, const Output &output)
+{
+    if (last < first)
+    {
+        return true;
+    }
+
+    int numBlocks = (last - first) / BatchBlockFrames + 1;
+    int numThreads = std::min(mNumThreads, numBlocks);
+    int ahead = numThreads * BatchBlocksAhead * BatchBlockFrames;
+    double scale = mScale;
+
+    std::mutex mutex;
+    std::mutex creating;
+    std::condition_variable rendered;
+    std::condition_variable room;
+    // The images are owned by one thread at a time
+    std::map<int, std::unique_ptr<wxImage>> frames;
+    int nextBlock = 0;
+    int written = first;
+    bool stopping = false;
+    bool failed = false;
+
+    auto worker = [&]() {
+        // Loading images and machines goes through state wxWidgets
+        // shares between threads, so the pictures are made one at a time
+        std::shared_ptr<Picture> picture;
+        {
+            std::lock_guard<std::mutex> lock(creating);
+            picture = mFactory();
+        }
+
+        if (picture == nullptr)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            failed = true;
+            rendered.notify_all();
+            return;
+        }
+
+        // The frames are already split across threads
+        picture->GetThreadPool()->SetNumThreads(1);
+
+        // Nobody is listening, and every thread would play the notes
+        picture->SetMachineSoundHandler([](wxSound *sound) {});
+        int frameRate = picture->GetTimeline()->GetFrameRate();
+
+        while (true)
+        {
+            int start;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                room.wait(lock, [&] { return stopping || first + nextBlock * BatchBlockFrames < written + ahead; });
+                if (stopping || nextBlock >= numBlocks)
+                {
+                    return;
+                }
+
+                start = first + nextBlock++ * BatchBlockFrames;
+            }
+
+            int end = std::min(start + BatchBlockFrames - 1, last);
+            for (int frame = start; frame <= end; frame++)
+            {
+                picture->SetAnimationTime((double)frame / frameRate);
+                auto image = std::make_unique<wxImage>(picture->RenderImage(scale));
+
+                std::lock_guard<std::mutex> lock(mutex);
+                if (stopping)
+                {
+                    return;
+                }
+
+                frames[frame] = std::move(image);
+                rendered.notify_all();
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < numThreads; i++)
+    {
+        threads.emplace_back(worker);
+    }
+
+    bool ok = true;
+    for (int frame = first; frame <= last && ok; frame++)
+    {
+        std::unique_ptr<wxImage> image;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            rendered.wait(lock, [&] { return failed || frames.contains(frame); });
+            if (failed)
+            {
+                ok = false;
+                break;
+            }
+
+            image = std::move(frames[frame]);
+            frames.erase(frame);
+        }
+
+        ok = output(frame, *image);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            written = frame + 1;
+        }
+        room.notify_all();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    room.notify_all();
+
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    return ok;
+}
+
+/**
+ * Convert an image to packed 8 bit RGBA rows, top row first
+ * @param image Image to convert, opaque if it has no alpha
+ * @param rgba Receives the pixels, resized to fit
+ */
+void BatchRenderer::ToRgba(const wxImage &image, std::vector<unsigned char> &rgba)
+{
+    int numPixels = image.GetWidth() * image.GetHeight();
+    rgba.resize((size_t)numPixels * 4);
+
+    auto rgb = image.GetData();
+    auto alpha = image.HasAlpha() ? image.GetAlpha() : nullptr;
+    for (int i = 0; i < numPixels; i++)
+    {
+        rgba[i * 4] = rgb[i * 3];
+        rgba[i * 4 + 1] = rgb[i * 3 + 1];
+        rgba[i * 4 + 2] = rgb[i * 3 + 2];
+        rgba[i * 4 + 3] = alpha != nullptr ? alpha[i] : 255;
+    }
+}
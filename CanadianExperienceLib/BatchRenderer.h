@@ -0,0 +1,93 @@
+/**
+ * @file BatchRenderer.h
+ * @author Shawn_Porto
+ *
+ * Renders a range of animation frames to images on several threads without a window.
+ */
+
+#ifndef CANADIANEXPERIENCE_BATCHRENDERER_H
+#define CANADIANEXPERIENCE_BATCHRENDERER_H
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+class Picture;
+
+/// Frames a thread renders in a row before taking another block
+const int BatchBlockFrames = 30;
+
+/// Blocks each thread may render ahead of the frame being written
+const int BatchBlocksAhead = 2;
+
+/**
+ * Renders a range of animation frames to images on several threads without a window.
+ *
+ * Each thread builds its own picture, with its own machines,
+ * from the picture factory and renders blocks of consecutive
+ * frames with Picture::RenderImage, the same drawing playback
+ * uses. Within a block a thread only steps forward, so the
+ * machines are simulated frame by frame just as when playing.
+ * Their sounds are dropped.
+ * The frames are handed to the output in order on the calling
+ * thread, and the threads wait rather than buffer more than
+ * a few blocks ahead of it.
+ */
+class BatchRenderer {
+public:
+    /// Creates a picture with the animation loaded, nullptr if it could not
+    using PictureFactory = std::function<std::shared_ptr<Picture>()>;
+
+    /// Takes each frame in order, returns false to stop rendering
+    using Output = std::function<bool(int frame, const wxImage &image)>;
+
+private:
+    /// Creates the picture for each thread
+    PictureFactory mFactory;
+
+    /// Number of threads to render on
+    int mNumThreads = 1;
+
+    /// Resolution of the images relative to the picture size
+    double mScale = 1;
+
+public:
+    BatchRenderer(PictureFactory factory);
+
+    /// Default constructor (disabled)
+    BatchRenderer() = delete;
+    /** Copy constructor disabled */
+    BatchRenderer(const BatchRenderer &) = delete;
+    /** Assignment operator disabled */
+    void operator=(const BatchRenderer &) = delete;
+
+    /**
+     * Get the number of threads frames are rendered on
+     * @return Number of threads
+     */
+    int GetNumThreads() const { return mNumThreads; }
+
+    /**
+     * Set the number of threads frames are rendered on
+     * @param threads Number of threads, at least 1
+     */
+    void SetNumThreads(int threads) { mNumThreads = std::max(1, threads); }
+
+    /**
+     * Get the resolution of the images
+     * @return Scale relative to the picture size
+     */
+    double GetScale() const { return mScale; }
+
+    /**
+     * Set the resolution of the images
+     * @param scale Scale relative to the picture size
+     */
+    void SetScale(double scale) { mScale = scale; }
+
+    bool Render(int first, int last, const Output &output);
+
+    static void ToRgba(const wxImage &image, std::vector<unsigned char> &rgba);
+};
+
+#endif //CANADIANEXPERIENCE_BATCHRENDERER_H
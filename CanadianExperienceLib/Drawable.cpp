@@ -4,9 +4,13 @@
  */
 
 #include "pch.h"
+
+#include <cfloat>
+
 #include "Drawable.h"
 #include "Actor.h"
 #include "Timeline.h"
+#include "PickIndex.h"
 
 /**
  * Constructor
@@ -14,7 +18,7 @@
  */
 Drawable::Drawable(const std::wstring &name) : mName(name)
 {
-
+    mChannel.SetObserver(this);
 }
 
 
@@ -56,28 +60,175 @@ void Drawable::SetKeyframe()
 void Drawable::GetKeyframe()
 {
     if (mChannel.IsValid())
+    {
         mRotation = mChannel.GetAngle();
+        InvalidatePlacement();
+    }
+}
+
+/**
+ * Take the new value of a channel when the timeline evaluates it.
+ * @param channel Channel that changed
+ */
+void Drawable::OnChannelChanged(AnimChannel *channel)
+{
+    double angle = mChannel.GetAngle();
+    if (angle != mRotation)
+    {
+        mRotation = angle;
+        InvalidatePlacement();
+    }
 }
 
 
 /**
  * Place this drawable relative to its parent
  *
- * This works hierarchically from top item down.
+ * This works hierarchically from top item down. The placement
+ * is cached, so a drawable is only recomputed when it or its
+ * parent moved, and a subtree where nothing moved is skipped.
  * @param offset Parent offset
  * @param rotate Parent rotation
+ * @return true if this drawable or any below it was placed somewhere new
+ */
+bool Drawable::Place(wxPoint offset, double rotate)
+{
+    bool moved = mPlacementDirty || offset != mPlacedOffset || rotate != mPlacedParentR;
+    if (!moved && !mChildPlacementDirty)
+    {
+        return false;
+    }
+
+    if (moved)
+    {
+        // The parent already knows the sine and cosine of its placed rotation
+        double cosR, sinR;
+        if (mParent != nullptr && rotate == mParent->mPlacedR)
+        {
+            cosR = mParent->mPlacedCos;
+            sinR = mParent->mPlacedSin;
+        }
+        else
+        {
+            cosR = cos(rotate);
+            sinR = sin(rotate);
+        }
+
+        // Combine the transformation we are given with the transformation
+        // for this object.
+        mPlacedPosition = offset + wxPoint(int(cosR * mPosition.x + sinR * mPosition.y),
+                int(-sinR * mPosition.x + cosR * mPosition.y));
+        mPlacedR = mRotation + rotate;
+        mPlacedCos = cos(mPlacedR);
+        mPlacedSin = sin(mPlacedR);
+
+        mPlacedOffset = offset;
+        mPlacedParentR = rotate;
+        mPlacementDirty = false;
+        mPlacement++;
+
+        UpdateBounds();
+    }
+
+    mChildPlacementDirty = false;
+
+    // Update our children. When we did not move only the
+    // children that changed themselves do any work.
+    bool childMoved = false;
+    for (auto &drawable : mChildren)
+    {
+        childMoved |= drawable->Place(mPlacedPosition, mPlacedR);
+    }
+
+    return moved || childMoved;
+}
+
+
+/**
+ * Compute the bounding rectangle in the drawing from the
+ * bounds in our own coordinates and the placement.
  */
-void Drawable::Place(wxPoint offset, double rotate)
+void Drawable::UpdateBounds()
 {
-    // Combine the transformation we are given with the transformation
-    // for this object.
-    mPlacedPosition = offset + RotatePoint(mPosition, rotate);
-    mPlacedR = mRotation + rotate;
+    auto local = GetLocalBounds();
+    if (local.IsEmpty())
+    {
+        SetBounds(wxRect());
+    }
+    else
+    {
+        double corners[4][2] = {
+                {(double)local.GetLeft(), (double)local.GetTop()},
+                {(double)local.GetLeft() + local.GetWidth(), (double)local.GetTop()},
+                {(double)local.GetLeft(), (double)local.GetTop() + local.GetHeight()},
+                {(double)local.GetLeft() + local.GetWidth(), (double)local.GetTop() + local.GetHeight()}};
+
+        double minX = DBL_MAX, minY = DBL_MAX, maxX = -DBL_MAX, maxY = -DBL_MAX;
+        for (auto &corner : corners)
+        {
+            double x = mPlacedCos * corner[0] + mPlacedSin * corner[1];
+            double y = -mPlacedSin * corner[0] + mPlacedCos * corner[1];
+            minX = std::min(minX, x);
+            minY = std::min(minY, y);
+            maxX = std::max(maxX, x);
+            maxY = std::max(maxY, y);
+        }
+
+        // Rounded outwards with a pixel to spare for antialiasing
+        int left = (int)floor(minX) + mPlacedPosition.x - 1;
+        int top = (int)floor(minY) + mPlacedPosition.y - 1;
+        int right = (int)ceil(maxX) + mPlacedPosition.x + 1;
+        int bottom = (int)ceil(maxY) + mPlacedPosition.y + 1;
+        SetBounds(wxRect(left, top, right - left, bottom - top));
+    }
+}
 
-    // Update our children
-    for (auto drawable : mChildren)
+
+/**
+ * Set the bounding rectangle of this drawable in the drawing.
+ *
+ * Drawables that are not drawn where they are placed use
+ * this to tell the pick index and the actor their bounds.
+ * @param bounds Bounding rectangle, empty if the bounds are not known
+ */
+void Drawable::SetBounds(const wxRect &bounds)
+{
+    mBounds = bounds;
+
+    if (mActor != nullptr)
+    {
+        mActor->InvalidateBounds();
+    }
+
+    if (mPickIndex != nullptr)
+    {
+        mPickIndex->Moved(mPickEntry);
+    }
+}
+
+
+/**
+ * Tell this drawable which pick index entry it has.
+ * @param index Pick index to tell when we move
+ * @param entry Our entry in the index
+ */
+void Drawable::SetPickIndex(PickIndex *index, int entry)
+{
+    mPickIndex = index;
+    mPickEntry = entry;
+}
+
+
+/**
+ * Indicate our position or rotation changed, so we and
+ * everything below us have to be placed again.
+ */
+void Drawable::InvalidatePlacement()
+{
+    mPlacementDirty = true;
+    for (auto parent = mParent; parent != nullptr && !parent->mChildPlacementDirty; parent = parent->mParent)
     {
-        drawable->Place(mPlacedPosition, mPlacedR);
+        parent->mChildPlacementDirty = true;
     }
 }
 
@@ -104,11 +255,11 @@ void Drawable::Move(wxPoint delta)
 {
     if (mParent != nullptr)
     {
-        mPosition = mPosition + RotatePoint(delta, -mParent->mPlacedR);
+        SetPosition(mPosition + RotatePoint(delta, -mParent->mPlacedR));
     }
     else
     {
-        mPosition = mPosition + delta;
+        SetPosition(mPosition + delta);
     }
 }
 
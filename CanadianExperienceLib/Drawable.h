@@ -9,9 +9,12 @@
 #define CANADIANEXPERIENCE_DRAWABLE_H
 
 #include "AnimChannelAngle.h"
+#include "AnimChannelObserver.h"
 
 class Actor;
 class Timeline;
+class TextureAtlas;
+class PickIndex;
 
 /**
  * Abstract base class for drawable elements of our picture.
@@ -19,7 +22,7 @@ class Timeline;
  * A drawable is one part of an actor. Drawable parts can be moved
  * independently.
  */
-class Drawable {
+class Drawable : public AnimChannelObserver {
 private:
     /// The drawable name
     std::wstring mName;
@@ -42,9 +45,45 @@ private:
     /// The animation channel for animating the angle of this drawable
     AnimChannelAngle mChannel;
 
+    /// Parent offset the current placement was computed from
+    wxPoint mPlacedOffset = wxPoint(0, 0);
+
+    /// Parent rotation the current placement was computed from
+    double mPlacedParentR = 0;
+
+    /// True if our own position or rotation changed since we were placed
+    bool mPlacementDirty = true;
+
+    /// True if some drawable below us needs to be placed again
+    bool mChildPlacementDirty = true;
+
+    /// Bounding rectangle of the placed drawable in the drawing
+    wxRect mBounds;
+
+    /// Number of times this drawable was placed somewhere new
+    int mPlacement = 0;
+
+    /// The pick index that is told when we move
+    PickIndex *mPickIndex = nullptr;
+
+    /// Our entry in the pick index
+    int mPickEntry = -1;
+
+    void UpdateBounds();
+
 protected:
     Drawable(const std::wstring &name);
     wxPoint RotatePoint(wxPoint point, double angle);
+    void InvalidatePlacement();
+    void SetBounds(const wxRect &bounds);
+
+    /**
+     * Get the bounding rectangle of what we draw in our
+     * own coordinates. An empty rectangle means the
+     * bounds are not known.
+     * @return Bounding rectangle relative to our position
+     */
+    virtual wxRect GetLocalBounds() { return wxRect(); }
 
 
     /// The actual postion in the drawing
@@ -53,6 +92,12 @@ protected:
     /// The actual rotation in the drawing
     double mPlacedR = 0;
 
+    /// Cosine of mPlacedR
+    double mPlacedCos = 1;
+
+    /// Sine of mPlacedR
+    double mPlacedSin = 0;
+
 public:
     virtual ~Drawable() {}
 
@@ -71,10 +116,51 @@ public:
      */
     virtual void Draw(std::shared_ptr<wxGraphicsContext> graphics) = 0;
 
-    void Place(wxPoint offset, double rotate);
+    bool Place(wxPoint offset, double rotate);
+
+    /**
+     * Transform a point from this drawable's coordinates to
+     * the drawing using the placed position and rotation.
+     * @param point Point relative to this drawable
+     * @return Point in the drawing
+     */
+    wxPoint PlacePoint(wxPoint point) const
+    {
+        return wxPoint(int(mPlacedCos * point.x + mPlacedSin * point.y),
+                int(-mPlacedSin * point.x + mPlacedCos * point.y)) + mPlacedPosition;
+    }
 
     void AddChild(std::shared_ptr<Drawable> child);
 
+    /**
+     * Get the bounding rectangle of this drawable in the
+     * drawing, valid once it has been placed.
+     * @return Bounding rectangle, empty if the bounds are not known
+     */
+    wxRect GetBounds() const { return mBounds; }
+
+    /**
+     * Get the actual position in the drawing
+     * @return Placed position
+     */
+    wxPoint GetPlacedPosition() const { return mPlacedPosition; }
+
+    /**
+     * Get the actual rotation in the drawing
+     * @return Placed rotation in radians
+     */
+    double GetPlacedRotation() const { return mPlacedR; }
+
+    /**
+     * Get a number that changes each time the drawable is
+     * placed somewhere new, so anything computed from the
+     * placement can tell when it is out of date.
+     * @return Placement count
+     */
+    int GetPlacement() const { return mPlacement; }
+
+    void SetPickIndex(PickIndex *index, int entry);
+
     /**
      * Test to see if we have been clicked on by the mouse
      * @param pos Position to test
@@ -88,13 +174,20 @@ public:
      */
     virtual bool IsMovable() { return false; }
 
+    /**
+     * Does what this drawable draws change with time even
+     * when it is not placed somewhere new?
+     * @return true if it has to be repainted every frame
+     */
+    virtual bool ChangesWithTime() { return false; }
+
     void Move(wxPoint delta);
 
     /**
      * Set the drawable position
      * @param pos The new drawable position
      */
-    virtual void SetPosition(wxPoint pos) { mPosition = pos; }
+    virtual void SetPosition(wxPoint pos) { mPosition = pos; InvalidatePlacement(); }
 
     /**
      * Get the drawable position
@@ -106,7 +199,7 @@ public:
      * Set the rotation angle in radians
     * @param r The new rotation angle in radians
      */
-    void SetRotation(double r) { mRotation = r; }
+    void SetRotation(double r) { mRotation = r; InvalidatePlacement(); mChannel.Invalidate(); }
 
     /**
      * Get the rotation angle in radians
@@ -124,7 +217,7 @@ public:
      * Set the drawable parent
      * @param parent New parent pointer
      */
-    void SetParent(Drawable *parent) { mParent = parent; }
+    void SetParent(Drawable *parent) { mParent = parent; InvalidatePlacement(); }
 
     /**
      * Get the drawable parent
@@ -133,9 +226,18 @@ public:
     Drawable *GetParent() { return mParent; }
 
     virtual void SetTimeline(Timeline *timeline);
+
+    /**
+     * Set the texture atlas images are drawn from
+     * @param atlas Atlas to add our images to
+     */
+    virtual void SetAtlas(TextureAtlas *atlas) {}
+
     virtual void SetKeyframe();
     virtual void GetKeyframe();
 
+    void OnChannelChanged(AnimChannel *channel) override;
+
     /**
      * The angle animation channel
      * @return Pointer to animation channel
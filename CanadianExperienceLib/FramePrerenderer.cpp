@@ -0,0 +1,222 @@
+/**
+ * @file FramePrerenderer.cpp
+ * @author Shawn_Porto
+ */
+
+#include "pch.h"
+#include "FramePrerenderer.h"
+
+#include <wx/sound.h>
+
+#include "Picture.h"
+#include "Timeline.h"
+#include "Trace.h"
+
+/**
+ * Constructor
+ * @param picture Picture that is rendered
+ */
+FramePrerenderer::FramePrerenderer(Picture *picture) : mPicture(picture)
+{
+    mSoundPlayer = [](wxSound *sound) { sound->Play(); };
+}
+
+/**
+ * Destructor, stops the worker
+ */
+FramePrerenderer::~FramePrerenderer()
+{
+    Join();
+}
+
+/**
+ * Start rendering frames ahead.
+ *
+ * From here until Stop() the worker owns the picture, and
+ * the sounds of the machines are kept with the frames.
+ * @param frame First frame to render
+ */
+void FramePrerenderer::Start(int frame)
+{
+    Stop();
+
+    mPicture->SetMachineSoundHandler([this](wxSound *sound) { mRenderSounds.push_back(sound); });
+
+    auto timeline = mPicture->GetTimeline();
+
+    mStartFrame = frame;
+    mLastFrame = timeline->GetNumFrames() - 1;
+    mNextFrame = frame;
+    mThread = std::thread(&FramePrerenderer::Run, this,
+            timeline->GetFrameRate(), mScale, mDepth);
+}
+
+/**
+ * Stop rendering frames ahead.
+ *
+ * The buffered frames are thrown away and the picture is
+ * left at the frame last presented, so it can be edited.
+ * Moving the machines back there is silent, and after that
+ * they play their sounds themselves again.
+ */
+void FramePrerenderer::Stop()
+{
+    if (!IsRunning())
+    {
+        return;
+    }
+
+    Join();
+
+    int frame = mPresentedFrame >= 0 ? mPresentedFrame : mStartFrame;
+    mPresentedFrame = -1;
+    mPresented = wxBitmap();
+
+    mPicture->SetMachineSoundHandler([](wxSound *sound) {});
+    mPicture->SetAnimationTime((double)frame / mPicture->GetTimeline()->GetFrameRate());
+    mPicture->SetMachineSoundHandler(nullptr);
+}
+
+/**
+ * Stop the worker and throw away the buffered frames
+ */
+void FramePrerenderer::Join()
+{
+    if (!IsRunning())
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStopping = true;
+    }
+
+    mRoom.notify_all();
+    mThread.join();
+
+    mFrames.clear();
+    mStopping = false;
+}
+
+/**
+ * Wait until a frame has been rendered
+ * @param frame Frame to wait for
+ * @return false if the frame is past the end and will never be rendered
+ */
+bool FramePrerenderer::WaitFor(int frame)
+{
+    if (!IsRunning() || frame > mLastFrame)
+    {
+        return false;
+    }
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    mRendered.wait(lock, [this, frame] { return !mFrames.empty() && mFrames.back().frame >= frame; });
+    return true;
+}
+
+/**
+ * Present a frame.
+ *
+ * Frames before it are thrown away, and the worker skips
+ * ahead if it has fallen behind. The sounds of the frame,
+ * and of any frames thrown away, are played now.
+ * @param frame Frame that is due
+ * @return true if the frame was ready, false if it was dropped
+ */
+bool FramePrerenderer::Present(int frame)
+{
+    std::unique_ptr<wxImage> image;
+    std::vector<wxSound *> sounds;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        while (!mFrames.empty() && mFrames.front().frame <= frame)
+        {
+            auto &front = mFrames.front();
+            sounds.insert(sounds.end(), front.sounds.begin(), front.sounds.end());
+            if (front.frame == frame)
+            {
+                image = std::move(front.image);
+            }
+
+            mFrames.pop_front();
+        }
+
+        // Frames that are already due are never rendered
+        mNextFrame = std::max(mNextFrame, frame + 1);
+    }
+
+    mRoom.notify_all();
+
+    for (auto sound : sounds)
+    {
+        mSoundPlayer(sound);
+    }
+
+    if (image == nullptr)
+    {
+        return false;
+    }
+
+    mPresented = wxBitmap(*image);
+    mPresentedFrame = frame;
+    return true;
+}
+
+/**
+ * Get the number of frames rendered and not yet presented
+ * @return Number of frames in the buffer
+ */
+int FramePrerenderer::GetNumBuffered()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return (int)mFrames.size();
+}
+
+/**
+ * The worker thread: evaluate and render frames until stopped
+ * @param frameRate Frames per second
+ * @param scale Resolution of the rendered frames relative to the picture
+ * @param depth Most frames to buffer
+ */
+void FramePrerenderer::Run(int frameRate, double scale, int depth)
+{
+    auto timeline = mPicture->GetTimeline();
+
+    while (true)
+    {
+        int frame;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mRoom.wait(lock, [this, depth] {
+                return mStopping || ((int)mFrames.size() < depth && mNextFrame <= mLastFrame);
+            });
+
+            if (mStopping)
+            {
+                return;
+            }
+
+            frame = mNextFrame++;
+        }
+
+        TraceSpan span("FramePrerenderer::Render");
+
+        // The picture observers are on the user interface thread, so the
+        // timeline is set directly instead of through SetAnimationTime.
+        // The channel observers are the drawables and actors of the
+        // picture, which the worker owns, so they are updated here.
+        mRenderSounds.clear();
+        timeline->SetCurrentTime((double)frame / frameRate);
+
+        auto image = std::make_unique<wxImage>(mPicture->RenderImage(scale));
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mFrames.push_back({frame, std::move(image), std::move(mRenderSounds)});
+        }
+
+        mRendered.notify_all();
+    }
+}
@@ -0,0 +1,191 @@
+/**
+ * @file FramePrerenderer.h
+ * @author Shawn_Porto
+ *
+ * Renders upcoming frames of a picture on a worker thread during playback.
+ */
+
+#ifndef CANADIANEXPERIENCE_FRAMEPRERENDERER_H
+#define CANADIANEXPERIENCE_FRAMEPRERENDERER_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "../MachineLib/IMachineAudio.h"
+
+class Picture;
+
+/// Number of frames rendered ahead unless set otherwise
+const int PrerenderDefaultDepth = 8;
+
+/**
+ * Renders upcoming frames of a picture on a worker thread during playback.
+ *
+ * While it runs the worker owns the picture. It evaluates the
+ * timeline for each frame in turn, machines included, and draws
+ * the frame into an offscreen image, staying at most the buffer
+ * depth ahead of the frame presented. The user interface thread
+ * only presents the frame that is due and draws its bitmap.
+ *
+ * The machines would play their sounds when the worker renders
+ * a frame, well before it is shown. While the worker runs their
+ * sounds are kept with the frame instead and played by Present()
+ * on the user interface thread.
+ *
+ * Nothing else may touch the picture while the worker runs, so
+ * anything that edits or reads the scene calls Stop() first.
+ * Stop() leaves the picture at the frame last presented and
+ * throws away the buffered frames, which are rendered again
+ * when playback resumes.
+ */
+class FramePrerenderer {
+private:
+    /// A frame rendered ahead
+    struct Frame
+    {
+        /// Frame number
+        int frame;
+
+        /// The rendered frame, owned by one thread at a time
+        std::unique_ptr<wxImage> image;
+
+        /// Sounds the machines made while the frame was rendered
+        std::vector<wxSound *> sounds;
+    };
+
+    /// Picture that is rendered
+    Picture *mPicture;
+
+    /// Is playback prerendered?
+    bool mEnabled = false;
+
+    /// Most frames buffered ahead
+    int mDepth = PrerenderDefaultDepth;
+
+    /// Resolution of the rendered frames relative to the picture
+    double mScale = 1;
+
+    /// The worker thread
+    std::thread mThread;
+
+    /// Guards everything the worker shares with the user interface
+    std::mutex mMutex;
+
+    /// Signals the worker there is room in the buffer, or it should stop
+    std::condition_variable mRoom;
+
+    /// Signals a frame has been rendered
+    std::condition_variable mRendered;
+
+    /// Rendered frames in increasing order
+    std::deque<Frame> mFrames;
+
+    /// Frame the worker was started at
+    int mStartFrame = 0;
+
+    /// Last frame of the animation
+    int mLastFrame = 0;
+
+    /// Next frame the worker renders
+    int mNextFrame = 0;
+
+    /// Should the worker stop?
+    bool mStopping = false;
+
+    /// Bitmap of the frame presented
+    wxBitmap mPresented;
+
+    /// Frame presented, -1 if none
+    int mPresentedFrame = -1;
+
+    /// Sounds made while the worker renders a frame, only used by the worker
+    std::vector<wxSound *> mRenderSounds;
+
+    /// Plays the sounds of the presented frames
+    IMachineAudio::SoundHandler mSoundPlayer;
+
+    void Run(int frameRate, double scale, int depth);
+    void Join();
+
+public:
+    FramePrerenderer(Picture *picture);
+    ~FramePrerenderer();
+
+    /** Default constructor disabled */
+    FramePrerenderer() = delete;
+    /** Copy constructor disabled */
+    FramePrerenderer(const FramePrerenderer &) = delete;
+    /** Assignment operator disabled */
+    void operator=(const FramePrerenderer &) = delete;
+
+    /**
+     * Is playback prerendered?
+     * @return true if playback renders frames ahead on a worker thread
+     */
+    bool IsEnabled() const { return mEnabled; }
+
+    /**
+     * Choose whether playback is prerendered
+     * @param enabled true to render frames ahead on a worker thread
+     */
+    void SetEnabled(bool enabled) { mEnabled = enabled; }
+
+    /**
+     * Get the most frames buffered ahead
+     * @return Buffer depth in frames
+     */
+    int GetDepth() const { return mDepth; }
+
+    /**
+     * Set the most frames buffered ahead, from the next Start()
+     * @param depth Buffer depth in frames, at least 1
+     */
+    void SetDepth(int depth) { mDepth = std::max(1, depth); }
+
+    /**
+     * Get the resolution of the rendered frames
+     * @return Scale relative to the picture size
+     */
+    double GetScale() const { return mScale; }
+
+    /**
+     * Set the resolution of the rendered frames, from the next Start()
+     * @param scale Scale relative to the picture size, 0.5 renders at half resolution
+     */
+    void SetScale(double scale) { mScale = scale; }
+
+    /**
+     * Set what plays the sounds of the frames presented
+     * @param player Called on the user interface thread for each sound
+     */
+    void SetSoundPlayer(const IMachineAudio::SoundHandler &player) { mSoundPlayer = player; }
+
+    void Start(int frame);
+    void Stop();
+    bool WaitFor(int frame);
+    bool Present(int frame);
+    int GetNumBuffered();
+
+    /**
+     * Is the worker running? While it is, only this
+     * object may be used to get at the picture.
+     * @return true between Start() and Stop()
+     */
+    bool IsRunning() const { return mThread.joinable(); }
+
+    /**
+     * Get the bitmap of the frame presented
+     * @return Bitmap, only valid if GetPresentedFrame() is not -1
+     */
+    const wxBitmap &GetPresented() const { return mPresented; }
+
+    /**
+     * Get the frame presented
+     * @return Frame number or -1 if none has been presented
+     */
+    int GetPresentedFrame() const { return mPresentedFrame; }
+};
+
+#endif //CANADIANEXPERIENCE_FRAMEPRERENDERER_H
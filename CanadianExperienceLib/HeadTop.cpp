@@ -21,7 +21,7 @@
 HeadTop::HeadTop(const std::wstring& name, const std::wstring& filename)
         : ImageDrawable(name, filename)
 {
-
+    mPositionChannel.SetObserver(this);
 }
 
 
@@ -49,6 +49,18 @@ void HeadTop::SetTimeline(Timeline *timeline)
     timeline->AddChannel(&mPositionChannel);
 }
 
+/**
+ * Set the texture atlas. The eyes are drawn from it too.
+ * @param atlas Atlas to add our images to
+ */
+void HeadTop::SetAtlas(TextureAtlas *atlas)
+{
+    ImageDrawable::SetAtlas(atlas);
+
+    mLeftEye.SetAtlas(atlas);
+    mRightEye.SetAtlas(atlas);
+}
+
 /**
  * Set the keyframe based on the current status.
 */
@@ -68,7 +80,34 @@ void HeadTop::GetKeyframe()
 
     if (mPositionChannel.IsValid())
     {
-        SetPosition(mPositionChannel.GetPoint());
+        ImageDrawable::SetPosition(mPositionChannel.GetPoint());
+    }
+}
+
+/**
+ * Set the head top position. The animation replaces
+ * the position the next time the time changes.
+ * @param pos The new position
+ */
+void HeadTop::SetPosition(wxPoint pos)
+{
+    ImageDrawable::SetPosition(pos);
+    mPositionChannel.Invalidate();
+}
+
+/**
+ * Take the new value of a channel when the timeline evaluates it.
+ * @param channel Channel that changed
+ */
+void HeadTop::OnChannelChanged(AnimChannel *channel)
+{
+    if (channel == &mPositionChannel)
+    {
+        ImageDrawable::SetPosition(mPositionChannel.GetPoint());
+    }
+    else
+    {
+        ImageDrawable::OnChannelChanged(channel);
     }
 }
 
@@ -189,5 +228,5 @@ wxPoint HeadTop::TransformPoint(wxPoint p)
     p = p - GetCenter();
 
     // Rotate as needed and offset
-    return RotatePoint(p, mPlacedR) + mPlacedPosition;
+    return PlacePoint(p);
 }
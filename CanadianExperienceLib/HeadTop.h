@@ -72,8 +72,11 @@ public:
 
     void SetActor(Actor* actor) override;
     void SetTimeline(Timeline* timeline) override;
+    void SetAtlas(TextureAtlas* atlas) override;
     void SetKeyframe() override;
     void GetKeyframe() override;
+    void SetPosition(wxPoint pos) override;
+    void OnChannelChanged(AnimChannel *channel) override;
 };
 
 #endif //CANADIANEXPERIENCE_HEADTOP_H
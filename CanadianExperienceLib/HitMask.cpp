@@ -0,0 +1,60 @@
+/**
+ * @file HitMask.cpp
+ * @author Shawn_Porto
+ */
+
+#include "pch.h"
+#include "HitMask.h"
+
+/**
+ * Build the mask from an image.
+ *
+ * Pixels with an alpha below wxIMAGE_ALPHA_THRESHOLD or the
+ * mask colour are transparent. An image with neither alpha
+ * nor a mask is drawn everywhere.
+ * @param image Image to build the mask from
+ */
+void HitMask::Build(const wxImage &image)
+{
+    mWidth = image.IsOk() ? image.GetWidth() : 0;
+    mHeight = image.IsOk() ? image.GetHeight() : 0;
+    mStride = (mWidth + 63) / 64;
+    mBits.assign((size_t)mStride * mHeight, 0);
+
+    if (mWidth == 0 || mHeight == 0)
+    {
+        return;
+    }
+
+    auto alpha = image.HasAlpha() ? image.GetAlpha() : nullptr;
+    auto data = image.GetData();
+    bool masked = image.HasMask();
+    unsigned char maskR = masked ? image.GetMaskRed() : 0;
+    unsigned char maskG = masked ? image.GetMaskGreen() : 0;
+    unsigned char maskB = masked ? image.GetMaskBlue() : 0;
+
+    for (int y = 0; y < mHeight; y++)
+    {
+        auto row = mBits.data() + (size_t)y * mStride;
+        for (int x = 0; x < mWidth; x++)
+        {
+            size_t pixel = (size_t)y * mWidth + x;
+
+            bool drawn = true;
+            if (alpha != nullptr)
+            {
+                drawn = alpha[pixel] >= wxIMAGE_ALPHA_THRESHOLD;
+            }
+            else if (masked)
+            {
+                auto rgb = data + pixel * 3;
+                drawn = rgb[0] != maskR || rgb[1] != maskG || rgb[2] != maskB;
+            }
+
+            if (drawn)
+            {
+                row[x >> 6] |= uint64_t(1) << (x & 63);
+            }
+        }
+    }
+}
@@ -0,0 +1,69 @@
+/**
+ * @file HitMask.h
+ * @author Shawn_Porto
+ *
+ * One bit per pixel record of which pixels of an image are drawn.
+ */
+
+#ifndef CANADIANEXPERIENCE_HITMASK_H
+#define CANADIANEXPERIENCE_HITMASK_H
+
+#include <cstdint>
+
+/**
+ * One bit per pixel record of which pixels of an image are drawn.
+ *
+ * The mask is built once when the image is loaded, so hit
+ * testing does not need the image or a graphics context. A
+ * pixel is drawn exactly when wxImage::IsTransparent would
+ * say it is not transparent.
+ */
+class HitMask {
+private:
+    /// Width of the mask in pixels
+    int mWidth = 0;
+
+    /// Height of the mask in pixels
+    int mHeight = 0;
+
+    /// Number of 64 bit words in each row
+    int mStride = 0;
+
+    /// The bits, row by row, one bit set for each drawn pixel
+    std::vector<uint64_t> mBits;
+
+public:
+    HitMask() {}
+
+    void Build(const wxImage &image);
+
+    /**
+     * Is a pixel drawn?
+     * @param x X location in the image
+     * @param y Y location in the image
+     * @return true if the pixel is inside the image and not transparent
+     */
+    bool Contains(int x, int y) const
+    {
+        if (x < 0 || y < 0 || x >= mWidth || y >= mHeight)
+        {
+            return false;
+        }
+
+        return (mBits[(size_t)y * mStride + (x >> 6)] >> (x & 63)) & 1;
+    }
+
+    /**
+     * Get the mask width
+     * @return Width in pixels
+     */
+    int GetWidth() const { return mWidth; }
+
+    /**
+     * Get the mask height
+     * @return Height in pixels
+     */
+    int GetHeight() const { return mHeight; }
+};
+
+#endif //CANADIANEXPERIENCE_HITMASK_H
@@ -5,15 +5,17 @@
 
 #include "pch.h"
 #include "ImageDrawable.h"
+#include "TextureAtlas.h"
 
 
 /** Constructor
  * @param name The drawable name
  * @param filename The filename for the image */
 ImageDrawable::ImageDrawable(const std::wstring &name, const std::wstring &filename) :
-        Drawable(name)
+        Drawable(name), mFilename(filename)
 {
     mImage = std::make_unique<wxImage>(filename, wxBITMAP_TYPE_ANY);
+    mHitMask.Build(*mImage);
 }
 
 
@@ -23,7 +25,7 @@ ImageDrawable::ImageDrawable(const std::wstring &name, const std::wstring &filen
  */
 void ImageDrawable::Draw(std::shared_ptr<wxGraphicsContext> graphics)
 {
-    if(mBitmap.IsNull())
+    if(mAtlasImage < 0 && mBitmap.IsNull())
     {
         mBitmap = graphics->CreateBitmapFromImage(*mImage);
     }
@@ -31,13 +33,32 @@ void ImageDrawable::Draw(std::shared_ptr<wxGraphicsContext> graphics)
     graphics->PushState();
     graphics->Translate(mPlacedPosition.x, mPlacedPosition.y);
     graphics->Rotate(-mPlacedR);
-    graphics->DrawBitmap(mBitmap, -mCenter.x, -mCenter.y,
-            mImage->GetWidth(), mImage->GetHeight());
+
+    if (mAtlasImage >= 0)
+    {
+        mAtlas->Draw(graphics, mAtlasImage, -mCenter.x, -mCenter.y);
+    }
+    else
+    {
+        graphics->DrawBitmap(mBitmap, -mCenter.x, -mCenter.y,
+                mImage->GetWidth(), mImage->GetHeight());
+    }
 
     graphics->PopState();
 }
 
 
+/**
+ * Set the texture atlas the image is drawn from
+ * @param atlas Atlas to add the image to
+ */
+void ImageDrawable::SetAtlas(TextureAtlas *atlas)
+{
+    mAtlas = atlas;
+    mAtlasImage = atlas->Add(mFilename, *mImage);
+}
+
+
 /**
  * Test to see if we clicked on the image.
  * @param pos Position to test
@@ -52,8 +73,8 @@ bool ImageDrawable::HitTest(wxPoint pos)
     x -= mPlacedPosition.x;
     y -= mPlacedPosition.y;
 
-    double sn = sin(mPlacedR);
-    double cs = cos(mPlacedR);
+    double sn = mPlacedSin;
+    double cs = mPlacedCos;
 
     // Rotate(mPlacedR)
     double x1 = cs * x - sn * y;
@@ -63,28 +84,7 @@ bool ImageDrawable::HitTest(wxPoint pos)
     x = x1 + mCenter.x;
     y = y1 + mCenter.y;
 
-
-//    wxGraphicsMatrix mat;
-//    mat.Translate(mCenter.x, mCenter.y);
-//    mat.Rotate(mPlacedR);
-//    mat.Translate(-mPlacedPosition.x, -mPlacedPosition.y);
-//
-//    wxDouble x = pos.x;
-//    wxDouble y = pos.y;
-//    mat.TransformPoint(&x, &y);
-
-    double wid = mImage->GetWidth();
-    double hit = mImage->GetHeight();
-
-    // Test to see if x, y are in the image
-    if (x < 0 || y < 0 || x >= wid || y >= hit)
-    {
-        // We are outside the image
-        return false;
-    }
-
-    // Test to see if x, y are in the drawn part of the image
-    // If the location is transparent, we are not in the drawn
-    // part of the image
-    return !mImage->IsTransparent((int)x, (int)y);
+    // Test to see if x, y are in the drawn part of the image.
+    // The mask is false outside the image and where it is transparent.
+    return mHitMask.Contains((int)floor(x), (int)floor(y));
 }
\ No newline at end of file
@@ -9,6 +9,9 @@
 #define CANADIANEXPERIENCE_IMAGEDRAWABLE_H
 
 #include "Drawable.h"
+#include "HitMask.h"
+
+class TextureAtlas;
 
 /**
  * A drawable that displays an image
@@ -18,12 +21,24 @@ private:
     /// The underlying image we are drawing
     std::unique_ptr<wxImage> mImage;
 
-    /// The graphics bitmap we will use
+    /// The file the image was loaded from
+    std::wstring mFilename;
+
+    /// The graphics bitmap we will use when there is no atlas
     wxGraphicsBitmap mBitmap;
 
+    /// The atlas the image is drawn from
+    TextureAtlas *mAtlas = nullptr;
+
+    /// Index of the image in the atlas
+    int mAtlasImage = -1;
+
     /// The center of the image
     wxPoint mCenter = wxPoint(0, 0);
 
+    /// Which pixels of the image are drawn, for hit testing
+    HitMask mHitMask;
+
 public:
     ImageDrawable(const std::wstring& name, const std::wstring& filename);
 
@@ -31,7 +46,7 @@ public:
      * Set the center to rotate around
      * @param center New center
      */
-    void SetCenter(wxPoint center) { mCenter = center; }
+    void SetCenter(wxPoint center) { mCenter = center; InvalidatePlacement(); }
 
     /**
      * Get the center to rotate around
@@ -42,6 +57,30 @@ public:
     void Draw(std::shared_ptr<wxGraphicsContext> graphics) override;
 
     bool HitTest(wxPoint pos) override;
+
+    void SetAtlas(TextureAtlas *atlas) override;
+
+    /**
+     * Get the atlas the image is drawn from
+     * @return Atlas or nullptr if there is none
+     */
+    TextureAtlas *GetAtlas() const { return mAtlas; }
+
+    /**
+     * Get the index of the image in the atlas
+     * @return Index or -1 if the image is not in an atlas
+     */
+    int GetAtlasImage() const { return mAtlasImage; }
+
+protected:
+    /**
+     * Get the bounding rectangle of the image in our own coordinates
+     * @return Rectangle of the image around the center
+     */
+    wxRect GetLocalBounds() override
+    {
+        return wxRect(-mCenter.x, -mCenter.y, mHitMask.GetWidth(), mHitMask.GetHeight());
+    }
 };
 
 #endif //CANADIANEXPERIENCE_IMAGEDRAWABLE_H
@@ -0,0 +1,137 @@
+/**
+ * @file KeyframeSummary.cpp
+ * @author Shawn_Porto
+ */
+
+#include "pch.h"
+#include "KeyframeSummary.h"
+
+/// Frames the summary holds when the first keyframe is added
+const int KeyframeSummaryMinCapacity = 512;
+
+/**
+ * Combine the summaries of two adjacent ranges
+ * @param a First range
+ * @param b Second range
+ * @return Summary of both ranges
+ */
+static KeyframeSummary::Bucket Combine(const KeyframeSummary::Bucket &a, const KeyframeSummary::Bucket &b)
+{
+    KeyframeSummary::Bucket bucket;
+    bucket.count = a.count + b.count;
+    bucket.max = std::max(a.max, b.max);
+    return bucket;
+}
+
+/**
+ * Remove all of the keyframes
+ */
+void KeyframeSummary::Clear()
+{
+    mLevels.clear();
+}
+
+/**
+ * Change the number of keyframes on a frame
+ * @param frame Frame the keyframe is on
+ * @param delta Keyframes added, negative if removed
+ */
+void KeyframeSummary::Update(int frame, int delta)
+{
+    if (frame < 0)
+    {
+        return;
+    }
+
+    if (frame >= GetCapacity())
+    {
+        if (delta < 0)
+        {
+            return;
+        }
+
+        Resize(frame + 1);
+    }
+
+    auto &bucket = mLevels[0][frame];
+    bucket.count += delta;
+    bucket.max = bucket.count;
+
+    int index = frame;
+    for (size_t level = 1; level < mLevels.size(); level++)
+    {
+        index /= 2;
+        auto &below = mLevels[level - 1];
+        mLevels[level][index] = Combine(below[index * 2], below[index * 2 + 1]);
+    }
+}
+
+/**
+ * Grow the summary so it holds at least a number of frames.
+ *
+ * The capacity doubles, so a summary that grows one frame
+ * at a time is rebuilt only a logarithmic number of times.
+ * @param frames Number of frames to hold
+ */
+void KeyframeSummary::Resize(int frames)
+{
+    int capacity = std::max(GetCapacity(), KeyframeSummaryMinCapacity);
+    while (capacity < frames)
+    {
+        capacity *= 2;
+    }
+
+    std::vector<Bucket> frameBuckets;
+    if (!mLevels.empty())
+    {
+        frameBuckets = std::move(mLevels[0]);
+    }
+    frameBuckets.resize(capacity);
+
+    mLevels.clear();
+    mLevels.push_back(std::move(frameBuckets));
+    while (mLevels.back().size() > 1)
+    {
+        auto &below = mLevels.back();
+        std::vector<Bucket> level(below.size() / 2);
+        for (size_t i = 0; i < level.size(); i++)
+        {
+            level[i] = Combine(below[i * 2], below[i * 2 + 1]);
+        }
+
+        mLevels.push_back(std::move(level));
+    }
+}
+
+/**
+ * Summarize the keyframes in a range of frames
+ * @param first First frame of the range
+ * @param end Frame after the last frame of the range
+ * @return Summary of the range
+ */
+KeyframeSummary::Bucket KeyframeSummary::Summarize(int first, int end) const
+{
+    int left = std::max(first, 0);
+    int right = std::min(end, GetCapacity());
+
+    // Take the buckets at the ends of the range that do not
+    // pair up at this level, then move up a level for the rest
+    Bucket summary;
+    for (size_t level = 0; left < right; level++)
+    {
+        if (left % 2 == 1)
+        {
+            summary = Combine(summary, mLevels[level][left++]);
+        }
+
+        if (right % 2 == 1)
+        {
+            summary = Combine(summary, mLevels[level][--right]);
+        }
+
+        left /= 2;
+        right /= 2;
+    }
+
+    return summary;
+}
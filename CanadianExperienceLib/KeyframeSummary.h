@@ -0,0 +1,77 @@
+/**
+ * @file KeyframeSummary.h
+ * @author Shawn_Porto
+ *
+ * Counts of the keyframes on each frame, summarized at every power of two.
+ */
+
+#ifndef CANADIANEXPERIENCE_KEYFRAMESUMMARY_H
+#define CANADIANEXPERIENCE_KEYFRAMESUMMARY_H
+
+/**
+ * Counts of the keyframes on each frame, summarized at every power of two.
+ *
+ * Level 0 has a bucket for every frame. Each bucket of the level
+ * above covers two buckets of the level below and keeps their total
+ * and the largest count on any single frame. Adding or removing a
+ * keyframe updates one bucket per level, and the keyframes in any
+ * range of frames are found from at most two buckets per level, so
+ * neither depends on how many keyframes there are.
+ */
+class KeyframeSummary {
+public:
+    /// Summary of a range of frames
+    struct Bucket
+    {
+        /// Number of keyframes in the range
+        int count = 0;
+
+        /// Most keyframes on any one frame of the range
+        int max = 0;
+    };
+
+private:
+    /// The buckets of each level, level 0 has one per frame
+    std::vector<std::vector<Bucket>> mLevels;
+
+    void Update(int frame, int delta);
+    void Resize(int frames);
+
+public:
+    KeyframeSummary() {}
+
+    /** Copy constructor disabled */
+    KeyframeSummary(const KeyframeSummary &) = delete;
+    /** Assignment operator disabled */
+    void operator=(const KeyframeSummary &) = delete;
+
+    /**
+     * Add a keyframe
+     * @param frame Frame the keyframe is on
+     */
+    void Add(int frame) { Update(frame, 1); }
+
+    /**
+     * Remove a keyframe
+     * @param frame Frame the keyframe was on
+     */
+    void Remove(int frame) { Update(frame, -1); }
+
+    void Clear();
+
+    Bucket Summarize(int first, int end) const;
+
+    /**
+     * Summary of every keyframe
+     * @return Bucket covering all of the frames
+     */
+    Bucket GetTotal() const { return mLevels.empty() ? Bucket() : mLevels.back()[0]; }
+
+    /**
+     * Number of frames the summary can hold before it grows
+     * @return Number of level 0 buckets
+     */
+    int GetCapacity() const { return mLevels.empty() ? 0 : (int)mLevels[0].size(); }
+};
+
+#endif //CANADIANEXPERIENCE_KEYFRAMESUMMARY_H
@@ -0,0 +1,194 @@
+/**
+ * @file MachineStateCache.cpp
+ * @author Shawn_Porto
+ */
+
+#include "pch.h"
+#include "MachineStateCache.h"
+
+#include "../MachineLib/IMachineSystem.h"
+#include "../MachineLib/IMachineCheckpoint.h"
+#include "../MachineLib/IMachineStatistics.h"
+#include "../MachineLib/MachineCheckpoint.h"
+
+/**
+ * Set the machine system the checkpoints are taken of
+ * @param system Machine system
+ */
+void MachineStateCache::SetSystem(std::shared_ptr<IMachineSystem> system)
+{
+    mSystem = system;
+    mCheckpoints = std::dynamic_pointer_cast<IMachineCheckpoint>(system);
+    mStatistics = std::dynamic_pointer_cast<IMachineStatistics>(system);
+    Clear();
+}
+
+/**
+ * Set the frame rate of the machine system.
+ *
+ * The checkpoints are thrown away if it changes,
+ * since the same frame is then a different time.
+ * @param rate Frame rate in frames per second
+ */
+void MachineStateCache::SetFrameRate(double rate)
+{
+    if (rate == mFrameRate)
+    {
+        return;
+    }
+
+    mSystem->SetFrameRate(rate);
+    Clear();
+    mFrameRate = rate;
+}
+
+/**
+ * Throw away the checkpoints. Call this when the machine is chosen again.
+ */
+void MachineStateCache::Clear()
+{
+    mSpaced.clear();
+    mRecent.clear();
+    mFrame = -1;
+    if (mSystem != nullptr)
+    {
+        mMachineNumber = mSystem->GetMachineNumber();
+    }
+}
+
+/**
+ * Set the machine system to a frame, resuming from
+ * the nearest checkpoint at or before it.
+ *
+ * This is one frame of the machine statistics, however many
+ * steps and restores it takes.
+ * @param frame Machine frame, frames before 0 are the machine at rest
+ */
+void MachineStateCache::SetMachineFrame(int frame)
+{
+    if (mStatistics != nullptr)
+    {
+        mStatistics->BeginStatisticsFrame();
+    }
+
+    mLastSteps = 0;
+    if (mCheckpoints == nullptr)
+    {
+        mSystem->SetMachineFrame(frame);
+        return;
+    }
+
+    if (mSystem->GetMachineNumber() != mMachineNumber)
+    {
+        Clear();
+    }
+
+    if (mFrame < 0)
+    {
+        // Put the machine at rest so there is a known frame to start from
+        mSystem->SetMachineFrame(0);
+        mFrame = 0;
+        mSpaced[0] = mCheckpoints->SaveCheckpoint();
+    }
+
+    int target = std::max(frame, 0);
+
+    // Playback steps forward one frame at a time and
+    // does not need a checkpoint at every frame it visits
+    bool jump = target != mFrame && target != mFrame + 1;
+
+    auto nearest = Nearest(target);
+    if (nearest != nullptr && (target < mFrame || nearest->GetFrame() > mFrame))
+    {
+        Restore(nearest);
+    }
+
+    Step(target);
+
+    if (jump && target % MachineCheckpointSpacing != 0)
+    {
+        auto found = std::find_if(mRecent.begin(), mRecent.end(),
+                [target](const auto &checkpoint) { return checkpoint->GetFrame() == target; });
+
+        auto checkpoint = found != mRecent.end() ? *found : mCheckpoints->SaveCheckpoint();
+        if (found != mRecent.end())
+        {
+            mRecent.erase(found);
+        }
+
+        mRecent.push_front(checkpoint);
+        if ((int)mRecent.size() > MachineRecentCheckpoints)
+        {
+            mRecent.pop_back();
+        }
+    }
+}
+
+/**
+ * Find the checkpoint nearest to a frame at or before it
+ * @param frame Frame to look for
+ * @return Checkpoint or nullptr if there is none
+ */
+std::shared_ptr<MachineCheckpoint> MachineStateCache::Nearest(int frame) const
+{
+    std::shared_ptr<MachineCheckpoint> nearest;
+
+    auto spaced = mSpaced.upper_bound(frame);
+    if (spaced != mSpaced.begin())
+    {
+        nearest = std::prev(spaced)->second;
+    }
+
+    for (const auto &checkpoint : mRecent)
+    {
+        if (checkpoint->GetFrame() <= frame &&
+            (nearest == nullptr || checkpoint->GetFrame() > nearest->GetFrame()))
+        {
+            nearest = checkpoint;
+        }
+    }
+
+    return nearest;
+}
+
+/**
+ * Put the machine back to a checkpoint
+ * @param checkpoint Checkpoint to restore
+ */
+void MachineStateCache::Restore(const std::shared_ptr<MachineCheckpoint> &checkpoint)
+{
+    if (mCheckpoints->RestoreCheckpoint(checkpoint))
+    {
+        mFrame = checkpoint->GetFrame();
+    }
+}
+
+/**
+ * Step the machine forward to a frame, taking the evenly
+ * spaced checkpoints it passes that are not held yet
+ * @param frame Frame to step to
+ */
+void MachineStateCache::Step(int frame)
+{
+    if (frame <= mFrame)
+    {
+        // No checkpoint to resume from, so the machine system replays from the start
+        mLastSteps = frame < mFrame ? frame : 0;
+        mSystem->SetMachineFrame(frame);
+        mFrame = frame;
+        return;
+    }
+
+    while (mFrame < frame)
+    {
+        int next = std::min(frame, (mFrame / MachineCheckpointSpacing + 1) * MachineCheckpointSpacing);
+        mSystem->SetMachineFrame(next);
+        mLastSteps += next - mFrame;
+        mFrame = next;
+
+        if (mFrame % MachineCheckpointSpacing == 0 && !mSpaced.contains(mFrame))
+        {
+            mSpaced[mFrame] = mCheckpoints->SaveCheckpoint();
+        }
+    }
+}
@@ -0,0 +1,100 @@
+/**
+ * @file MachineStateCache.h
+ * @author Shawn_Porto
+ *
+ * Checkpoints of a machine system that let it be set to earlier frames without replaying from frame 0
+ */
+
+#ifndef CANADIANEXPERIENCE_MACHINESTATECACHE_H
+#define CANADIANEXPERIENCE_MACHINESTATECACHE_H
+
+#include <deque>
+#include <map>
+
+class IMachineSystem;
+class IMachineCheckpoint;
+class IMachineStatistics;
+class MachineCheckpoint;
+
+/// Frames between the evenly spaced checkpoints
+const int MachineCheckpointSpacing = 100;
+
+/// Number of checkpoints kept at recently visited frames
+const int MachineRecentCheckpoints = 8;
+
+/**
+ * Checkpoints of a machine system that let it be set to
+ * earlier frames without replaying from frame 0.
+ *
+ * A machine system can only step forward, so a step back
+ * replays the whole simulation from the start. This keeps a
+ * checkpoint every MachineCheckpointSpacing frames as the
+ * machine passes them and a few more at frames that were
+ * jumped to, such as while scrubbing. Setting a frame resumes
+ * from the nearest checkpoint at or before it, so no frame
+ * costs more than MachineCheckpointSpacing steps once the
+ * machine has been there.
+ *
+ * Machine systems that do not implement IMachineCheckpoint
+ * are simply set to the frame.
+ */
+class MachineStateCache {
+private:
+    /// The machine system
+    std::shared_ptr<IMachineSystem> mSystem;
+
+    /// The machine system's checkpoint interface or nullptr if it has none
+    std::shared_ptr<IMachineCheckpoint> mCheckpoints;
+
+    /// The machine system's statistics interface or nullptr if it has none
+    std::shared_ptr<IMachineStatistics> mStatistics;
+
+    /// Machine number the checkpoints were taken of
+    int mMachineNumber = 0;
+
+    /// Frame rate the checkpoints were taken at
+    double mFrameRate = 0;
+
+    /// Frame the machine is at, -1 if not known
+    int mFrame = -1;
+
+    /// Checkpoints every MachineCheckpointSpacing frames
+    std::map<int, std::shared_ptr<MachineCheckpoint>> mSpaced;
+
+    /// Checkpoints at recently visited frames, most recent first
+    std::deque<std::shared_ptr<MachineCheckpoint>> mRecent;
+
+    /// Number of frames simulated to reach the last frame set
+    int mLastSteps = 0;
+
+    std::shared_ptr<MachineCheckpoint> Nearest(int frame) const;
+    void Restore(const std::shared_ptr<MachineCheckpoint> &checkpoint);
+    void Step(int frame);
+
+public:
+    MachineStateCache() {}
+
+    /** Copy constructor disabled */
+    MachineStateCache(const MachineStateCache &) = delete;
+    /** Assignment operator disabled */
+    void operator=(const MachineStateCache &) = delete;
+
+    void SetSystem(std::shared_ptr<IMachineSystem> system);
+    void SetFrameRate(double rate);
+    void SetMachineFrame(int frame);
+    void Clear();
+
+    /**
+     * Get the number of checkpoints held
+     * @return Number of checkpoints
+     */
+    int GetNumCheckpoints() const { return (int)(mSpaced.size() + mRecent.size()); }
+
+    /**
+     * Get the number of frames simulated by the last SetMachineFrame
+     * @return Number of frames
+     */
+    int GetLastSteps() const { return mLastSteps; }
+};
+
+#endif //CANADIANEXPERIENCE_MACHINESTATECACHE_H
@@ -13,10 +13,14 @@
 #include "ViewTimeline.h"
 #include "Picture.h"
 #include "PictureFactory.h"
+#include "Trace.h"
 
 /// Directory within resources that contains the images.
 const std::wstring ImagesDirectory = L"/images";
 
+/// Environment variable that turns on trace recording at startup
+const std::wstring TraceEnvironmentVariable = L"CANADIAN_EXPERIENCE_TRACE";
+
 
 /**
  * Constructor
@@ -56,6 +60,16 @@ void MainFrame::Initialize()
     Bind(wxEVT_COMMAND_MENU_SELECTED, &MainFrame::OnExit, this, wxID_EXIT);
     Bind(wxEVT_COMMAND_MENU_SELECTED, &MainFrame::OnAbout, this, wxID_ABOUT);
     Bind(wxEVT_CLOSE_WINDOW, &MainFrame::OnClose, this);
+    Bind(wxEVT_COMMAND_MENU_SELECTED, &MainFrame::OnRecordTrace, this, XRCID("PlayRecordTrace"));
+    Bind(wxEVT_UPDATE_UI, &MainFrame::OnUpdateRecordTrace, this, XRCID("PlayRecordTrace"));
+    Bind(wxEVT_COMMAND_MENU_SELECTED, &MainFrame::OnSaveTrace, this, XRCID("PlaySaveTrace"));
+    Bind(wxEVT_COMMAND_MENU_SELECTED, &MainFrame::OnPrerender, this, XRCID("PlayPrerender"));
+    Bind(wxEVT_UPDATE_UI, &MainFrame::OnUpdatePrerender, this, XRCID("PlayPrerender"));
+
+    if (wxGetEnv(TraceEnvironmentVariable, nullptr))
+    {
+        Tracer::SetEnabled(true);
+    }
 
     //
     // Create the picture
@@ -91,6 +105,65 @@ void MainFrame::OnAbout(wxCommandEvent& event)
 }
 
 
+/**
+ * Handle a Play>Record Trace menu option
+ * @param event The menu event
+ */
+void MainFrame::OnRecordTrace(wxCommandEvent& event)
+{
+    Tracer::SetEnabled(!Tracer::IsEnabled());
+}
+
+/**
+ * Update the user interface for Play>Record Trace
+ * @param event The event we update
+ */
+void MainFrame::OnUpdateRecordTrace(wxUpdateUIEvent& event)
+{
+    event.Check(Tracer::IsEnabled());
+}
+
+/**
+ * Handle a Play>Save Trace... menu option
+ * @param event The menu event
+ */
+void MainFrame::OnSaveTrace(wxCommandEvent& event)
+{
+    wxFileDialog saveFileDialog(this, _("Save Trace file"), "", "",
+            "Chrome Trace Files (*.json)|*.json", wxFD_SAVE|wxFD_OVERWRITE_PROMPT);
+    if (saveFileDialog.ShowModal() == wxID_CANCEL)
+    {
+        return;
+    }
+
+    if (!Tracer::Get().Save(saveFileDialog.GetPath().ToStdWstring()))
+    {
+        wxMessageBox(L"Unable to save trace file");
+    }
+}
+
+
+/**
+ * Handle a Play>Prerender Frames menu option
+ * @param event The menu event
+ */
+void MainFrame::OnPrerender(wxCommandEvent& event)
+{
+    auto prerenderer = mPicture->GetPrerenderer();
+    prerenderer->Stop();
+    prerenderer->SetEnabled(!prerenderer->IsEnabled());
+}
+
+/**
+ * Update the user interface for Play>Prerender Frames
+ * @param event The event we update
+ */
+void MainFrame::OnUpdatePrerender(wxUpdateUIEvent& event)
+{
+    event.Check(mPicture != nullptr && mPicture->GetPrerenderer()->IsEnabled());
+}
+
+
 /**
  * Handle a close event. Stop the animation and destroy this window.
  * @param event The Close event
@@ -26,6 +26,11 @@ private:
     void OnExit(wxCommandEvent& event);
     void OnAbout(wxCommandEvent&);
     void OnClose(wxCloseEvent &event);
+    void OnRecordTrace(wxCommandEvent& event);
+    void OnUpdateRecordTrace(wxUpdateUIEvent& event);
+    void OnSaveTrace(wxCommandEvent& event);
+    void OnPrerender(wxCommandEvent& event);
+    void OnUpdatePrerender(wxUpdateUIEvent& event);
 
     /// The resources directory to use
     std::wstring mResourcesDir;
@@ -0,0 +1,128 @@
+/**
+ * @file MappedFile.cpp
+ * @author Shawn_Porto
+ */
+
+#include "pch.h"
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Destructor
+ */
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+/**
+ * Map a file into memory
+ * @param filename File to map
+ * @return true if successful
+ */
+bool MappedFile::Open(const std::wstring &filename)
+{
+    Close();
+
+#ifdef _WIN32
+    mFile = CreateFileW(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (mFile == INVALID_HANDLE_VALUE)
+    {
+        mFile = nullptr;
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(mFile, &size) || size.QuadPart == 0)
+    {
+        Close();
+        return false;
+    }
+
+    mMapping = CreateFileMappingW(mFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mMapping == nullptr)
+    {
+        Close();
+        return false;
+    }
+
+    mData = (const char *)MapViewOfFile(mMapping, FILE_MAP_READ, 0, 0, 0);
+    if (mData == nullptr)
+    {
+        Close();
+        return false;
+    }
+
+    mSize = (size_t)size.QuadPart;
+#else
+    int fd = open(wxString(filename).fn_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    void *data = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    // The mapping stays valid after the descriptor is closed
+    close(fd);
+
+    if (data == MAP_FAILED)
+    {
+        return false;
+    }
+
+    mData = (const char *)data;
+    mSize = (size_t)info.st_size;
+#endif
+
+    return true;
+}
+
+/**
+ * Release the mapping
+ */
+void MappedFile::Close()
+{
+#ifdef _WIN32
+    if (mData != nullptr)
+    {
+        UnmapViewOfFile(mData);
+    }
+
+    if (mMapping != nullptr)
+    {
+        CloseHandle(mMapping);
+        mMapping = nullptr;
+    }
+
+    if (mFile != nullptr)
+    {
+        CloseHandle(mFile);
+        mFile = nullptr;
+    }
+#else
+    if (mData != nullptr)
+    {
+        munmap((void *)mData, mSize);
+    }
+#endif
+
+    mData = nullptr;
+    mSize = 0;
+}
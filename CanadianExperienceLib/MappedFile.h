@@ -0,0 +1,63 @@
+/**
+ * @file MappedFile.h
+ * @author Shawn_Porto
+ *
+ * A read only file mapped into memory.
+ */
+
+#ifndef CANADIANEXPERIENCE_MAPPEDFILE_H
+#define CANADIANEXPERIENCE_MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+
+/**
+ * A read only file mapped into memory.
+ *
+ * The pages are only read in by the operating system as they
+ * are touched, so nothing is copied or parsed when the file
+ * is opened. The mapping is released when the object is destroyed.
+ */
+class MappedFile {
+private:
+    /// Start of the mapped file, or nullptr if not open
+    const char *mData = nullptr;
+
+    /// Size of the file in bytes
+    size_t mSize = 0;
+
+#ifdef _WIN32
+    /// File handle
+    void *mFile = nullptr;
+
+    /// File mapping handle
+    void *mMapping = nullptr;
+#endif
+
+public:
+    MappedFile() {}
+    ~MappedFile();
+
+    /** Copy constructor disabled */
+    MappedFile(const MappedFile &) = delete;
+
+    /** Assignment operator disabled */
+    void operator=(const MappedFile &) = delete;
+
+    bool Open(const std::wstring &filename);
+    void Close();
+
+    /**
+     * Get the contents of the file
+     * @return Pointer to the first byte or nullptr if not open
+     */
+    const char *GetData() const { return mData; }
+
+    /**
+     * Get the size of the file
+     * @return Size in bytes
+     */
+    size_t GetSize() const { return mSize; }
+};
+
+#endif //CANADIANEXPERIENCE_MAPPEDFILE_H
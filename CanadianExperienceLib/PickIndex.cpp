@@ -0,0 +1,223 @@
+/**
+ * @file PickIndex.cpp
+ * @author Shawn_Porto
+ */
+
+#include "pch.h"
+
+#include <algorithm>
+
+#include "PickIndex.h"
+#include "Actor.h"
+#include "Drawable.h"
+
+/**
+ * Grid cell a coordinate falls in, rounding down for negative values
+ * @param v Coordinate in pixels
+ * @return Cell coordinate
+ */
+static int CellOf(int v)
+{
+    return v >= 0 ? v / PickCellSize : -((-v - 1) / PickCellSize) - 1;
+}
+
+/**
+ * Key for a grid cell
+ * @param cx Cell column
+ * @param cy Cell row
+ * @return Key into the cell map
+ */
+static int64_t CellKey(int cx, int cy)
+{
+    return ((int64_t)cx << 32) | (uint32_t)cy;
+}
+
+/**
+ * Add the drawables of an actor to the index.
+ *
+ * Actors have to be added in drawing order.
+ * @param actor Actor to add
+ */
+void PickIndex::AddActor(std::shared_ptr<Actor> actor)
+{
+    mActorEntries.push_back((int)mEntries.size());
+    for (auto &drawable : actor->GetDrawables())
+    {
+        int entry = (int)mEntries.size();
+        mEntries.push_back({actor, drawable});
+        drawable->SetPickIndex(this, entry);
+        Moved(entry);
+    }
+}
+
+/**
+ * Indicate a drawable has been placed somewhere new
+ * @param entry The drawable's entry
+ */
+void PickIndex::Moved(int entry)
+{
+    if (!mEntries[entry].moved)
+    {
+        mEntries[entry].moved = true;
+        if (!mDeferMoved)
+        {
+            mMoved.push_back(entry);
+        }
+    }
+}
+
+/**
+ * Choose whether entries that move are only marked.
+ *
+ * While deferred, Moved() touches nothing but the entry
+ * itself, so drawables of different actors can be placed
+ * on different threads. The actors that were placed
+ * somewhere new then have to be given to ActorMoved(),
+ * which lists their marked entries.
+ * @param defer true to only mark the entries that move
+ */
+void PickIndex::SetDeferMoved(bool defer)
+{
+    mDeferMoved = defer;
+}
+
+/**
+ * List the entries of an actor that were marked as moved
+ * while moves were deferred.
+ * @param actor Index of the actor, in the order the actors were added
+ */
+void PickIndex::ActorMoved(int actor)
+{
+    int end = actor + 1 < (int)mActorEntries.size() ? mActorEntries[actor + 1] : (int)mEntries.size();
+    for (int entry = mActorEntries[actor]; entry < end; entry++)
+    {
+        if (mEntries[entry].moved)
+        {
+            mMoved.push_back(entry);
+        }
+    }
+}
+
+/**
+ * File the entries that moved under their new bounds
+ */
+void PickIndex::Update()
+{
+    for (auto entry : mMoved)
+    {
+        Unfile(entry);
+        File(entry);
+        mEntries[entry].moved = false;
+    }
+
+    mMoved.clear();
+}
+
+/**
+ * File an entry under the cells its bounds overlap
+ * @param entry Entry to file
+ */
+void PickIndex::File(int entry)
+{
+    auto &e = mEntries[entry];
+    e.bounds = e.drawable->GetBounds();
+    e.filed = true;
+
+    if (e.bounds.IsEmpty())
+    {
+        mUnbounded.insert(std::lower_bound(mUnbounded.begin(), mUnbounded.end(), entry), entry);
+        return;
+    }
+
+    int right = CellOf(e.bounds.GetLeft() + e.bounds.GetWidth() - 1);
+    int bottom = CellOf(e.bounds.GetTop() + e.bounds.GetHeight() - 1);
+    for (int cy = CellOf(e.bounds.GetTop()); cy <= bottom; cy++)
+    {
+        for (int cx = CellOf(e.bounds.GetLeft()); cx <= right; cx++)
+        {
+            mCells[CellKey(cx, cy)].push_back(entry);
+        }
+    }
+}
+
+/**
+ * Remove an entry from the cells it is filed under
+ * @param entry Entry to remove
+ */
+void PickIndex::Unfile(int entry)
+{
+    auto &e = mEntries[entry];
+    if (!e.filed)
+    {
+        return;
+    }
+
+    e.filed = false;
+
+    if (e.bounds.IsEmpty())
+    {
+        mUnbounded.erase(std::lower_bound(mUnbounded.begin(), mUnbounded.end(), entry));
+        return;
+    }
+
+    int right = CellOf(e.bounds.GetLeft() + e.bounds.GetWidth() - 1);
+    int bottom = CellOf(e.bounds.GetTop() + e.bounds.GetHeight() - 1);
+    for (int cy = CellOf(e.bounds.GetTop()); cy <= bottom; cy++)
+    {
+        for (int cx = CellOf(e.bounds.GetLeft()); cx <= right; cx++)
+        {
+            auto cell = mCells.find(CellKey(cx, cy));
+            auto &entries = cell->second;
+            entries.erase(std::find(entries.begin(), entries.end(), entry));
+            if (entries.empty())
+            {
+                mCells.erase(cell);
+            }
+        }
+    }
+}
+
+/**
+ * Find the topmost drawable at a point.
+ *
+ * The drawables have to be placed before this is called.
+ * @param pos Point in the drawing
+ * @param actor Set to the actor the drawable belongs to
+ * @return The drawable hit or nullptr if nothing was hit
+ */
+std::shared_ptr<Drawable> PickIndex::Pick(wxPoint pos, std::shared_ptr<Actor> &actor)
+{
+    Update();
+
+    mCandidates.clear();
+
+    auto cell = mCells.find(CellKey(CellOf(pos.x), CellOf(pos.y)));
+    if (cell != mCells.end())
+    {
+        for (auto entry : cell->second)
+        {
+            if (mEntries[entry].bounds.Contains(pos))
+            {
+                mCandidates.push_back(entry);
+            }
+        }
+    }
+
+    mCandidates.insert(mCandidates.end(), mUnbounded.begin(), mUnbounded.end());
+
+    // Last drawn is on top
+    std::sort(mCandidates.begin(), mCandidates.end(), std::greater<int>());
+
+    for (auto entry : mCandidates)
+    {
+        auto &e = mEntries[entry];
+        if (e.actor->IsEnabled() && e.actor->IsClickable() && e.drawable->HitTest(pos))
+        {
+            actor = e.actor;
+            return e.drawable;
+        }
+    }
+
+    actor = nullptr;
+    return nullptr;
+}
@@ -0,0 +1,100 @@
+/**
+ * @file PickIndex.h
+ * @author Shawn_Porto
+ *
+ * Uniform grid over the bounds of the drawables for picking.
+ */
+
+#ifndef CANADIANEXPERIENCE_PICKINDEX_H
+#define CANADIANEXPERIENCE_PICKINDEX_H
+
+#include <cstdint>
+#include <unordered_map>
+
+class Actor;
+class Drawable;
+
+/// Width and height of a pick index cell in pixels
+const int PickCellSize = 128;
+
+/**
+ * Uniform grid over the bounds of the drawables for picking.
+ *
+ * Every drawable of every actor in the picture has an entry,
+ * numbered in drawing order, filed under each grid cell its
+ * bounds overlap. Drawables tell the index when they are
+ * placed somewhere new and only those entries are filed again,
+ * so the cost of an update follows what moved, not the size
+ * of the picture.
+ * A pick only runs the precise hit test on the drawables whose
+ * bounds contain the point, topmost first. Drawables that do
+ * not know their bounds are always tested.
+ */
+class PickIndex {
+private:
+    /// One drawable in the index
+    struct Entry
+    {
+        /// The actor the drawable belongs to
+        std::shared_ptr<Actor> actor;
+
+        /// The drawable
+        std::shared_ptr<Drawable> drawable;
+
+        /// The bounds the entry is filed under
+        wxRect bounds;
+
+        /// True if the drawable moved since it was filed
+        bool moved = false;
+
+        /// True if the entry is filed in the grid
+        bool filed = false;
+    };
+
+    /// The entries in drawing order
+    std::vector<Entry> mEntries;
+
+    /// First entry of each actor, in the order the actors were added
+    std::vector<int> mActorEntries;
+
+    /// The grid cells, each a list of entries
+    std::unordered_map<int64_t, std::vector<int>> mCells;
+
+    /// Entries without bounds, in drawing order
+    std::vector<int> mUnbounded;
+
+    /// Entries that moved since the last update
+    std::vector<int> mMoved;
+
+    /// Candidates for a pick, kept to avoid allocating
+    std::vector<int> mCandidates;
+
+    /// True while entries that move are only marked
+    bool mDeferMoved = false;
+
+    void Update();
+    void File(int entry);
+    void Unfile(int entry);
+
+public:
+    PickIndex() {}
+
+    /** Copy constructor disabled */
+    PickIndex(const PickIndex &) = delete;
+    /** Assignment operator disabled */
+    void operator=(const PickIndex &) = delete;
+
+    void AddActor(std::shared_ptr<Actor> actor);
+    void Moved(int entry);
+    void SetDeferMoved(bool defer);
+    void ActorMoved(int actor);
+    std::shared_ptr<Drawable> Pick(wxPoint pos, std::shared_ptr<Actor> &actor);
+
+    /**
+     * Get the number of entries in the index
+     * @return Number of drawables indexed
+     */
+    int GetNumEntries() const { return (int)mEntries.size(); }
+};
+
+#endif //CANADIANEXPERIENCE_PICKINDEX_H
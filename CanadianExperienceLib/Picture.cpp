@@ -4,18 +4,26 @@
  */
 #include "pch.h"
 #include <wx/stdpaths.h>
+#include <wx/filename.h>
 
 #include "Picture.h"
 #include "PictureObserver.h"
 #include "Actor.h"
 #include "AdapterMachineDrawable.h"
+#include "AnimBinary.h"
+#include "AnimXmlReader.h"
+#include "AnimXmlWriter.h"
+#include "Trace.h"
 
+/// Actors placed in each block on the thread pool
+const int ParallelActorGrain = 16;
 
 /**
  * Constructor
 */
-Picture::Picture()
+Picture::Picture() : mPrerenderer(this)
 {
+    mTimeline.SetThreadPool(&mThreadPool);
 }
 
 
@@ -28,13 +36,93 @@ Picture::Picture()
  */
 void Picture::SetAnimationTime(double time)
 {
+    TraceSpan span("Picture::SetAnimationTime");
+
+    // Actors are placed in blocks on the thread pool. Each actor
+    // only touches its own drawables and its own slots here, and
+    // the pick index just marks what moved until the join.
+    int numActors = (int)mActors.size();
+    mBoundsBefore.resize(numActors);
+    mBoundsAfter.resize(numActors);
+    mMoved.resize(numActors);
+    mPickIndex.SetDeferMoved(true);
+
+    // The timeline evaluates the channels on the thread pool and pushes
+    // the ones that changed to their actors and drawables
     mTimeline.SetCurrentTime(time);
-    UpdateObservers();
 
-    for (auto actor : mActors)
+    // Until they are placed again, the actors still have the
+    // bounds of where they were drawn, and only the actors
+    // placed somewhere new compute their bounds again
+    mThreadPool.ParallelFor(numActors, ParallelActorGrain, [this](int first, int end) {
+        for (int i = first; i < end; i++)
+        {
+            auto &actor = mActors[i];
+            mBoundsBefore[i] = actor->GetPlacedBounds();
+            mMoved[i] = actor->Place();
+            mBoundsAfter[i] = mMoved[i] ? actor->GetPlacedBounds() : mBoundsBefore[i];
+        }
+    });
+
+    mPickIndex.SetDeferMoved(false);
+
+    // Only actors that were placed again changed, and only
+    // their drawables are filed again in the pick index
+    int changes = ChangeTime;
+    wxRect region;
+    bool whole = false;
+    for (int i = 0; i < numActors; i++)
+    {
+        bool moved = mMoved[i] != 0;
+        if (moved)
+        {
+            mPickIndex.ActorMoved(i);
+        }
+
+        if (whole)
+        {
+            continue;
+        }
+
+        auto before = mBoundsBefore[i];
+        auto after = mBoundsAfter[i];
+        if (before.IsEmpty() || after.IsEmpty())
+        {
+            // Something we can't bound may have
+            // changed, so all of it is repainted
+            changes |= ChangeGeometry;
+            region = wxRect();
+            whole = true;
+            continue;
+        }
+
+        // A machine runs in place, so where it is is
+        // repainted every frame even when it did not move
+        if (moved || mActors[i]->ChangesWithTime())
+        {
+            changes |= ChangeGeometry;
+            region.Union(ChangedRegion(before, after));
+        }
+    }
+
+    UpdateObservers(changes, region);
+}
+
+/**
+ * The region to repaint when something moves
+ * @param before Bounds before the change
+ * @param after Bounds after the change
+ * @return Region covering both, empty if either is not known
+ */
+wxRect Picture::ChangedRegion(const wxRect &before, const wxRect &after)
+{
+    if (before.IsEmpty() || after.IsEmpty())
     {
-        actor->GetKeyframe();
+        return wxRect();
     }
+
+    // Antialiased edges can reach just past the bounds
+    return wxRect(before).Union(after).Inflate(ChangedRegionMargin);
 }
 
 /**
@@ -70,25 +158,77 @@ void Picture::RemoveObserver(PictureObserver* observer)
 
 /**
  * Advance all observers to indicate the picture has changed.
+ *
+ * Only observers subscribed to one of the changes are told.
+ * @param changes Mask of the PictureChange values that changed
+ * @param region Part of the picture affected, empty if not known
  */
-void Picture::UpdateObservers()
+void Picture::UpdateObservers(int changes, const wxRect &region)
 {
     for (auto observer : mObservers)
     {
-        observer->UpdateObserver();
+        if (observer->GetSubscriptions() & changes)
+        {
+            observer->OnPictureChanged(changes, region);
+        }
     }
 }
 
 /**
  * Draw this picture on a device context
  * @param graphics The device context to draw on
+ * @param viewport Part of the picture that is visible, empty to draw everything
+ */
+void Picture::Draw(std::shared_ptr<wxGraphicsContext> graphics, const wxRect &viewport)
+{
+    for (auto &actor : mActors)
+    {
+        actor->Draw(graphics, viewport);
+    }
+}
+
+/**
+ * Draw the whole picture on a white background into an image.
+ *
+ * This uses a graphics context on a wxImage, so it needs
+ * no window or display and can run on any thread that
+ * owns the picture.
+ * @param scale Resolution of the image relative to the picture size
+ * @return The rendered image
+ */
+wxImage Picture::RenderImage(double scale)
+{
+    int width = std::max(1, (int)(mSize.GetWidth() * scale));
+    int height = std::max(1, (int)(mSize.GetHeight() * scale));
+
+    wxImage image(width, height);
+    image.SetRGB(wxRect(0, 0, width, height), 255, 255, 255);
+
+    {
+        // The image is updated when the context is destroyed
+        auto graphics = std::shared_ptr<wxGraphicsContext>(wxGraphicsContext::Create(image));
+        graphics->Scale(scale, scale);
+        Draw(graphics);
+    }
+
+    return image;
+}
+
+/**
+ * Find the topmost drawable at a point in the picture.
+ * @param pos Point to test
+ * @param hitActor Set to the actor the drawable hit belongs to
+ * @return Drawable hit or nullptr if nothing was hit
  */
-void Picture::Draw(std::shared_ptr<wxGraphicsContext> graphics)
+std::shared_ptr<Drawable> Picture::HitTest(wxPoint pos, std::shared_ptr<Actor> &hitActor)
 {
-    for (auto actor : mActors)
+    // Bring the bounds of anything that moved up to date
+    for (auto &actor : mActors)
     {
-        actor->Draw(graphics);
+        actor->Place();
     }
+
+    return mPickIndex.Pick(pos, hitActor);
 }
 
 /**
@@ -99,6 +239,7 @@ void Picture::AddActor(std::shared_ptr<Actor> actor)
 {
     mActors.push_back(actor);
     actor->SetPicture(this);
+    mPickIndex.AddActor(actor);
 }
 
 /**
@@ -108,9 +249,25 @@ void Picture::AddActor(std::shared_ptr<Actor> actor)
 void Picture::AddMachineAdapter(std::shared_ptr<AdapterMachineDrawable> machineAdapter)
 {
     machineAdapter->SetTimeline(GetTimeline());
+    machineAdapter->SetSoundHandler(mSoundHandler);
     mMachineAdapters.push_back(machineAdapter);
 }
 
+/**
+ * Give the sounds of all machines to a handler instead of playing them.
+ *
+ * The handler runs on whatever thread evaluates the machines.
+ * @param handler Handler for the sounds, or an empty handler to play them again
+ */
+void Picture::SetMachineSoundHandler(const IMachineAudio::SoundHandler &handler)
+{
+    mSoundHandler = handler;
+    for (auto adapter : mMachineAdapters)
+    {
+        adapter->SetSoundHandler(handler);
+    }
+}
+
 /**
  * Gets the machine adapter that is assigned to this number
  * @param machineNumber the machine number you want to access
@@ -129,33 +286,56 @@ std::shared_ptr<AdapterMachineDrawable> Picture::GetMachineAdapter(int machineNu
 
 /**
 * Save the picture animation to a file
+*
+* Files with the .animb extension are saved in the binary
+* format, anything else as XML.
 * @param filename File to save to.
 */
 void Picture::Save(const wxString& filename)
 {
-    wxXmlDocument xmlDoc;
+    if (wxFileName(filename).GetExt() == AnimBinaryExtension)
+    {
+        AnimBinary binary;
+        for (auto adapter : mMachineAdapters)
+        {
+            binary.AddMachine(adapter->GetFrameStart(), adapter->GetMachineNumber());
+        }
+
+        if (!binary.Save(filename.ToStdWstring(), &mTimeline))
+        {
+            wxMessageBox(L"Write to binary animation failed");
+        }
+        return;
+    }
+
+    // The XML is streamed straight to the file
+    AnimXmlWriter writer;
+    if (!writer.Open(filename.ToStdWstring()))
+    {
+        wxMessageBox(L"Write to XML failed");
+        return;
+    }
 
-    auto root = new wxXmlNode(wxXML_ELEMENT_NODE, L"anim");
-    xmlDoc.SetRoot(root);
+    wxXmlNode root(wxXML_ELEMENT_NODE, L"anim");
+    mTimeline.XmlSaveAttributes(&root);
+    writer.StartElement(&root);
 
     // Save the timeline animation into the XML
-    mTimeline.Save(root);
+    mTimeline.Save(&writer);
 
-    //
-    // It is possible to add attributes to the root node here
-    //
-    //root->AddAttribute(L"something", mSomething);
-    auto machinesNode = new wxXmlNode(wxXML_ELEMENT_NODE, L"machines");
+    wxXmlNode machinesNode(wxXML_ELEMENT_NODE, L"machines");
+    writer.StartElement(&machinesNode);
     for (int i = 0; i < mMachineAdapters.size(); i++)
     {
-        auto machineNode = new wxXmlNode(wxXML_ELEMENT_NODE, L"machine" + std::to_wstring(i));
-        machineNode->AddAttribute(L"frameStart", std::to_wstring(mMachineAdapters[i]->GetFrameStart()));
-        machineNode->AddAttribute(L"machineNumber", std::to_wstring(mMachineAdapters[i]->GetMachineNumber()));
-        machinesNode->AddChild(machineNode);
+        wxXmlNode machineNode(wxXML_ELEMENT_NODE, L"machine" + std::to_wstring(i));
+        machineNode.AddAttribute(L"frameStart", std::to_wstring(mMachineAdapters[i]->GetFrameStart()));
+        machineNode.AddAttribute(L"machineNumber", std::to_wstring(mMachineAdapters[i]->GetMachineNumber()));
+        writer.WriteElement(&machineNode);
     }
-    root->AddChild(machinesNode);
+    writer.EndElement();
 
-    if(!xmlDoc.Save(filename, wxXML_NO_INDENTATION))
+    writer.EndElement();
+    if(!writer.Close())
     {
         wxMessageBox(L"Write to XML failed");
         return;
@@ -166,45 +346,107 @@ void Picture::Save(const wxString& filename)
 
 /**
 * Load a picture animation from a file
+*
+* Binary animation files are recognized by their
+* contents, anything else is loaded as XML. A file
+* that cannot be loaded leaves the animation and the
+* machines as they were. Nothing is shown to the user,
+* so this also works without a display.
 * @param filename file to load from
+* @return false if the file could not be loaded
 */
-void Picture::Load(const wxString& filename)
+bool Picture::Load(const wxString& filename)
 {
-    wxXmlDocument xmlDoc;
-    if(!xmlDoc.Load(filename))
+    if (AnimBinary::IsBinaryFile(filename.ToStdWstring()))
     {
-        wxMessageBox(L"Unable to load Animation file");
-        return;
+        AnimBinary binary;
+        if (!binary.Load(filename.ToStdWstring(), &mTimeline))
+        {
+            return false;
+        }
+
+        auto &machines = binary.GetMachines();
+        for (int i = 0; i < mMachineAdapters.size() && i < machines.size(); i++)
+        {
+            mMachineAdapters[i]->SetFrameStart(machines[i].mFrameStart);
+            mMachineAdapters[i]->SetMachineNumberInt(machines[i].mMachineNumber);
+        }
+
+        SetAnimationTime(0);
+        UpdateObservers();
+        return true;
+    }
+
+    // The whole file is parsed once without changing anything,
+    // so a truncated or malformed file is found before the
+    // current animation is cleared
+    bool isAnimation = false;
+    {
+        AnimXmlReader reader;
+        bool ok = reader.Parse(filename.ToStdWstring(), [&isAnimation](wxXmlNode *element, int depth) {
+            if (depth == 0)
+            {
+                isAnimation = element->GetName() == L"anim";
+            }
+        });
+
+        if (!ok || !isAnimation)
+        {
+            return false;
+        }
     }
 
-    // Get the XML document root node
-    auto root = xmlDoc.GetRoot();
+    // Then it is streamed in again, handing each element
+    // to the timeline as soon as it has been read
+    isAnimation = false;
+    bool inMachines = false;
+    int machine = 0;
+
+    AnimXmlReader reader;
+    bool ok = reader.Parse(filename.ToStdWstring(), [&](wxXmlNode *element, int depth) {
+        if (depth == 0)
+        {
+            isAnimation = element->GetName() == L"anim";
+            if (isAnimation)
+            {
+                mTimeline.XmlStartLoad(element);
+            }
+        }
+        else if (isAnimation)
+        {
+            if (depth == 1)
+            {
+                inMachines = element->GetName() == L"machines";
+            }
 
-    // Load the animation from the XML
-    mTimeline.Load(root);
+            if (inMachines && depth == 2 && machine < mMachineAdapters.size())
+            {
+                int frameStart;
+                int machineNumber;
+                element->GetAttribute(L"frameStart", L"0").ToInt(&frameStart);
+                element->GetAttribute(L"machineNumber", L"1").ToInt(&machineNumber);
+                mMachineAdapters[machine]->SetFrameStart(frameStart);
+                mMachineAdapters[machine]->SetMachineNumberInt(machineNumber);
+                machine++;
+            }
+            else
+            {
+                mTimeline.XmlLoadElement(element, depth);
+            }
+        }
+    });
 
-    //
-    // It is possible to load attributes from the root node here
-    //
-    // mSomething = root->GetAttribute(L"something", L"default");
-    auto child = root->GetChildren();
-    for (; child; child = child->GetNext())
+    if (isAnimation)
     {
-        if (child->GetName() == L"machines")
-            break;
+        mTimeline.XmlEndLoad();
     }
-    auto machineNode = child->GetChildren();
-    for (int i = 0; i < mMachineAdapters.size(); i++)
+
+    if(!ok || !isAnimation)
     {
-        int frameStart;
-        int machineNumber;
-        machineNode->GetAttribute(L"frameStart", L"0").ToInt(&frameStart);
-        machineNode->GetAttribute(L"machineNumber", L"1").ToInt(&machineNumber);
-        mMachineAdapters[i]->SetFrameStart(frameStart);
-        mMachineAdapters[i]->SetMachineNumberInt(machineNumber);
-        machineNode = machineNode->GetNext();
+        return false;
     }
 
     SetAnimationTime(0);
     UpdateObservers();
+    return true;
 }
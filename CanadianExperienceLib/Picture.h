@@ -9,10 +9,19 @@
 #pragma once
 
 #include "Timeline.h"
+#include "TextureAtlas.h"
+#include "PickIndex.h"
+#include "PictureObserver.h"
+#include "FramePrerenderer.h"
+#include "ThreadPool.h"
+#include "../MachineLib/IMachineAudio.h"
+
+/// Margin added around a changed region for antialiased edges
+const int ChangedRegionMargin = 1;
 
 class AdapterMachineDrawable;
-class PictureObserver;
 class Actor;
+class Drawable;
 
 /**
  *  Class that represents our animation picture
@@ -32,9 +41,36 @@ private:
     /// The Machine Adapters stored here
     std::vector<std::shared_ptr<AdapterMachineDrawable>> mMachineAdapters;
 
+    /// Handler for the sounds of the machines, empty to play them
+    IMachineAudio::SoundHandler mSoundHandler;
+
+    /// Threads the animation is evaluated on, declared
+    /// before the timeline that uses it
+    ThreadPool mThreadPool;
+
     /// The animation timeline
     Timeline mTimeline;
 
+    /// The atlas the actor images are drawn from
+    TextureAtlas mAtlas;
+
+    /// Index of the drawables for picking
+    PickIndex mPickIndex;
+
+    /// Bounds of the actors before a time change, kept to avoid allocating
+    std::vector<wxRect> mBoundsBefore;
+
+    /// Bounds of the actors after a time change, kept to avoid allocating
+    std::vector<wxRect> mBoundsAfter;
+
+    /// Which actors were placed somewhere new by a time change, one char
+    /// each so different threads can write neighbouring actors
+    std::vector<char> mMoved;
+
+    /// Renders frames ahead during playback. Declared last so
+    /// its worker stops before anything it draws is destroyed.
+    FramePrerenderer mPrerenderer;
+
 public:
     Picture();
 
@@ -66,16 +102,46 @@ public:
      */
     Timeline *GetTimeline() {return &mTimeline;}
 
+    /**
+     * Get a pointer to the texture atlas
+     * @return Pointer to the TextureAtlas object
+     */
+    TextureAtlas *GetAtlas() {return &mAtlas;}
+
+    /**
+     * Get the frame prerenderer used during playback
+     * @return Pointer to the FramePrerenderer object
+     */
+    FramePrerenderer *GetPrerenderer() {return &mPrerenderer;}
+
+    /**
+     * Get the threads the animation is evaluated on
+     * @return Pointer to the thread pool
+     */
+    ThreadPool *GetThreadPool() {return &mThreadPool;}
+
     void AddObserver(PictureObserver *observer);
     void RemoveObserver(PictureObserver *observer);
-    void UpdateObservers();
-    void Draw(std::shared_ptr<wxGraphicsContext> graphics);
+    void UpdateObservers(int changes = ChangeAll, const wxRect &region = wxRect());
+    void Draw(std::shared_ptr<wxGraphicsContext> graphics, const wxRect &viewport = wxRect());
+    wxImage RenderImage(double scale = 1);
+    std::shared_ptr<Drawable> HitTest(wxPoint pos, std::shared_ptr<Actor> &hitActor);
+
+    static wxRect ChangedRegion(const wxRect &before, const wxRect &after);
 
     void AddActor(std::shared_ptr<Actor> actor);
 
     void AddMachineAdapter(std::shared_ptr<AdapterMachineDrawable> machineAdapter);
     std::shared_ptr<AdapterMachineDrawable> GetMachineAdapter(int machineNumber);
 
+    void SetMachineSoundHandler(const IMachineAudio::SoundHandler &handler);
+
+    /**
+     * Get the handler the machines give their sounds to
+     * @return Handler, empty if the machines play their sounds
+     */
+    const IMachineAudio::SoundHandler &GetMachineSoundHandler() const {return mSoundHandler;}
+
     /** Iterator that iterates over the actors in a picture */
     class ActorIter
     {
@@ -133,7 +199,7 @@ public:
 
     double GetAnimationTime();
 
-    void Load(const wxString& filename);
+    bool Load(const wxString& filename);
 
     void Save(const wxString& filename);
 };
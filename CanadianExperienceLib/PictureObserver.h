@@ -9,6 +9,20 @@
 
 class Picture;
 
+/**
+ * Categories of changes to a picture. Observers are told
+ * about changes as a mask of these.
+ */
+enum PictureChange
+{
+    ChangeTime = 1,         ///< The current animation time
+    ChangeGeometry = 2,     ///< Positions or rotations in the picture
+    ChangeKeyframes = 4,    ///< Keyframes were set or removed
+    ChangeTimeline = 8,     ///< Timeline properties like the frame rate and length
+    ChangeMachines = 16,    ///< Machine numbers or start frames
+    ChangeAll = 31          ///< Anything may have changed
+};
+
 /**
  * Observer base class for a picture.
  *
@@ -20,10 +34,19 @@ private:
     /// Picture we are observing
     std::shared_ptr<Picture> mPicture;
 
+    /// The changes we want to be told about
+    int mSubscriptions = ChangeAll;
+
 protected:
     /// Constructor (protected)
     PictureObserver() {}
 
+    /**
+     * Choose which changes we are told about
+     * @param changes Mask of PictureChange values
+     */
+    void Subscribe(int changes) { mSubscriptions = changes; }
+
 public:
     /// Copy constructor (disabled)
     PictureObserver(const PictureObserver &) = delete;
@@ -36,6 +59,21 @@ public:
     /// This function is called to update any observers
     virtual void UpdateObserver() = 0;
 
+    /**
+     * Called when the picture changes in a way we subscribed to.
+     *
+     * The default just updates the observer.
+     * @param changes Mask of the PictureChange values that changed
+     * @param region Part of the picture affected, empty if not known
+     */
+    virtual void OnPictureChanged(int changes, const wxRect &region) { UpdateObserver(); }
+
+    /**
+     * Get the changes we want to be told about
+     * @return Mask of PictureChange values
+     */
+    int GetSubscriptions() const { return mSubscriptions; }
+
     virtual void SetPicture(std::shared_ptr<Picture> picture);
 
     /**
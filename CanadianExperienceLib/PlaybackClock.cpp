@@ -0,0 +1,99 @@
+/**
+ * @file PlaybackClock.cpp
+ * @author Shawn_Porto
+ */
+
+#include "pch.h"
+#include "PlaybackClock.h"
+
+#include <cmath>
+
+/// Tolerance for rounding when a time falls exactly on a frame
+const double PlaybackFrameEpsilon = 1e-9;
+
+/**
+ * Start playback
+ * @param startTime Animation time to start at in seconds
+ * @param frameRate Frames per second
+ */
+void PlaybackClock::Start(double startTime, int frameRate)
+{
+    mOrigin = Clock::now();
+    mStartTime = startTime;
+    mFrameRate = frameRate;
+    mFrame = -1;
+    mRunning = true;
+
+    mPresented = 0;
+    mDropped = 0;
+    mLate = 0;
+}
+
+/**
+ * Get the wall time since playback started
+ * @return Elapsed time in seconds
+ */
+double PlaybackClock::GetElapsed() const
+{
+    return std::chrono::duration<double>(Clock::now() - mOrigin).count();
+}
+
+/**
+ * Choose the frame to present.
+ *
+ * Any frames between the last one presented and this
+ * one are skipped and counted as dropped.
+ * @param elapsed Wall time since playback started in seconds
+ * @return Frame to present, or -1 if the last frame presented is still current
+ */
+int PlaybackClock::Tick(double elapsed)
+{
+    int frame = (int)std::floor((mStartTime + elapsed) * mFrameRate + PlaybackFrameEpsilon);
+    if (frame <= mFrame)
+    {
+        return -1;
+    }
+
+    if (mFrame >= 0)
+    {
+        mDropped += frame - mFrame - 1;
+    }
+
+    double due = std::max(0.0, (double)frame / mFrameRate - mStartTime);
+    if (elapsed - due > PlaybackLateFraction / mFrameRate)
+    {
+        mLate++;
+    }
+
+    mFrame = frame;
+    mPresented++;
+    return frame;
+}
+
+/**
+ * Count the frame from the last Tick as dropped,
+ * because it was not ready to be presented.
+ */
+void PlaybackClock::Drop()
+{
+    mPresented--;
+    mDropped++;
+}
+
+/**
+ * How long to wait before the next frame is due
+ * @param elapsed Wall time since playback started in seconds
+ * @return Milliseconds to wait, at least 1
+ */
+long PlaybackClock::NextDelay(double elapsed) const
+{
+    // A frame that is already due is presented right away
+    int current = (int)std::floor((mStartTime + elapsed) * mFrameRate + PlaybackFrameEpsilon);
+    if (current > mFrame)
+    {
+        return 1;
+    }
+
+    double due = (double)(mFrame + 1) / mFrameRate - mStartTime;
+    return std::max(1L, (long)std::ceil((due - elapsed) * 1000));
+}
@@ -0,0 +1,110 @@
+/**
+ * @file PlaybackClock.h
+ * @author Shawn_Porto
+ *
+ * Paces animation playback from a monotonic clock.
+ */
+
+#ifndef CANADIANEXPERIENCE_PLAYBACKCLOCK_H
+#define CANADIANEXPERIENCE_PLAYBACKCLOCK_H
+
+#include <chrono>
+
+/// Fraction of a frame period a frame can be presented
+/// after it was due before it counts as late
+const double PlaybackLateFraction = 0.5;
+
+/**
+ * Paces animation playback from a monotonic clock.
+ *
+ * The frame to present is chosen from the wall time since
+ * playback started, so timer jitter and slow paints never
+ * stretch the animation. Frames that came due while the
+ * previous one was being presented are skipped without
+ * being evaluated and counted as dropped. A frame presented
+ * more than PlaybackLateFraction of a period after it was
+ * due is counted as late.
+ */
+class PlaybackClock {
+public:
+    /// The clock playback is measured with
+    using Clock = std::chrono::steady_clock;
+
+private:
+    /// Wall time playback started
+    Clock::time_point mOrigin;
+
+    /// Animation time playback started at in seconds
+    double mStartTime = 0;
+
+    /// Frames per second
+    int mFrameRate = 30;
+
+    /// Last frame presented, -1 if none yet
+    int mFrame = -1;
+
+    /// Is playback running?
+    bool mRunning = false;
+
+    /// Number of frames presented
+    int mPresented = 0;
+
+    /// Number of frames skipped because they came due too late to present
+    int mDropped = 0;
+
+    /// Number of frames presented late
+    int mLate = 0;
+
+public:
+    PlaybackClock() {}
+
+    /** Copy constructor disabled */
+    PlaybackClock(const PlaybackClock &) = delete;
+    /** Assignment operator disabled */
+    void operator=(const PlaybackClock &) = delete;
+
+    void Start(double startTime, int frameRate);
+
+    /**
+     * Stop playback
+     */
+    void Stop() { mRunning = false; }
+
+    /**
+     * Is playback running?
+     * @return true between Start and Stop
+     */
+    bool IsRunning() const { return mRunning; }
+
+    double GetElapsed() const;
+
+    int Tick(double elapsed);
+    void Drop();
+    long NextDelay(double elapsed) const;
+
+    /**
+     * Get the frames per second playback is paced for
+     * @return Frame rate
+     */
+    int GetFrameRate() const { return mFrameRate; }
+
+    /**
+     * Get the number of frames presented since playback started
+     * @return Number of frames
+     */
+    int GetPresented() const { return mPresented; }
+
+    /**
+     * Get the number of frames skipped since playback started
+     * @return Number of frames
+     */
+    int GetDropped() const { return mDropped; }
+
+    /**
+     * Get the number of frames presented late since playback started
+     * @return Number of frames
+     */
+    int GetLate() const { return mLate; }
+};
+
+#endif //CANADIANEXPERIENCE_PLAYBACKCLOCK_H
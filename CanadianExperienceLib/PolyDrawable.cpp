@@ -16,48 +16,81 @@ PolyDrawable::PolyDrawable(const std::wstring &name) : Drawable(name)
 
 /**
  * Draw our polygon.
+ *
+ * The path is in our own coordinates, so it is built once
+ * and drawn under the placed position and rotation.
  * @param  graphics The graphics context to draw on
  */
 void PolyDrawable::Draw(std::shared_ptr<wxGraphicsContext> graphics)
 {
-    if(!mPoints.empty()) {
+    if (mPoints.empty())
+    {
+        return;
+    }
+
+    graphics->PushState();
+    graphics->Translate(mPlacedPosition.x, mPlacedPosition.y);
+    graphics->Rotate(-mPlacedR);
+    graphics->SetBrush(mBrush);
+    graphics->FillPath(GetPath(graphics));
+    graphics->PopState();
+}
 
+
+/**
+ * Get the graphics path of the polygon in our own coordinates,
+ * building it the first time.
+ * @param graphics Graphics context to create the path with
+ * @return The path, null if there are no points
+ */
+const wxGraphicsPath &PolyDrawable::GetPath(std::shared_ptr<wxGraphicsContext> graphics)
+{
+    if (mPath.IsNull() && !mPoints.empty())
+    {
         mPath = graphics->CreatePath();
-        mPath.MoveToPoint(RotatePoint(mPoints[0], mPlacedR) + mPlacedPosition);
+        mPath.MoveToPoint(mPoints[0]);
         for (auto i = 1; i<mPoints.size(); i++)
         {
-            mPath.AddLineToPoint(RotatePoint(mPoints[i], mPlacedR) + mPlacedPosition);
+            mPath.AddLineToPoint(mPoints[i]);
         }
         mPath.CloseSubpath();
-
-        wxBrush brush(mColor);
-        graphics->SetBrush(brush);
-        graphics->FillPath(mPath);
     }
 
-
-
-
-//    SolidBrush brush(mColor);
-//
-//    // Transform the points
-//    vector<Point> points;
-//    for (auto point : mPoints)
-//    {
-//        points.push_back(RotatePoint(point, mPlacedR) + mPlacedPosition);
-//    }
-//
-//    graphics->FillPolygon(&brush, &points[0], (int)points.size());
+    return mPath;
 }
 
 
 /** Test to see if we hit this object with a mouse click
+ *
+ * This is a geometric test against our points, so it
+ * does not depend on the polygon having been drawn.
  * @param pos Click position
  * @return true it hit
  */
 bool PolyDrawable::HitTest(wxPoint pos)
 {
-    return mPath.Contains(pos.x, pos.y);
+    // Transform the click into our own coordinates,
+    // the inverse of the placement.
+    double dx = pos.x - mPlacedPosition.x;
+    double dy = pos.y - mPlacedPosition.y;
+    double x = mPlacedCos * dx - mPlacedSin * dy;
+    double y = mPlacedSin * dx + mPlacedCos * dy;
+
+    // Count the edges a ray to the right of the point crosses,
+    // the same odd-even rule the path is filled with.
+    bool inside = false;
+    for (size_t i = 0, j = mPoints.size() - 1; i < mPoints.size(); j = i++)
+    {
+        auto &p1 = mPoints[i];
+        auto &p2 = mPoints[j];
+        if ((p1.y > y) != (p2.y > y) &&
+            x < (double)(p2.x - p1.x) * (y - p1.y) / (p2.y - p1.y) + p1.x)
+        {
+            inside = !inside;
+        }
+    }
+
+    return inside;
 }
 
 
@@ -68,4 +101,23 @@ bool PolyDrawable::HitTest(wxPoint pos)
 void PolyDrawable::AddPoint(wxPoint point)
 {
     mPoints.push_back(point);
+
+    // wxRect::Union ignores empty rectangles, so
+    // the bounds are grown from the corners
+    if (mPoints.size() == 1)
+    {
+        mLocalBounds = wxRect(point.x, point.y, 0, 0);
+    }
+    else
+    {
+        int left = std::min(mLocalBounds.GetLeft(), point.x);
+        int top = std::min(mLocalBounds.GetTop(), point.y);
+        int right = std::max(mLocalBounds.GetLeft() + mLocalBounds.GetWidth(), point.x);
+        int bottom = std::max(mLocalBounds.GetTop() + mLocalBounds.GetHeight(), point.y);
+        mLocalBounds = wxRect(left, top, right - left, bottom - top);
+    }
+
+    // The path has to be built again
+    mPath = wxGraphicsPath();
+    InvalidatePlacement();
 }
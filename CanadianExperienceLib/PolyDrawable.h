@@ -25,8 +25,15 @@ private:
     /// The array of point objects
     std::vector<wxPoint> mPoints;
 
-    /// The transformed graphics path used
-    /// to draw this polygon
+    /// Bounding rectangle of the points
+    wxRect mLocalBounds;
+
+    /// The brush the polygon is filled with, kept in sync with mColor
+    wxBrush mBrush = *wxBLACK_BRUSH;
+
+    /// The graphics path in our own coordinates used to draw
+    /// this polygon. It is null until built and is rebuilt
+    /// only when the points change.
     wxGraphicsPath mPath;
 
 public:
@@ -45,18 +52,32 @@ public:
     bool HitTest(wxPoint pos) override;
 
     void AddPoint(wxPoint point);
+    const wxGraphicsPath &GetPath(std::shared_ptr<wxGraphicsContext> graphics);
+
+    /**
+     * Get the brush the polygon is filled with
+     * @return Brush
+     */
+    const wxBrush &GetBrush() const { return mBrush; }
 
     /**
      * Set the color for the polygon
      * @param color New color to set
      */
-    void SetColor(wxColour color) { mColor = color; }
+    void SetColor(wxColour color) { mColor = color; mBrush = wxBrush(color); }
 
     /**
      * Get the drawable color
      * @return Color
      * */
     wxColour GetColor() const { return mColor; }
+
+protected:
+    /**
+     * Get the bounding rectangle of the polygon in our own coordinates
+     * @return Bounding rectangle of the points
+     */
+    wxRect GetLocalBounds() override { return mLocalBounds; }
 };
 
 #endif //CANADIANEXPERIENCE_POLYDRAWABLE_H
@@ -0,0 +1,88 @@
+/**
+ * @file RepaintScheduler.cpp
+ * @author Shawn_Porto
+ */
+
+#include "pch.h"
+#include "RepaintScheduler.h"
+
+/**
+ * Constructor
+ * @param window The window to repaint
+ */
+RepaintScheduler::RepaintScheduler(wxWindow *window) : mWindow(window)
+{
+    mTimer.Bind(wxEVT_TIMER, [this](wxTimerEvent &event) { Repaint(); });
+}
+
+/**
+ * Request a repaint of the window.
+ */
+void RepaintScheduler::Request()
+{
+    mFull = true;
+    Schedule();
+}
+
+/**
+ * Request a repaint of part of the window.
+ * @param rect Rectangle to repaint in window coordinates. An
+ * empty rectangle repaints the whole window.
+ */
+void RepaintScheduler::Request(const wxRect &rect)
+{
+    if (rect.IsEmpty())
+    {
+        Request();
+        return;
+    }
+
+    mDirty.Union(rect);
+    Schedule();
+}
+
+/**
+ * Start the timer for a repaint if one is not pending already.
+ */
+void RepaintScheduler::Schedule()
+{
+    if (mPending)
+    {
+        return;
+    }
+
+    mPending = true;
+    mTimer.StartOnce(Delay(mStopWatch.Time(), mLastRepaint));
+}
+
+/**
+ * Repaint the window when the timer expires.
+ */
+void RepaintScheduler::Repaint()
+{
+    mPending = false;
+    mLastRepaint = mStopWatch.Time();
+
+    if (mFull)
+    {
+        mWindow->Refresh();
+    }
+    else
+    {
+        mWindow->RefreshRect(mDirty);
+    }
+
+    mFull = false;
+    mDirty = wxRect();
+}
+
+/**
+ * How long to wait before a repaint.
+ * @param now Current time in milliseconds
+ * @param lastRepaint Time of the last repaint in milliseconds
+ * @return Milliseconds to wait, at least 1 so the timer always runs from the event loop
+ */
+long RepaintScheduler::Delay(long now, long lastRepaint)
+{
+    return std::max(1L, lastRepaint + RepaintInterval - now);
+}
@@ -0,0 +1,84 @@
+/**
+ * @file RepaintScheduler.h
+ * @author Shawn_Porto
+ *
+ * Coalesces repaint requests for a window to at most one per display frame.
+ */
+
+#ifndef CANADIANEXPERIENCE_REPAINTSCHEDULER_H
+#define CANADIANEXPERIENCE_REPAINTSCHEDULER_H
+
+/// Shortest time between repaints in milliseconds, one 60Hz display frame
+const long RepaintInterval = 16;
+
+/**
+ * Coalesces repaint requests for a window to at most one per display frame.
+ *
+ * Requests only set a pending flag. The first request after a
+ * repaint starts a one shot timer that expires a display frame
+ * after the previous repaint, or as soon as the event loop gets
+ * to it if that is already past. Requests that arrive while one
+ * is pending cost nothing. Requests for a rectangle accumulate
+ * into one dirty rectangle until any request for the whole window.
+ */
+class RepaintScheduler {
+private:
+    /// The window that is repainted
+    wxWindow *mWindow;
+
+    /// Timer that does the repaint
+    wxTimer mTimer;
+
+    /// Time since the scheduler was created
+    wxStopWatch mStopWatch;
+
+    /// Time of the last repaint in milliseconds
+    long mLastRepaint = -RepaintInterval;
+
+    /// Is a repaint pending?
+    bool mPending = false;
+
+    /// Does the pending repaint cover the whole window?
+    bool mFull = false;
+
+    /// Part of the window the pending repaint covers if not all of it
+    wxRect mDirty;
+
+    void Schedule();
+    void Repaint();
+
+public:
+    RepaintScheduler(wxWindow *window);
+
+    /** Default constructor disabled */
+    RepaintScheduler() = delete;
+    /** Copy constructor disabled */
+    RepaintScheduler(const RepaintScheduler &) = delete;
+    /** Assignment operator disabled */
+    void operator=(const RepaintScheduler &) = delete;
+
+    void Request();
+    void Request(const wxRect &rect);
+
+    /**
+     * Is a repaint pending?
+     * @return true if a repaint has been requested and not done yet
+     */
+    bool IsPending() const { return mPending; }
+
+    /**
+     * Does the pending repaint cover the whole window?
+     * @return true if the whole window will be repainted
+     */
+    bool IsFull() const { return mFull; }
+
+    /**
+     * Get the part of the window the pending repaint covers
+     * @return Dirty rectangle, only meaningful if IsFull() is false
+     */
+    const wxRect &GetDirty() const { return mDirty; }
+
+    static long Delay(long now, long lastRepaint);
+};
+
+#endif //CANADIANEXPERIENCE_REPAINTSCHEDULER_H
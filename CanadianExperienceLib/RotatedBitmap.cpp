@@ -5,6 +5,7 @@
 
 #include "pch.h"
 #include "RotatedBitmap.h"
+#include "TextureAtlas.h"
 
 
 
@@ -15,6 +16,7 @@
 void RotatedBitmap::LoadImage(const std::wstring &filename)
 {
     mImage = std::make_unique<wxImage>(filename, wxBITMAP_TYPE_ANY);
+    mFilename = filename;
     mLoaded = true;
 }
 
@@ -27,16 +29,41 @@ void RotatedBitmap::LoadImage(const std::wstring &filename)
  */
 void RotatedBitmap::DrawImage(std::shared_ptr<wxGraphicsContext> graphics, wxPoint position, double angle)
 {
-    if(!mBitmapCreated)
+    if(mAtlasImage < 0 && !mBitmapCreated)
     {
         mBitmap = graphics->CreateBitmapFromImage(*mImage);
+        mBitmapCreated = true;
     }
 
     graphics->PushState();
     graphics->Translate(position.x, position.y);
     graphics->Rotate(-angle);
-    graphics->DrawBitmap(mBitmap, -mCenter.x, -mCenter.y,
-            mImage->GetWidth(), mImage->GetHeight());
+
+    if (mAtlasImage >= 0)
+    {
+        mAtlas->Draw(graphics, mAtlasImage, -mCenter.x, -mCenter.y);
+    }
+    else
+    {
+        graphics->DrawBitmap(mBitmap, -mCenter.x, -mCenter.y,
+                mImage->GetWidth(), mImage->GetHeight());
+    }
 
     graphics->PopState();
+}
+
+
+/**
+ * Set the texture atlas the image is drawn from.
+ *
+ * This does nothing if no image has been loaded.
+ * @param atlas Atlas to add the image to
+ */
+void RotatedBitmap::SetAtlas(TextureAtlas *atlas)
+{
+    if (mLoaded)
+    {
+        mAtlas = atlas;
+        mAtlasImage = atlas->Add(mFilename, *mImage);
+    }
 }
\ No newline at end of file
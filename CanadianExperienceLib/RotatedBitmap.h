@@ -8,6 +8,8 @@
 #ifndef CANADIANEXPERIENCE_ROTATEDBITMAP_H
 #define CANADIANEXPERIENCE_ROTATEDBITMAP_H
 
+class TextureAtlas;
+
 /**
  * Basic class for displaying a rotated bitmap
  */
@@ -16,6 +18,15 @@ private:
     /// The image for this drawable
     std::unique_ptr<wxImage> mImage;
 
+    /// The file the image was loaded from
+    std::wstring mFilename;
+
+    /// The atlas the image is drawn from
+    TextureAtlas *mAtlas = nullptr;
+
+    /// Index of the image in the atlas
+    int mAtlasImage = -1;
+
     /// The graphics bitmap we will use
     wxGraphicsBitmap mBitmap;
 
@@ -42,6 +53,8 @@ public:
 
     void DrawImage(std::shared_ptr<wxGraphicsContext> graphics, wxPoint position, double angle);
 
+    void SetAtlas(TextureAtlas *atlas);
+
     /**
      * Set the center to rotate around
      * @param center New center
@@ -0,0 +1,226 @@
+/**
+ * @file TextureAtlas.cpp
+ * @author Shawn_Porto
+ */
+
+#include "pch.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "TextureAtlas.h"
+
+/**
+ * Add an image to the atlas.
+ *
+ * Adding the same file again returns the index it was
+ * given the first time.
+ * @param filename File the image was loaded from
+ * @param image The image
+ * @return Index of the image in the atlas or -1 if the image is not valid
+ */
+int TextureAtlas::Add(const std::wstring &filename, const wxImage &image)
+{
+    if (!image.IsOk())
+    {
+        return -1;
+    }
+
+    auto found = mFiles.find(filename);
+    if (found != mFiles.end())
+    {
+        return found->second;
+    }
+
+    int index = (int)mImages.size();
+    mImages.push_back(image);
+    mFiles[filename] = index;
+    mDirty = true;
+
+    return index;
+}
+
+/**
+ * Decide where every image goes.
+ *
+ * Images are placed on shelves, tallest first, which packs
+ * sprites of similar height into the same rows.
+ */
+void TextureAtlas::Pack()
+{
+    mRegions.assign(mImages.size(), Region());
+    mPageSizes.clear();
+    mPages.clear();
+    mBitmaps.clear();
+
+    std::vector<int> order(mImages.size());
+    for (int i = 0; i < (int)order.size(); i++)
+    {
+        order[i] = i;
+    }
+
+    std::stable_sort(order.begin(), order.end(), [this](int a, int b) {
+        return mImages[a].GetHeight() > mImages[b].GetHeight();
+    });
+
+    int page = -1;      // Page currently being filled
+    int x = 0;          // Next free column on the current shelf
+    int shelfY = 0;     // Top of the current shelf
+    int shelfHeight = 0;
+    int usedWidth = 0;
+    std::vector<int> large;
+
+    for (auto i : order)
+    {
+        int wid = mImages[i].GetWidth();
+        int hit = mImages[i].GetHeight();
+        int paddedWid = wid + 2 * AtlasPadding;
+        int paddedHit = hit + 2 * AtlasPadding;
+
+        if (paddedWid > AtlasPageSize || paddedHit > AtlasPageSize)
+        {
+            // Too large to share a page
+            large.push_back(i);
+            continue;
+        }
+
+        if (page >= 0 && x + paddedWid > AtlasPageSize)
+        {
+            // Start a new shelf
+            shelfY += shelfHeight;
+            x = 0;
+            shelfHeight = 0;
+        }
+
+        if (page < 0 || shelfY + paddedHit > AtlasPageSize)
+        {
+            // Start a new page
+            page = (int)mPageSizes.size();
+            mPageSizes.push_back(wxSize(0, 0));
+            x = 0;
+            shelfY = 0;
+            shelfHeight = 0;
+            usedWidth = 0;
+        }
+
+        mRegions[i].page = page;
+        mRegions[i].rect = wxRect(x + AtlasPadding, shelfY + AtlasPadding, wid, hit);
+
+        x += paddedWid;
+        shelfHeight = std::max(shelfHeight, paddedHit);
+        usedWidth = std::max(usedWidth, x);
+
+        // Pages only get as large as what is on them
+        mPageSizes[page] = wxSize(usedWidth, shelfY + shelfHeight);
+    }
+
+    for (auto i : large)
+    {
+        mRegions[i].page = (int)mPageSizes.size();
+        mRegions[i].rect = wxRect(0, 0, mImages[i].GetWidth(), mImages[i].GetHeight());
+        mPageSizes.push_back(mImages[i].GetSize());
+    }
+
+    mDirty = false;
+}
+
+/**
+ * Create the page images from the packed images
+ */
+void TextureAtlas::Build()
+{
+    mPages.clear();
+    for (auto size : mPageSizes)
+    {
+        wxImage page(size.GetWidth(), size.GetHeight());
+        page.InitAlpha();
+        memset(page.GetAlpha(), 0, (size_t)size.GetWidth() * size.GetHeight());
+        mPages.push_back(page);
+    }
+
+    for (size_t i = 0; i < mImages.size(); i++)
+    {
+        auto &region = mRegions[i];
+        auto &page = mPages[region.page];
+
+        // Masked and opaque images get an alpha channel
+        wxImage image = mImages[i];
+        if (!image.HasAlpha())
+        {
+            image.InitAlpha();
+        }
+
+        int pageWid = page.GetWidth();
+        int wid = region.rect.GetWidth();
+        for (int y = 0; y < region.rect.GetHeight(); y++)
+        {
+            size_t from = (size_t)y * wid;
+            size_t to = (size_t)(region.rect.GetTop() + y) * pageWid + region.rect.GetLeft();
+            memcpy(page.GetData() + to * 3, image.GetData() + from * 3, wid * 3);
+            memcpy(page.GetAlpha() + to, image.GetAlpha() + from, wid);
+        }
+    }
+}
+
+/**
+ * Get the graphics bitmap of an image for a renderer, creating
+ * the page bitmaps and the image's part of its page as needed.
+ * @param renderer Renderer the bitmap is for
+ * @param image Index of the image
+ * @return The bitmap of the image
+ */
+const wxGraphicsBitmap &TextureAtlas::GetBitmap(wxGraphicsRenderer *renderer, int image)
+{
+    auto &bitmaps = mBitmaps[renderer];
+    if (bitmaps.pages.empty())
+    {
+        for (auto &page : mPages)
+        {
+            bitmaps.pages.push_back(renderer->CreateBitmapFromImage(page));
+        }
+
+        bitmaps.images.resize(mImages.size());
+    }
+
+    auto &bitmap = bitmaps.images[image];
+    if (bitmap.IsNull())
+    {
+        auto &region = mRegions[image];
+        auto &rect = region.rect;
+        if (rect.GetSize() == mPageSizes[region.page])
+        {
+            // The image has the page to itself
+            bitmap = bitmaps.pages[region.page];
+        }
+        else
+        {
+            bitmap = renderer->CreateSubBitmap(bitmaps.pages[region.page],
+                    rect.GetLeft(), rect.GetTop(), rect.GetWidth(), rect.GetHeight());
+        }
+    }
+
+    return bitmap;
+}
+
+/**
+ * Draw an image from the atlas at its natural size.
+ * @param graphics Graphics context to draw on
+ * @param image Index of the image
+ * @param x Left of the image
+ * @param y Top of the image
+ */
+void TextureAtlas::Draw(std::shared_ptr<wxGraphicsContext> graphics, int image, double x, double y)
+{
+    if (mDirty)
+    {
+        Pack();
+    }
+
+    if (mPages.empty())
+    {
+        Build();
+    }
+
+    auto &rect = mRegions[image].rect;
+    graphics->DrawBitmap(GetBitmap(graphics->GetRenderer(), image), x, y, rect.GetWidth(), rect.GetHeight());
+}
@@ -0,0 +1,120 @@
+/**
+ * @file TextureAtlas.h
+ * @author Shawn_Porto
+ *
+ * Packs the images of the drawables into a few large bitmaps.
+ */
+
+#ifndef CANADIANEXPERIENCE_TEXTUREATLAS_H
+#define CANADIANEXPERIENCE_TEXTUREATLAS_H
+
+#include <map>
+
+/// Width and height of an atlas page in pixels
+const int AtlasPageSize = 2048;
+
+/// Transparent pixels kept around each image so
+/// filtering never picks up a neighbouring image
+const int AtlasPadding = 2;
+
+/**
+ * Packs the images of the drawables into a few large bitmaps.
+ *
+ * Images are added while the picture is assembled and packed
+ * into page images the first time one of them is drawn. An
+ * image larger than a page gets a page of its own.
+ *
+ * Graphics bitmaps belong to the renderer that created them,
+ * so each renderer the atlas is drawn with gets its own page
+ * bitmaps, and a sub-bitmap of its page for each image the
+ * first time that image is drawn. All of the images drawn
+ * with a renderer then share a handful of page bitmaps.
+ */
+class TextureAtlas {
+public:
+    /// Where an image is located in the atlas
+    struct Region
+    {
+        /// Index of the page the image is on
+        int page = -1;
+
+        /// Rectangle of the image on the page
+        wxRect rect;
+    };
+
+private:
+    /// The images that have been added, by index
+    std::vector<wxImage> mImages;
+
+    /// Where each image is located, by index
+    std::vector<Region> mRegions;
+
+    /// Size of each page
+    std::vector<wxSize> mPageSizes;
+
+    /// The page images, created when the atlas is built
+    std::vector<wxImage> mPages;
+
+    /// The graphics bitmaps created with one renderer
+    struct Bitmaps
+    {
+        /// Bitmap of each page
+        std::vector<wxGraphicsBitmap> pages;
+
+        /// Bitmap of each image, a part of its page, null until drawn
+        std::vector<wxGraphicsBitmap> images;
+    };
+
+    /// The graphics bitmaps by the renderer that created them
+    std::map<wxGraphicsRenderer *, Bitmaps> mBitmaps;
+
+    /// Index of each image by filename, so an image is only added once
+    std::map<std::wstring, int> mFiles;
+
+    /// True if images were added since the atlas was packed
+    bool mDirty = false;
+
+public:
+    TextureAtlas() {}
+
+    /** Copy constructor disabled */
+    TextureAtlas(const TextureAtlas &) = delete;
+    /** Assignment operator disabled */
+    void operator=(const TextureAtlas &) = delete;
+
+    int Add(const std::wstring &filename, const wxImage &image);
+    void Pack();
+    void Draw(std::shared_ptr<wxGraphicsContext> graphics, int image, double x, double y);
+
+    /**
+     * Get the location of an image in the atlas
+     * @param image Index of the image
+     * @return Region of the image, valid after the atlas is packed
+     */
+    const Region &GetRegion(int image) const { return mRegions[image]; }
+
+    /**
+     * Get the number of pages
+     * @return Number of pages, valid after the atlas is packed
+     */
+    int GetNumPages() const { return (int)mPageSizes.size(); }
+
+    /**
+     * Get the size of a page
+     * @param page Page index
+     * @return Size of the page in pixels
+     */
+    wxSize GetPageSize(int page) const { return mPageSizes[page]; }
+
+    /**
+     * Get the number of images in the atlas
+     * @return Number of images
+     */
+    int GetNumImages() const { return (int)mImages.size(); }
+
+private:
+    void Build();
+    const wxGraphicsBitmap &GetBitmap(wxGraphicsRenderer *renderer, int image);
+};
+
+#endif //CANADIANEXPERIENCE_TEXTUREATLAS_H
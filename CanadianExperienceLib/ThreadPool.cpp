@@ -0,0 +1,150 @@
+/**
+ * @file ThreadPool.cpp
+ * @author Shawn_Porto
+ */
+
+#include "pch.h"
+#include "ThreadPool.h"
+
+/**
+ * Constructor, one thread for each core
+ */
+ThreadPool::ThreadPool()
+{
+    mNumThreads = std::max(1, (int)std::thread::hardware_concurrency());
+}
+
+/**
+ * Destructor, stops the workers
+ */
+ThreadPool::~ThreadPool()
+{
+    Stop();
+}
+
+/**
+ * Set the number of threads that work on a loop
+ * @param threads Number of threads including the caller, 1 runs every loop on the caller
+ */
+void ThreadPool::SetNumThreads(int threads)
+{
+    std::lock_guard<std::mutex> call(mCallMutex);
+    Stop();
+    mNumThreads = std::max(1, threads);
+}
+
+/**
+ * Stop and join the workers
+ */
+void ThreadPool::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStopping = true;
+    }
+
+    mStart.notify_all();
+    for (auto &thread : mThreads)
+    {
+        thread.join();
+    }
+
+    mThreads.clear();
+    mStopping = false;
+}
+
+/**
+ * Run a loop in blocks on all of the threads.
+ *
+ * Loops no bigger than one block run on the caller
+ * without waking the workers.
+ * @param count Number of indices, the loop runs from 0 to count - 1
+ * @param grain Indices in each block
+ * @param body Function that runs one block
+ */
+void ThreadPool::ParallelFor(int count, int grain, const Body &body)
+{
+    grain = std::max(1, grain);
+    if (count <= 0)
+    {
+        return;
+    }
+
+    if (mNumThreads <= 1 || count <= grain)
+    {
+        body(0, count);
+        return;
+    }
+
+    std::lock_guard<std::mutex> call(mCallMutex);
+    if (mThreads.empty())
+    {
+        for (int i = 1; i < mNumThreads; i++)
+        {
+            mThreads.emplace_back(&ThreadPool::Run, this);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mBody = &body;
+        mCount = count;
+        mGrain = grain;
+        mNext = 0;
+        mWorking = (int)mThreads.size();
+        mGeneration++;
+    }
+
+    mStart.notify_all();
+    RunBlocks();
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    mFinished.wait(lock, [this] { return mWorking == 0; });
+    mBody = nullptr;
+}
+
+/**
+ * Take blocks of the loop and run them until there are none left
+ */
+void ThreadPool::RunBlocks()
+{
+    while (true)
+    {
+        int first = mNext.fetch_add(mGrain);
+        if (first >= mCount)
+        {
+            return;
+        }
+
+        (*mBody)(first, std::min(first + mGrain, mCount));
+    }
+}
+
+/**
+ * A worker thread: help with each loop until stopped
+ */
+void ThreadPool::Run()
+{
+    int generation = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mStart.wait(lock, [this, generation] { return mStopping || mGeneration != generation; });
+            if (mStopping)
+            {
+                return;
+            }
+
+            generation = mGeneration;
+        }
+
+        RunBlocks();
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (--mWorking == 0)
+        {
+            mFinished.notify_one();
+        }
+    }
+}
@@ -0,0 +1,99 @@
+/**
+ * @file ThreadPool.h
+ * @author Shawn_Porto
+ *
+ * Worker threads that split a loop into blocks and run them in parallel.
+ */
+
+#ifndef CANADIANEXPERIENCE_THREADPOOL_H
+#define CANADIANEXPERIENCE_THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+/**
+ * Worker threads that split a loop into blocks and run them in parallel.
+ *
+ * ParallelFor() hands out blocks of the loop to the workers and the
+ * calling thread alike and returns once every block is done, so
+ * anything the blocks wrote is visible to the caller afterwards.
+ * Each index is visited exactly once, and as long as each writes
+ * only its own results the outcome does not depend on how the
+ * blocks were scheduled.
+ *
+ * The workers are started the first time a loop is big enough
+ * to be split, so a pool that is never needed costs nothing.
+ */
+class ThreadPool {
+public:
+    /// A block of a loop, from the first index up to but not including the end
+    using Body = std::function<void(int first, int end)>;
+
+private:
+    /// Threads that work on a loop, including the caller
+    int mNumThreads;
+
+    /// The worker threads
+    std::vector<std::thread> mThreads;
+
+    /// Only one loop runs at a time
+    std::mutex mCallMutex;
+
+    /// Guards the loop shared with the workers
+    std::mutex mMutex;
+
+    /// Signals the workers a loop has started, or they should stop
+    std::condition_variable mStart;
+
+    /// Signals the caller the workers are done with the loop
+    std::condition_variable mFinished;
+
+    /// The loop body while a loop runs
+    const Body *mBody = nullptr;
+
+    /// Number of indices in the loop
+    int mCount = 0;
+
+    /// Indices in each block
+    int mGrain = 1;
+
+    /// First index of the next block to hand out
+    std::atomic<int> mNext{0};
+
+    /// Counts the loops, so a worker knows there is a new one
+    int mGeneration = 0;
+
+    /// Workers still working on the loop
+    int mWorking = 0;
+
+    /// Should the workers stop?
+    bool mStopping = false;
+
+    void Run();
+    void RunBlocks();
+    void Stop();
+
+public:
+    ThreadPool();
+    ~ThreadPool();
+
+    /** Copy constructor disabled */
+    ThreadPool(const ThreadPool &) = delete;
+    /** Assignment operator disabled */
+    void operator=(const ThreadPool &) = delete;
+
+    /**
+     * Get the number of threads that work on a loop
+     * @return Number of threads, including the caller
+     */
+    int GetNumThreads() const { return mNumThreads; }
+
+    void SetNumThreads(int threads);
+
+    void ParallelFor(int count, int grain, const Body &body);
+};
+
+#endif //CANADIANEXPERIENCE_THREADPOOL_H
@@ -5,7 +5,17 @@
 
 #include "pch.h"
 #include "Timeline.h"
+
+#include <algorithm>
+#include <climits>
+
 #include "AnimChannel.h"
+#include "AnimChannelObserver.h"
+#include "ThreadPool.h"
+#include "Trace.h"
+
+/// Channels interpolated in each block on the thread pool
+const int ParallelChannelGrain = 256;
 
 /**
  * Constructor
@@ -23,23 +33,220 @@ void Timeline::AddChannel(AnimChannel *channel)
 {
     mChannels.push_back(channel);
     channel->SetTimeline(this);
+    mIndexDirty = true;
+
+    for (int k = 0; k < channel->GetNumKeyframes(); k++)
+    {
+        mKeyframeSummary.Add(channel->GetKeyframeFrame(k));
+    }
+}
+
+
+/**
+ * Indicate a channel has to be evaluated the next time the time
+ * is set, even if it is constant at that time.
+ * @param channel Channel whose object was changed outside the animation
+ */
+void Timeline::InvalidateChannel(AnimChannel *channel)
+{
+    if (std::find(mInvalidChannels.begin(), mInvalidChannels.end(), channel) == mInvalidChannels.end())
+    {
+        mInvalidChannels.push_back(channel);
+    }
 }
 
 
 /** Sets the current time
 *
-* Ensures all of the channels are
-* valid for that point in time.
+* Ensures all of the channels are valid for that point in time.
+*
+* A channel only changes between its first and last keyframes, so
+* the interval index keeps, for each span of frames, the channels
+* that are animated there. Within a span only those channels are
+* evaluated. Stepping into the next or previous span also evaluates
+* the channels that just started or stopped changing. Anything else,
+* like a jump across several spans, evaluates every channel.
 * @param t The new time to set
 */
 void Timeline::SetCurrentTime(double t)
 {
+    TraceSpan span("Timeline::SetCurrentTime");
+
     // Set the time
     mCurrentTime = t;
+    mChangedChannels.clear();
+
+    bool rebuilt = mIndexDirty;
+    if (rebuilt)
+    {
+        BuildIndex();
+    }
+
+    int currSpan = FindSpan(GetCurrentFrame());
+    if (rebuilt)
+    {
+        EvaluateAll();
+    }
+    else if (currSpan == mSpan)
+    {
+        if (t != mEvaluatedTime)
+        {
+            EvaluateSpan(currSpan);
+        }
+    }
+    else if (currSpan == mSpan + 1 || currSpan == mSpan - 1)
+    {
+        EvaluateSpan(currSpan);
+
+        // Channels that just stopped changing get their end value
+        int start = mSpanStarts[currSpan];
+        for (auto channel : mSpanChannels[mSpan])
+        {
+            if (start < channel->GetKeyframeFrame(0) ||
+                    start > channel->GetKeyframeFrame(channel->GetNumKeyframes() - 1))
+            {
+                Evaluate(channel);
+            }
+        }
+    }
+    else
+    {
+        EvaluateAll();
+    }
+
+    for (auto channel : mInvalidChannels)
+    {
+        if (std::find(mChangedChannels.begin(), mChangedChannels.end(), channel) == mChangedChannels.end())
+        {
+            Evaluate(channel);
+        }
+    }
+    mInvalidChannels.clear();
+
+    mSpan = currSpan;
+    mEvaluatedTime = t;
+
+    // Each channel only touches itself, so once it is known which ones
+    // change they are interpolated in blocks on the thread pool
+    int frame = GetCurrentFrame();
+    auto evaluate = [this, frame](int first, int end) {
+        for (int i = first; i < end; i++)
+        {
+            mChangedChannels[i]->SetFrame(frame);
+        }
+    };
+
+    if (mThreadPool != nullptr)
+    {
+        mThreadPool->ParallelFor((int)mChangedChannels.size(), ParallelChannelGrain, evaluate);
+    }
+    else
+    {
+        evaluate(0, (int)mChangedChannels.size());
+    }
+
+    // The observers share drawables between channels, so they are told in order
+
+    for (auto channel : mChangedChannels)
+    {
+        auto observer = channel->GetObserver();
+        if (observer != nullptr)
+        {
+            observer->OnChannelChanged(channel);
+        }
+    }
+}
+
+
+/**
+ * Build the interval index of which channels are animated
+ * over which spans of frames.
+ *
+ * Each channel with two or more keyframes is animated from its
+ * first keyframe up to and including its last keyframe. The span
+ * boundaries are those frames and the frame after each last one.
+ */
+void Timeline::BuildIndex()
+{
+    mSpanStarts.clear();
+    mSpanStarts.push_back(INT_MIN);
+    for (auto channel : mChannels)
+    {
+        if (channel->IsAnimated())
+        {
+            mSpanStarts.push_back(channel->GetKeyframeFrame(0));
+            mSpanStarts.push_back(channel->GetKeyframeFrame(channel->GetNumKeyframes() - 1) + 1);
+        }
+    }
+
+    std::sort(mSpanStarts.begin(), mSpanStarts.end());
+    mSpanStarts.erase(std::unique(mSpanStarts.begin(), mSpanStarts.end()), mSpanStarts.end());
+
+    mSpanChannels.assign(mSpanStarts.size(), {});
+    for (auto channel : mChannels)
+    {
+        if (channel->IsAnimated())
+        {
+            int first = FindSpan(channel->GetKeyframeFrame(0));
+            int end = FindSpan(channel->GetKeyframeFrame(channel->GetNumKeyframes() - 1) + 1);
+            for (int span = first; span < end; span++)
+            {
+                mSpanChannels[span].push_back(channel);
+            }
+        }
+    }
+
+    mIndexDirty = false;
+}
+
+
+/**
+ * Find the span of the interval index a frame is in
+ * @param frame Frame to find
+ * @return Index into mSpanStarts
+ */
+int Timeline::FindSpan(int frame) const
+{
+    auto loc = std::upper_bound(mSpanStarts.begin(), mSpanStarts.end(), frame);
+    return (int)(loc - mSpanStarts.begin()) - 1;
+}
+
+
+/**
+ * Add one channel to the channels evaluated for the current time
+ * @param channel Channel to evaluate
+ */
+void Timeline::Evaluate(AnimChannel *channel)
+{
+    if (channel->IsValid())
+    {
+        mChangedChannels.push_back(channel);
+    }
+}
 
+
+/**
+ * Add every channel to the channels evaluated for the current time
+ */
+void Timeline::EvaluateAll()
+{
     for (auto channel : mChannels)
     {
-        channel->SetFrame(GetCurrentFrame());
+        Evaluate(channel);
+    }
+}
+
+
+/**
+ * Add the channels animated in a span of the interval index
+ * to the channels evaluated for the current time
+ * @param span Index of the span
+ */
+void Timeline::EvaluateSpan(int span)
+{
+    for (auto channel : mSpanChannels[span])
+    {
+        Evaluate(channel);
     }
 }
 
@@ -61,13 +268,39 @@ void Timeline::ClearKeyframe()
  * @param root Xml node to save to
  */
 void Timeline::Save(wxXmlNode* root)
+{
+    XmlSaveAttributes(root);
+
+    for (auto channel : mChannels)
+    {
+       channel->XmlSave(root);
+    }
+}
+
+
+/**
+ * Add the timeline attributes to the root node of an animation
+ * @param root Xml node to add the attributes to
+ */
+void Timeline::XmlSaveAttributes(wxXmlNode* root)
 {
     root->AddAttribute(L"numframes", wxString::Format(wxT("%i"), mNumFrames));
     root->AddAttribute(L"framerate", wxString::Format(wxT("%i"), mFrameRate));
+}
+
 
+/**
+ * Stream the timeline channels to an XML animation file.
+ *
+ * The root element has to have been started with
+ * the attributes from XmlSaveAttributes.
+ * @param writer Writer for the file
+ */
+void Timeline::Save(AnimXmlWriter* writer)
+{
     for (auto channel : mChannels)
     {
-       channel->XmlSave(root);
+        channel->XmlSave(writer);
     }
 }
 
@@ -86,6 +319,9 @@ void Timeline::Load(wxXmlNode* root)
     mNumFrames = wxAtoi(root->GetAttribute(L"numframes", L"300"));
     mFrameRate = wxAtoi(root->GetAttribute(L"framerate", L"30"));
 
+    // Channel names are looked up for every channel tag
+    auto channels = GetChannelsByName();
+
     //
     // Traverse the children of the root
     // node of the XML document in memory!!!!
@@ -96,31 +332,109 @@ void Timeline::Load(wxXmlNode* root)
         auto name = child->GetName();
         if(name == L"channel")
         {
-            XmlChannel(child);
+            XmlChannel(child, channels);
         }
     }
 
+    // The channels load without moving the timeline,
+    // so evaluate everything once now
+    SetCurrentTime(mCurrentTime);
+}
+
+
+/**
+ * Start streaming in an animation
+ * @param root The root element, only its attributes are used
+ */
+void Timeline::XmlStartLoad(wxXmlNode* root)
+{
+    Clear();
+
+    // Get the attributes
+    mNumFrames = wxAtoi(root->GetAttribute(L"numframes", L"300"));
+    mFrameRate = wxAtoi(root->GetAttribute(L"framerate", L"30"));
+
+    mLoadChannels = GetChannelsByName();
+    mLoadChannel = nullptr;
+}
+
+
+/**
+ * Handle an element as it is streamed in.
+ *
+ * Channel elements are children of the root and keyframe
+ * elements are children of a channel. Anything else is ignored.
+ * @param element The element, with its attributes but no children
+ * @param depth Depth of the element, 0 for the root
+ */
+void Timeline::XmlLoadElement(wxXmlNode* element, int depth)
+{
+    if (depth == 1)
+    {
+        mLoadChannel = nullptr;
+        if (element->GetName() == L"channel")
+        {
+            auto channel = mLoadChannels.find(element->GetAttribute(L"name", L"").ToStdWstring());
+            if (channel != mLoadChannels.end())
+            {
+                mLoadChannel = channel->second;
+            }
+        }
+    }
+    else if (depth == 2 && mLoadChannel != nullptr && element->GetName() == L"keyframe")
+    {
+        mLoadChannel->XmlLoadKeyframeNode(element);
+    }
+}
+
+
+/**
+ * Finish streaming in an animation and evaluate the channels
+ */
+void Timeline::XmlEndLoad()
+{
+    mLoadChannels.clear();
+    mLoadChannel = nullptr;
+
+    SetCurrentTime(mCurrentTime);
+}
+
+
+/**
+ * Get a map from channel name to channel, for loading.
+ *
+ * If several channels have the same name the first one wins.
+ * @return Map from channel name to channel
+ */
+std::unordered_map<std::wstring, AnimChannel *> Timeline::GetChannelsByName() const
+{
+    std::unordered_map<std::wstring, AnimChannel *> channels;
+    channels.reserve(mChannels.size());
+    for (auto channel : mChannels)
+    {
+        channels.emplace(channel->GetName(), channel);
+    }
+
+    return channels;
 }
 
 
 /**
  * Handle the "channel" XML tag.
  * @param node Node that is the channel tag.
+ * @param channels The channels by name
  */
-void Timeline::XmlChannel(wxXmlNode* node)
+void Timeline::XmlChannel(wxXmlNode* node, const std::unordered_map<std::wstring, AnimChannel *> &channels)
 {
     // Get the channel name
     auto name = node->GetAttribute(L"name", L"");
 
     // Find the channel
-    for (auto channel : mChannels)
+    auto channel = channels.find(name.ToStdWstring());
+    if (channel != channels.end())
     {
-        if (channel->GetName() == name)
-        {
-            // We found it, let it handle it
-            channel->XmlLoad(node);
-            break;
-        }
+        // We found it, let it handle it
+        channel->second->XmlLoad(node);
     }
 }
 
@@ -140,4 +454,6 @@ void Timeline::Clear()
     {
         channel->Clear();
     }
+
+    mIndexDirty = true;
 }
\ No newline at end of file
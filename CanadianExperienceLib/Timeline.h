@@ -8,7 +8,13 @@
 #ifndef CANADIANEXPERIENCE_TIMELINE_H
 #define CANADIANEXPERIENCE_TIMELINE_H
 
+#include <unordered_map>
+
+#include "KeyframeSummary.h"
+
 class AnimChannel;
+class AnimXmlWriter;
+class ThreadPool;
 
 /**
  * This class implements a timeline that manages the animation
@@ -19,7 +25,12 @@ class AnimChannel;
  */
 class Timeline {
 private:
-    void XmlChannel(wxXmlNode* node);
+    void XmlChannel(wxXmlNode* node, const std::unordered_map<std::wstring, AnimChannel *> &channels);
+    void BuildIndex();
+    int FindSpan(int frame) const;
+    void Evaluate(AnimChannel *channel);
+    void EvaluateAll();
+    void EvaluateSpan(int span);
 
     int mNumFrames = 300;       ///< Number of frames in the animation
     int mFrameRate = 30;        ///< Animation frame rate in frames per second
@@ -28,6 +39,40 @@ private:
     /// List of all animation channels
     std::vector<AnimChannel *> mChannels;
 
+    /// First frame of each span of the interval index. Within a span the
+    /// same set of channels is animated. The first span starts at INT_MIN.
+    std::vector<int> mSpanStarts;
+
+    /// Channels that are between their first and last keyframes in each span
+    std::vector<std::vector<AnimChannel *>> mSpanChannels;
+
+    /// Span the channels were last evaluated in
+    int mSpan = 0;
+
+    /// Time the channels were last evaluated for
+    double mEvaluatedTime = 0;
+
+    /// True if keyframes have been added or removed since the index was built
+    bool mIndexDirty = true;
+
+    /// Channels changed outside the animation that have to be evaluated again
+    std::vector<AnimChannel *> mInvalidChannels;
+
+    /// Channels evaluated by the last SetCurrentTime
+    std::vector<AnimChannel *> mChangedChannels;
+
+    /// Counts of the keyframes of all channels on each frame
+    KeyframeSummary mKeyframeSummary;
+
+    /// The channels by name while a file is streamed in
+    std::unordered_map<std::wstring, AnimChannel *> mLoadChannels;
+
+    /// Channel the keyframes being streamed in belong to
+    AnimChannel *mLoadChannel = nullptr;
+
+    /// Threads the channels are evaluated on or nullptr to evaluate them on the caller
+    ThreadPool *mThreadPool = nullptr;
+
 public:
     Timeline();
 
@@ -59,7 +104,7 @@ public:
      * Set the frame rate
      * @param frameRate Animation frame rate in frames per second
      */
-    void SetFrameRate(int frameRate) {mFrameRate = frameRate;}
+    void SetFrameRate(int frameRate) {mFrameRate = frameRate; mIndexDirty = true;}
 
     /**
      * Get the current time
@@ -88,10 +133,59 @@ public:
 
     void AddChannel(AnimChannel* channel);
 
+    /**
+     * Get the number of channels in the timeline
+     * @return Number of channels
+     */
+    int GetNumChannels() const { return (int)mChannels.size(); }
+
+    /**
+     * Get a channel
+     * @param channel Index of the channel
+     * @return The channel
+     */
+    AnimChannel *GetChannel(int channel) { return mChannels[channel]; }
+
+    std::unordered_map<std::wstring, AnimChannel *> GetChannelsByName() const;
+
+    /**
+     * Indicate keyframes have been added or removed, so every
+     * channel is evaluated the next time the time is set.
+     */
+    void InvalidateIndex() { mIndexDirty = true; }
+
+    void InvalidateChannel(AnimChannel* channel);
+
+    /**
+     * Get the channels evaluated by the last SetCurrentTime
+     * @return Channels whose observers were told of a new value
+     */
+    const std::vector<AnimChannel *> &GetChangedChannels() const { return mChangedChannels; }
+
+    /**
+     * Get the counts of the keyframes on each frame.
+     * The channels keep this up to date as keyframes change.
+     * @return Keyframe summary for all channels
+     */
+    KeyframeSummary &GetKeyframeSummary() { return mKeyframeSummary; }
+
+    /**
+     * Set the threads the channels are evaluated on
+     * @param threadPool Thread pool or nullptr to evaluate them on the caller
+     */
+    void SetThreadPool(ThreadPool *threadPool) { mThreadPool = threadPool; }
+
     void Save(wxXmlNode* root);
 
     void Load(wxXmlNode* root);
 
+    void XmlSaveAttributes(wxXmlNode* root);
+    void Save(AnimXmlWriter* writer);
+
+    void XmlStartLoad(wxXmlNode* root);
+    void XmlLoadElement(wxXmlNode* element, int depth);
+    void XmlEndLoad();
+
 
 };
 
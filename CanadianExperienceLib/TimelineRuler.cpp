@@ -0,0 +1,153 @@
+/**
+ * @file TimelineRuler.cpp
+ * @author Shawn_Porto
+ */
+
+#include "pch.h"
+
+#include <sstream>
+
+#include "TimelineRuler.h"
+
+/**
+ * Integer division that rounds toward negative infinity
+ * @param a Dividend
+ * @param b Divisor, must be positive
+ * @return a / b rounded down
+ */
+static int FloorDivide(int a, int b)
+{
+    return a >= 0 ? a / b : -((-a + b - 1) / b);
+}
+
+/**
+ * Set the timeline the ruler is for.
+ *
+ * The cached strips are discarded if the number of
+ * frames or the frame rate changed.
+ * @param numFrames Number of frames in the timeline
+ * @param frameRate Frames per second
+ */
+void TimelineRuler::SetTimeline(int numFrames, int frameRate)
+{
+    if (numFrames != mNumFrames || frameRate != mFrameRate)
+    {
+        mNumFrames = numFrames;
+        mFrameRate = frameRate;
+        mStrips.clear();
+    }
+}
+
+/**
+ * The ticks that fall in a horizontal range of the ruler
+ * @param left Left edge of the range in pixels
+ * @param right Right edge of the range in pixels, inclusive
+ * @param numFrames Number of frames in the timeline
+ * @param first Set to the first tick in the range
+ * @param last Set to the last tick in the range
+ * @return false if no ticks fall in the range
+ */
+bool TimelineRuler::TickRange(int left, int right, int numFrames, int &first, int &last)
+{
+    first = std::max(0, -FloorDivide(BorderLeft - left, TickSpacing));
+    last = std::min(numFrames, FloorDivide(right - BorderLeft, TickSpacing));
+    return first <= last;
+}
+
+/**
+ * Draw the part of the ruler that is in view.
+ * @param graphics Graphics context to draw on, in timeline coordinates
+ * @param left Left edge of the view in pixels
+ * @param right Right edge of the view in pixels, inclusive
+ */
+void TimelineRuler::Draw(std::shared_ptr<wxGraphicsContext> graphics, int left, int right)
+{
+    if (mFrameRate <= 0)
+    {
+        return;
+    }
+
+    int firstStrip = FloorDivide(left, RulerStripWidth);
+    int lastStrip = FloorDivide(right, RulerStripWidth);
+
+    // After a lot of scrolling keep only what is in view
+    if (mStrips.size() > RulerMaxStrips)
+    {
+        mStrips.erase(mStrips.begin(), mStrips.lower_bound(firstStrip));
+        mStrips.erase(mStrips.upper_bound(lastStrip), mStrips.end());
+    }
+
+    for (int strip = firstStrip; strip <= lastStrip; strip++)
+    {
+        auto found = mStrips.find(strip);
+        if (found == mStrips.end())
+        {
+            found = mStrips.emplace(strip, RenderStrip(strip)).first;
+        }
+
+        graphics->DrawBitmap(found->second, strip * RulerStripWidth, 0, RulerStripWidth, RulerStripHeight);
+    }
+}
+
+/**
+ * Render one strip of the ruler into a bitmap
+ * @param strip Index of the strip from the left
+ * @return The rendered strip
+ */
+wxBitmap TimelineRuler::RenderStrip(int strip)
+{
+    wxBitmap bitmap(RulerStripWidth, RulerStripHeight);
+
+    wxMemoryDC dc(bitmap);
+    dc.SetBackground(*wxWHITE_BRUSH);
+    dc.Clear();
+
+    {
+        // The strip is drawn when the context is destroyed
+        auto graphics = std::shared_ptr<wxGraphicsContext>(wxGraphicsContext::Create(dc));
+
+        int stripLeft = strip * RulerStripWidth;
+        graphics->Translate(-stripLeft, 0);
+
+        wxFont font(wxSize(0, TickFontSize),
+                wxFONTFAMILY_SWISS,
+                wxFONTSTYLE_NORMAL,
+                wxFONTWEIGHT_NORMAL);
+        graphics->SetFont(font, *wxBLACK);
+        graphics->SetPen(*wxBLACK_PEN);
+
+        int top = TickTop;
+
+        int first, last;
+        if (TickRange(stripLeft - RulerLabelMargin, stripLeft + RulerStripWidth + RulerLabelMargin,
+                mNumFrames, first, last))
+        {
+            for (int tickNum = first; tickNum <= last; tickNum++)
+            {
+                int x = BorderLeft + tickNum * TickSpacing;
+                int bottom = top + TickShort;
+
+                bool onSecond = (tickNum % mFrameRate) == 0;
+                if (onSecond)
+                {
+                    bottom = top + TickLong;
+
+                    // Convert the tick number to seconds in a string
+                    std::wstringstream str;
+                    str << tickNum / mFrameRate;
+                    std::wstring wstr = str.str();
+
+                    double w, h;
+                    graphics->GetTextExtent(wstr, &w, &h);
+
+                    graphics->DrawText(wstr, x - w / 2, bottom + 5);
+                }
+
+                graphics->StrokeLine(x, bottom, x, top);
+            }
+        }
+    }
+
+    dc.SelectObject(wxNullBitmap);
+    return bitmap;
+}
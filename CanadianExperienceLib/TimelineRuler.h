@@ -0,0 +1,89 @@
+/**
+ * @file TimelineRuler.h
+ * @author Shawn_Porto
+ *
+ * The tick mark ruler along the top of the timeline, cached in strips.
+ */
+
+#ifndef CANADIANEXPERIENCE_TIMELINERULER_H
+#define CANADIANEXPERIENCE_TIMELINERULER_H
+
+#include <map>
+
+/// Y location for the top of a tick mark
+const int TickTop = 15;
+
+/// The spacing between ticks in the timeline
+const int TickSpacing = 4;
+
+/// The length of a short tick mark
+const int TickShort = 10;
+
+/// The length of a long tick mark
+const int TickLong = 20;
+
+/// Size of the tick mark labels
+const int TickFontSize = 15;
+
+/// Space to the left of the scale
+const int BorderLeft = 10;
+
+/// Space to the right of the scale
+const int BorderRight = 10;
+
+/// Width of one cached strip of the ruler in pixels
+const int RulerStripWidth = 512;
+
+/// Height of the ruler strips, down past the bottom of the labels
+const int RulerStripHeight = TickTop + TickLong + 5 + TickFontSize + 5;
+
+/// Ticks this far outside a strip are drawn into it, so
+/// labels that straddle two strips appear whole in both
+const int RulerLabelMargin = 50;
+
+/// Most strips kept before the ones out of view are discarded
+const size_t RulerMaxStrips = 16;
+
+/**
+ * The tick mark ruler along the top of the timeline, cached in strips.
+ *
+ * The ruler is as wide as the whole timeline, which can be tens of
+ * thousands of pixels, so it is cut into fixed width strips. Only
+ * the strips in view are drawn, each rendered into a bitmap the
+ * first time it is needed. The strips are thrown away when the
+ * number of frames or the frame rate changes.
+ */
+class TimelineRuler {
+private:
+    /// Number of frames the strips were rendered for
+    int mNumFrames = 0;
+
+    /// Frame rate the strips were rendered for
+    int mFrameRate = 0;
+
+    /// The rendered strips by index from the left
+    std::map<int, wxBitmap> mStrips;
+
+    wxBitmap RenderStrip(int strip);
+
+public:
+    TimelineRuler() {}
+
+    /** Copy constructor disabled */
+    TimelineRuler(const TimelineRuler &) = delete;
+    /** Assignment operator disabled */
+    void operator=(const TimelineRuler &) = delete;
+
+    void SetTimeline(int numFrames, int frameRate);
+    void Draw(std::shared_ptr<wxGraphicsContext> graphics, int left, int right);
+
+    /**
+     * Get the number of strips currently rendered
+     * @return Number of cached strips
+     */
+    size_t GetNumStrips() const { return mStrips.size(); }
+
+    static bool TickRange(int left, int right, int numFrames, int &first, int &last);
+};
+
+#endif //CANADIANEXPERIENCE_TIMELINERULER_H
@@ -0,0 +1,191 @@
+/**
+ * @file Trace.cpp
+ * @author Shawn_Porto
+ */
+
+#include "pch.h"
+#include <wx/file.h>
+
+#include <iomanip>
+#include <sstream>
+
+#include "Trace.h"
+
+/// Process id written into the trace events
+const int TraceProcessId = 1;
+
+/// Category written into the trace events
+const char *TraceCategory = "canadian";
+
+std::atomic<bool> Tracer::mEnabled{false};
+
+/**
+ * Constructor
+ */
+Tracer::Tracer() : mEpoch(std::chrono::steady_clock::now())
+{
+}
+
+/**
+ * Get the process-wide tracer
+ * @return Reference to the tracer
+ */
+Tracer &Tracer::Get()
+{
+    static Tracer tracer;
+    return tracer;
+}
+
+/**
+ * Get the current time on the tracer clock
+ * @return Nanoseconds since the tracer was created
+ */
+int64_t Tracer::Now() const
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - mEpoch).count();
+}
+
+/**
+ * Get the ring buffer for the calling thread, creating
+ * it the first time a thread records a span.
+ * @return Pointer to this thread's buffer
+ */
+Tracer::Buffer *Tracer::GetThreadBuffer()
+{
+    thread_local Buffer *buffer = nullptr;
+    if (buffer == nullptr)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto newBuffer = std::make_unique<Buffer>();
+        newBuffer->mThreadId = (int)mBuffers.size() + 1;
+        buffer = newBuffer.get();
+        mBuffers.push_back(std::move(newBuffer));
+    }
+
+    return buffer;
+}
+
+/**
+ * Record a completed span for the calling thread.
+ *
+ * Only the calling thread writes its buffer, so this
+ * is lock free. Once the buffer is full the oldest
+ * spans are overwritten.
+ * @param name Name of the span, a string literal
+ * @param start Start time in nanoseconds since the tracer epoch
+ * @param duration Duration in nanoseconds
+ */
+void Tracer::Record(const char *name, int64_t start, int64_t duration)
+{
+    auto buffer = GetThreadBuffer();
+
+    auto head = buffer->mHead.load(std::memory_order_relaxed);
+    auto &slot = buffer->mSlots[head % BufferCapacity];
+
+    slot.mSequence.store(head * 2 + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.mName.store(name, std::memory_order_relaxed);
+    slot.mStart.store(start, std::memory_order_relaxed);
+    slot.mDuration.store(duration, std::memory_order_relaxed);
+
+    slot.mSequence.store(head * 2 + 2, std::memory_order_release);
+    buffer->mHead.store(head + 1, std::memory_order_release);
+}
+
+/**
+ * Discard all recorded spans.
+ *
+ * Spans recorded concurrently with this call may
+ * or may not survive.
+ */
+void Tracer::Clear()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    for (auto &buffer : mBuffers)
+    {
+        for (auto &slot : buffer->mSlots)
+        {
+            slot.mSequence.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+/**
+ * Write all recorded spans in Chrome trace_event format.
+ *
+ * Slots that are being written while we read them
+ * are skipped rather than reported torn.
+ * @param stream Stream to write the JSON to
+ */
+void Tracer::Write(std::ostream &stream)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    stream << "{\"traceEvents\":[";
+    stream << std::fixed << std::setprecision(3);
+
+    bool first = true;
+    for (auto &buffer : mBuffers)
+    {
+        auto head = buffer->mHead.load(std::memory_order_acquire);
+        uint64_t count = head < (uint64_t)BufferCapacity ? head : (uint64_t)BufferCapacity;
+
+        for (auto i = head - count; i < head; i++)
+        {
+            auto &slot = buffer->mSlots[i % BufferCapacity];
+
+            auto sequence = slot.mSequence.load(std::memory_order_acquire);
+            if (sequence != i * 2 + 2)
+            {
+                // Cleared, overwritten, or in the middle of a write
+                continue;
+            }
+
+            auto name = slot.mName.load(std::memory_order_relaxed);
+            auto start = slot.mStart.load(std::memory_order_relaxed);
+            auto duration = slot.mDuration.load(std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.mSequence.load(std::memory_order_relaxed) != sequence)
+            {
+                continue;
+            }
+
+            if (!first)
+            {
+                stream << ",";
+            }
+            first = false;
+
+            stream << "\n{\"name\":\"" << name << "\",\"cat\":\"" << TraceCategory
+                   << "\",\"ph\":\"X\",\"ts\":" << start / 1000.0
+                   << ",\"dur\":" << duration / 1000.0
+                   << ",\"pid\":" << TraceProcessId
+                   << ",\"tid\":" << buffer->mThreadId << "}";
+        }
+    }
+
+    stream << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+/**
+ * Save all recorded spans to a Chrome trace (JSON) file
+ * @param filename File to write
+ * @return true if successful
+ */
+bool Tracer::Save(const std::wstring &filename)
+{
+    std::ostringstream stream;
+    Write(stream);
+    auto json = stream.str();
+
+    wxFile file;
+    if (!file.Create(filename, true))
+    {
+        return false;
+    }
+
+    return file.Write(json.c_str(), json.size()) == json.size();
+}
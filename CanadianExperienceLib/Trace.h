@@ -0,0 +1,172 @@
+/**
+ * @file Trace.h
+ * @author Shawn_Porto
+ *
+ * Lightweight scoped timing spans that can be exported
+ * in the Chrome trace_event (JSON) format.
+ *
+ * Each thread records into its own fixed size ring buffer.
+ * Recording never takes a lock, so spans can be left in
+ * the frame evaluation and paint paths permanently. When
+ * tracing is disabled a span costs a single relaxed load.
+ *
+ * The resulting file can be viewed in chrome://tracing or
+ * https://ui.perfetto.dev.
+ */
+
+#ifndef CANADIANEXPERIENCE_TRACE_H
+#define CANADIANEXPERIENCE_TRACE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * Collects timing spans from all threads.
+ *
+ * This is a process-wide singleton obtained with Tracer::Get().
+ */
+class Tracer
+{
+public:
+    /// Number of spans each thread keeps before the oldest is overwritten
+    static constexpr int BufferCapacity = 1 << 14;
+
+private:
+    /**
+     * One recorded span. The fields are atomics so the
+     * dump can read a slot while its owner thread writes
+     * it without a data race. The sequence number tells
+     * the reader when it got a torn copy.
+     */
+    struct Slot
+    {
+        /// Sequence number, odd while the slot is being written
+        std::atomic<uint64_t> mSequence{0};
+
+        /// Name of the span (must be a string literal)
+        std::atomic<const char *> mName{nullptr};
+
+        /// Start time in nanoseconds since the tracer epoch
+        std::atomic<int64_t> mStart{0};
+
+        /// Duration in nanoseconds
+        std::atomic<int64_t> mDuration{0};
+    };
+
+    /**
+     * Single producer ring buffer owned by one thread.
+     */
+    struct Buffer
+    {
+        /// Thread id reported in the trace
+        int mThreadId = 0;
+
+        /// Number of spans ever written to this buffer
+        std::atomic<uint64_t> mHead{0};
+
+        /// The ring of slots
+        std::vector<Slot> mSlots = std::vector<Slot>(BufferCapacity);
+    };
+
+    /// Is tracing currently enabled?
+    static std::atomic<bool> mEnabled;
+
+    /// Time all timestamps are relative to
+    std::chrono::steady_clock::time_point mEpoch;
+
+    /// Protects the list of buffers (only taken on thread registration and dump)
+    std::mutex mMutex;
+
+    /// One buffer for every thread that has ever recorded a span
+    std::vector<std::unique_ptr<Buffer>> mBuffers;
+
+    Tracer();
+
+    Buffer *GetThreadBuffer();
+
+public:
+    /// Copy constructor (disabled)
+    Tracer(const Tracer &) = delete;
+    /// Assignment operator (disabled)
+    void operator=(const Tracer &) = delete;
+
+    static Tracer &Get();
+
+    /**
+     * Is tracing enabled?
+     * @return true if spans are being recorded
+     */
+    static bool IsEnabled() { return mEnabled.load(std::memory_order_relaxed); }
+
+    /**
+     * Enable or disable the recording of spans
+     * @param enabled New enabled state
+     */
+    static void SetEnabled(bool enabled) { mEnabled.store(enabled, std::memory_order_relaxed); }
+
+    int64_t Now() const;
+
+    void Record(const char *name, int64_t start, int64_t duration);
+
+    void Clear();
+
+    void Write(std::ostream &stream);
+
+    bool Save(const std::wstring &filename);
+};
+
+/**
+ * A scoped timing span.
+ *
+ * Construct one of these at the top of the scope to be
+ * measured. The name must be a string literal, since only
+ * the pointer is stored.
+ */
+class TraceSpan
+{
+private:
+    /// Name of the span or nullptr if tracing was disabled at construction
+    const char *mName = nullptr;
+
+    /// Start time in nanoseconds since the tracer epoch
+    int64_t mStart = 0;
+
+public:
+    /**
+     * Constructor
+     * @param name Name of the span, a string literal
+     */
+    explicit TraceSpan(const char *name)
+    {
+        if (Tracer::IsEnabled())
+        {
+            mName = name;
+            mStart = Tracer::Get().Now();
+        }
+    }
+
+    /**
+     * Destructor, records the span
+     */
+    ~TraceSpan()
+    {
+        if (mName != nullptr)
+        {
+            auto &tracer = Tracer::Get();
+            tracer.Record(mName, mStart, tracer.Now() - mStart);
+        }
+    }
+
+    /// Copy constructor (disabled)
+    TraceSpan(const TraceSpan &) = delete;
+    /// Assignment operator (disabled)
+    void operator=(const TraceSpan &) = delete;
+};
+
+#endif //CANADIANEXPERIENCE_TRACE_H
@@ -13,6 +13,7 @@
 #include "Actor.h"
 #include "AdapterMachineDrawable.h"
 #include "Drawable.h"
+#include "Trace.h"
 
 /// A scaling factor, converts mouse motion to rotation in radians
 const double RotationScaling = 0.02;
@@ -21,7 +22,7 @@ const double RotationScaling = 0.02;
  * Constructor
  * @param parent Pointer to wxFrame object, the main frame for the application
  */
-ViewEdit::ViewEdit(wxFrame* parent) :wxScrolledCanvas(parent, wxID_ANY)
+ViewEdit::ViewEdit(wxFrame* parent) :wxScrolledCanvas(parent, wxID_ANY), mRepaint(this)
 {
     SetBackgroundStyle(wxBG_STYLE_PAINT);
 
@@ -41,14 +42,32 @@ ViewEdit::ViewEdit(wxFrame* parent) :wxScrolledCanvas(parent, wxID_ANY)
     parent->Bind(wxEVT_COMMAND_MENU_SELECTED, &ViewEdit::OnMachine1Start, this, XRCID("SetMachine1Start"));
     parent->Bind(wxEVT_COMMAND_MENU_SELECTED, &ViewEdit::OnMachine2Start, this, XRCID("SetMachine2Start"));
 
+    // Moving the time pointer alone does not change what we draw
+    Subscribe(ChangeGeometry | ChangeMachines | ChangeTimeline);
 }
 
 /**
- * Force an update of this window when the picture changes.
+ * Schedule an update of this window when the picture changes.
  */
 void ViewEdit::UpdateObserver()
 {
-    Refresh();
+    mRepaint.Request();
+}
+
+/**
+ * Schedule a repaint of the part of the window a change affects.
+ * @param changes Mask of the PictureChange values that changed
+ * @param region Part of the picture affected, empty if not known
+ */
+void ViewEdit::OnPictureChanged(int changes, const wxRect &region)
+{
+    if (region.IsEmpty())
+    {
+        mRepaint.Request();
+        return;
+    }
+
+    mRepaint.Request(wxRect(CalcScrolledPosition(region.GetPosition()), region.GetSize()));
 }
 
 
@@ -59,6 +78,8 @@ void ViewEdit::UpdateObserver()
  */
 void ViewEdit::OnPaint(wxPaintEvent& event)
 {
+    TraceSpan span("ViewEdit::OnPaint");
+
     auto size = GetPicture()->GetSize();
     SetVirtualSize(size.GetWidth(), size.GetHeight());
     SetScrollRate(1, 1);
@@ -73,7 +94,21 @@ void ViewEdit::OnPaint(wxPaintEvent& event)
     // Create a graphics context
     auto graphics = std::shared_ptr<wxGraphicsContext>(wxGraphicsContext::Create( dc ));
 
-    GetPicture()->Draw(graphics);
+    // During prerendered playback the worker owns the
+    // picture and we only draw the frame presented
+    auto prerenderer = GetPicture()->GetPrerenderer();
+    if (prerenderer->IsRunning())
+    {
+        if (prerenderer->GetPresentedFrame() >= 0)
+        {
+            graphics->DrawBitmap(prerenderer->GetPresented(), 0, 0, size.GetWidth(), size.GetHeight());
+        }
+        return;
+    }
+
+    // Only what is scrolled into view is drawn
+    wxRect viewport(CalcUnscrolledPosition(wxPoint(0, 0)), GetClientSize());
+    GetPicture()->Draw(graphics, viewport);
 }
 
 /**
@@ -82,6 +117,8 @@ void ViewEdit::OnPaint(wxPaintEvent& event)
  */
 void ViewEdit::OnLeftDown(wxMouseEvent &event)
 {
+    GetPicture()->GetPrerenderer()->Stop();
+
     auto click = CalcUnscrolledPosition(event.GetPosition());
     mLastMouse = click;
 
@@ -89,20 +126,10 @@ void ViewEdit::OnLeftDown(wxMouseEvent &event)
     // Did we hit anything?
     //
 
+    // The picture finds the last drawn drawable under the
+    // mouse, since it will be on top.
     std::shared_ptr<Actor> hitActor;
-    std::shared_ptr<Drawable> hitDrawable;
-    for (auto actor : *GetPicture())
-    {
-        // Note: We do not exit when we get the first hit, since
-        // we are looking at these in drawing order. Instead, we
-        // keep the last hit.
-        std::shared_ptr<Drawable> drawable = actor->HitTest(wxPoint(click.x, click.y));
-        if (drawable != nullptr)
-        {
-            hitActor = actor;
-            hitDrawable = drawable;
-        }
-    }
+    std::shared_ptr<Drawable> hitDrawable = GetPicture()->HitTest(wxPoint(click.x, click.y), hitActor);
 
     // If we hit something determine what we do with it based on the
     // current mode.
@@ -136,11 +163,17 @@ void ViewEdit::OnMouseMove(wxMouseEvent &event)
 
     if (event.LeftIsDown())
     {
+        if (mSelectedDrawable != nullptr)
+        {
+            GetPicture()->GetPrerenderer()->Stop();
+        }
+
         switch (mMode)
         {
         case Mode::Move:
             if (mSelectedDrawable != nullptr)
             {
+                auto before = mSelectedActor->GetBounds();
                 if (mSelectedDrawable->IsMovable())
                 {
                     mSelectedDrawable->Move(delta);
@@ -149,15 +182,18 @@ void ViewEdit::OnMouseMove(wxMouseEvent &event)
                 {
                     mSelectedActor->SetPosition(mSelectedActor->GetPosition() + delta);
                 }
-                GetPicture()->UpdateObservers();
+                GetPicture()->UpdateObservers(ChangeGeometry,
+                        Picture::ChangedRegion(before, mSelectedActor->GetBounds()));
             }
             break;
 
         case Mode::Rotate:
             if (mSelectedDrawable != nullptr)
             {
+                auto before = mSelectedActor->GetBounds();
                 mSelectedDrawable->SetRotation(mSelectedDrawable->GetRotation() + delta.y * RotationScaling);
-                GetPicture()->UpdateObservers();
+                GetPicture()->UpdateObservers(ChangeGeometry,
+                        Picture::ChangedRegion(before, mSelectedActor->GetBounds()));
             }
             break;
 
@@ -224,8 +260,9 @@ void ViewEdit::OnUpdateEditRotate(wxUpdateUIEvent& event)
  */
 void ViewEdit::OnMachine1Number(wxCommandEvent& event)
 {
+    GetPicture()->GetPrerenderer()->Stop();
     if(GetPicture()->GetMachineAdapter(1)->SetMachineNumber(GetParent()))
-        GetPicture()->UpdateObservers();
+        GetPicture()->UpdateObservers(ChangeMachines);
 }
 
 /**
@@ -234,8 +271,9 @@ void ViewEdit::OnMachine1Number(wxCommandEvent& event)
  */
 void ViewEdit::OnMachine2Number(wxCommandEvent& event)
 {
+    GetPicture()->GetPrerenderer()->Stop();
     if (GetPicture()->GetMachineAdapter(2)->SetMachineNumber(GetParent()))
-        GetPicture()->UpdateObservers();
+        GetPicture()->UpdateObservers(ChangeMachines);
 }
 
 /**
@@ -244,8 +282,9 @@ void ViewEdit::OnMachine2Number(wxCommandEvent& event)
  */
 void ViewEdit::OnMachine1Start(wxCommandEvent& event)
 {
+    GetPicture()->GetPrerenderer()->Stop();
     if (GetPicture()->GetMachineAdapter(1)->SetMachineStart(GetParent()))
-        GetPicture()->UpdateObservers();
+        GetPicture()->UpdateObservers(ChangeMachines);
 }
 
 /**
@@ -254,6 +293,7 @@ void ViewEdit::OnMachine1Start(wxCommandEvent& event)
  */
 void ViewEdit::OnMachine2Start(wxCommandEvent& event)
 {
+    GetPicture()->GetPrerenderer()->Stop();
     if (GetPicture()->GetMachineAdapter(2)->SetMachineStart(GetParent()))
-        GetPicture()->UpdateObservers();
+        GetPicture()->UpdateObservers(ChangeMachines);
 }
@@ -12,6 +12,7 @@
 #define CANADIANEXPERIENCE_VIEWEDIT_H
 
 #include "PictureObserver.h"
+#include "RepaintScheduler.h"
 
 class Actor;
 class Drawable;
@@ -45,6 +46,9 @@ private:
     /// The currently selected drawable
     std::shared_ptr<Drawable> mSelectedDrawable;
 
+    /// Coalesces repaints when the picture changes
+    RepaintScheduler mRepaint;
+
 public:
     /// The current mouse mode
     enum class Mode {Move, Rotate};
@@ -56,6 +60,7 @@ public:
     ViewEdit(wxFrame* parent);
 
     void UpdateObserver() override;
+    void OnPictureChanged(int changes, const wxRect &region) override;
 
 
 };
@@ -7,33 +7,21 @@
 
 #include <wx/dcbuffer.h>
 #include <wx/xrc/xmlres.h>
-#include <sstream>
 
 #include "ViewTimeline.h"
 #include "TimelineDlg.h"
 #include "Picture.h"
 #include "Actor.h"
+#include "Trace.h"
 
-/// Y location for the top of a tick mark
-const int TickTop = 15;
+/// Y location for the top of the keyframe track, above the ticks
+const int KeyframeTrackTop = 2;
 
-/// The spacing between ticks in the timeline
-const int TickSpacing = 4;
+/// Height of the tallest bar in the keyframe track
+const int KeyframeTrackHeight = TickTop - 4;
 
-/// The length of a short tick mark
-const int TickShort = 10;
-
-/// The length of a long tick mark
-const int TickLong = 20;
-
-/// Size of the tick mark labels
-const int TickFontSize = 15;
-
-/// Space to the left of the scale
-const int BorderLeft = 10;
-
-/// Space to the right of the scale
-const int BorderRight = 10;
+/// Colour of the keyframe track bars
+const wxColour KeyframeTrackColour(90, 90, 160);
 
 /// Filename for the pointer image
 const std::wstring PointerImageFile = L"/pointer.png";
@@ -49,7 +37,8 @@ ViewTimeline::ViewTimeline(wxFrame* parent, std::wstring imagesDir) :
             wxID_ANY,
             wxDefaultPosition,
             wxSize(100, Height),
-            wxBORDER_SIMPLE)
+            wxBORDER_SIMPLE),
+    mRepaint(this)
 {
     SetBackgroundStyle(wxBG_STYLE_PAINT);
 
@@ -71,17 +60,55 @@ ViewTimeline::ViewTimeline(wxFrame* parent, std::wstring imagesDir) :
     parent->Bind(wxEVT_COMMAND_MENU_SELECTED, &ViewTimeline::OnPlayPlayFromBeginning, this, XRCID("PlayPlayFromBeginning"));
 
     mTimer.SetOwner(this);
-    mStopWatch.Start(0);
-    mStopWatch.Pause();
+
+    // Dragging things around in the picture does not change what we draw
+    Subscribe(ChangeTime | ChangeKeyframes | ChangeTimeline);
 }
 
 /**
- * Force an update of this window when the picture changes.
+ * Schedule an update of this window when the picture changes.
  */
 void ViewTimeline::UpdateObserver()
 {
-    Refresh();
-    Update();
+    mRepaint.Request();
+}
+
+/**
+ * Schedule a repaint for a change to the picture.
+ *
+ * When the time is all that changed that we draw just
+ * the pointer is repainted, where it was and where it is now.
+ * @param changes Mask of the PictureChange values that changed
+ * @param region Part of the picture affected, not used here
+ */
+void ViewTimeline::OnPictureChanged(int changes, const wxRect &region)
+{
+    if ((changes & ~(ChangeTime | ChangeGeometry)) != 0 || mPointerImage == nullptr)
+    {
+        mRepaint.Request();
+        return;
+    }
+
+    Timeline *timeline = GetPicture()->GetTimeline();
+    int x = BorderLeft + (int)(GetPointerTime() * timeline->GetFrameRate() * TickSpacing);
+    mRepaint.Request(PointerRect(mPointerX));
+    mRepaint.Request(PointerRect(x));
+}
+
+/**
+ * The rectangle the pointer covers in window coordinates
+ * @param x X location of the pointer on the timeline
+ * @return Rectangle to repaint for the pointer
+ */
+wxRect ViewTimeline::PointerRect(int x)
+{
+    int pw = mPointerImage->GetWidth();
+    int ph = mPointerImage->GetHeight();
+    wxRect rect(x - pw / 2, TickTop, pw, ph);
+    rect.SetPosition(CalcScrolledPosition(rect.GetPosition()));
+
+    // Room for the pointer's antialiased edges
+    return rect.Inflate(1);
 }
 
 /**
@@ -90,6 +117,8 @@ void ViewTimeline::UpdateObserver()
  */
 void ViewTimeline::OnPaint(wxPaintEvent& event)
 {
+    TraceSpan span("ViewTimeline::OnPaint");
+
     // Get the timeline
     Timeline *timeline = GetPicture()->GetTimeline();
     int sizeTotal = timeline->GetNumFrames() * TickSpacing + BorderLeft + BorderRight, WindowHeight;
@@ -111,54 +140,91 @@ void ViewTimeline::OnPaint(wxPaintEvent& event)
         mPointerBitmap = graphics->CreateBitmapFromImage(*mPointerImage);
     }
 
-    auto rect = GetClientRect();
-    int hit = rect.GetHeight();
-    int wid = rect.GetWidth();
-
-    wxFont font(wxSize(0, TickFontSize),
-            wxFONTFAMILY_SWISS,
-            wxFONTSTYLE_NORMAL,
-            wxFONTWEIGHT_NORMAL);
-    graphics->SetFont(font, *wxBLACK);
-    graphics->SetPen(*wxBLACK_PEN);
-
     int top = TickTop;
 
+    // Only the part of the ruler that needs repainting is drawn
+    wxRect update = GetUpdateRegion().GetBox();
+    update.SetPosition(CalcUnscrolledPosition(update.GetPosition()));
 
-    for (int tickNum = 0; tickNum <= timeline->GetNumFrames(); tickNum++)
-    {
-        int x = BorderLeft + tickNum * TickSpacing;
-        int bottom = top + TickShort;
-
-        bool onSecond = (tickNum % timeline->GetFrameRate()) == 0;
-        if (onSecond)
-        {
-            bottom = top + TickLong;
-
-            // Convert the tick number to seconds in a string
-            std::wstringstream str;
-            str << tickNum / timeline->GetFrameRate();
-            std::wstring wstr = str.str();
-
-            double w, h;
-            graphics->GetTextExtent(wstr, &w, &h);
-
-            graphics->DrawText(wstr, x - w / 2, bottom + 5);
-        }
-
-        graphics->StrokeLine(x, bottom, x, top);
-    }
+    mRuler.SetTimeline(timeline->GetNumFrames(), timeline->GetFrameRate());
+    mRuler.Draw(graphics, update.GetLeft(), update.GetRight());
+    DrawKeyframes(graphics, update.GetLeft(), update.GetRight());
 
     //
     // Draw the pointer
     //
     int pw = mPointerImage->GetWidth();
     int ph = mPointerImage->GetHeight();
-    int x = BorderLeft + (int)(timeline->GetCurrentTime() * timeline->GetFrameRate() * TickSpacing);
+    int x = BorderLeft + (int)(GetPointerTime() * timeline->GetFrameRate() * TickSpacing);
     graphics->DrawBitmap(mPointerBitmap,
             x - pw / 2, top,
             pw, ph
     );
+    mPointerX = x;
+}
+
+/**
+ * Get the time the pointer shows.
+ *
+ * During prerendered playback the timeline belongs to the
+ * worker, so this is the time of the frame presented.
+ * @return Time in seconds
+ */
+double ViewTimeline::GetPointerTime()
+{
+    Timeline *timeline = GetPicture()->GetTimeline();
+    auto prerenderer = GetPicture()->GetPrerenderer();
+    if (prerenderer->IsRunning())
+    {
+        return (double)std::max(0, prerenderer->GetPresentedFrame()) / timeline->GetFrameRate();
+    }
+
+    return timeline->GetCurrentTime();
+}
+
+/**
+ * Draw the keyframe track.
+ *
+ * Each frame in view gets a bar as tall as the number of
+ * keyframes on it, relative to the frame with the most
+ * keyframes. The work depends on how many frames are in
+ * view, not on how many keyframes there are.
+ * @param graphics Graphics context to draw on, in timeline coordinates
+ * @param left Left edge of the area to draw in pixels
+ * @param right Right edge of the area to draw in pixels, inclusive
+ */
+void ViewTimeline::DrawKeyframes(std::shared_ptr<wxGraphicsContext> graphics, int left, int right)
+{
+    Timeline *timeline = GetPicture()->GetTimeline();
+    auto &summary = timeline->GetKeyframeSummary();
+
+    int first, last;
+    int most = summary.GetTotal().max;
+    if (most == 0 || !TimelineRuler::TickRange(left - TickSpacing, right + TickSpacing,
+            timeline->GetNumFrames(), first, last))
+    {
+        return;
+    }
+
+    if (summary.Summarize(first, last + 1).count == 0)
+    {
+        return;
+    }
+
+    graphics->SetPen(*wxTRANSPARENT_PEN);
+    graphics->SetBrush(wxBrush(KeyframeTrackColour));
+
+    for (int frame = first; frame <= last; frame++)
+    {
+        int count = summary.Summarize(frame, frame + 1).count;
+        if (count > 0)
+        {
+            int x = BorderLeft + frame * TickSpacing;
+            int height = std::max(1, KeyframeTrackHeight * count / most);
+            graphics->DrawRectangle(x - TickSpacing / 2, KeyframeTrackTop + KeyframeTrackHeight - height,
+                    std::max(1, TickSpacing - 1), height);
+        }
+    }
 }
 
 /**
@@ -173,7 +239,7 @@ void ViewTimeline::OnLeftDown(wxMouseEvent &event)
 
     // Get the timeline
     Timeline *timeline = GetPicture()->GetTimeline();
-    int pointerX = (int)(timeline->GetCurrentTime() * timeline->GetFrameRate() * TickSpacing + BorderLeft);
+    int pointerX = (int)(GetPointerTime() * timeline->GetFrameRate() * TickSpacing + BorderLeft);
 
     mMovingPointer = x >= pointerX - (int)mPointerImage->GetWidth() / 2 && x <= pointerX + (int)mPointerImage->GetWidth() / 2;
 }
@@ -198,6 +264,8 @@ void ViewTimeline::OnMouseMove(wxMouseEvent &event)
     Timeline *timeline = GetPicture()->GetTimeline();
     if (mMovingPointer && event.LeftIsDown())
     {
+        GetPicture()->GetPrerenderer()->Stop();
+
         double time = (double)(click.x - BorderLeft) / (timeline->GetFrameRate() * TickSpacing);
         if (time < 0)
         {
@@ -225,10 +293,12 @@ void ViewTimeline::OnMouseMove(wxMouseEvent &event)
  */
 void ViewTimeline::OnEditTimelineProperties(wxCommandEvent& event)
 {
+    GetPicture()->GetPrerenderer()->Stop();
+
     TimelineDlg dlg(this->GetParent(), GetPicture()->GetTimeline());
     if(dlg.ShowModal() == wxID_OK)
     {
-        GetPicture()->UpdateObservers();
+        GetPicture()->UpdateObservers(ChangeTimeline);
     }
 }
 
@@ -239,10 +309,13 @@ void ViewTimeline::OnEditTimelineProperties(wxCommandEvent& event)
 void ViewTimeline::OnEditSetKeyframe(wxCommandEvent& event)
 {
     auto picture = GetPicture();
+    picture->GetPrerenderer()->Stop();
     for (auto actor : *picture)
     {
         actor->SetKeyframe();
     }
+
+    picture->UpdateObservers(ChangeKeyframes);
 }
 
 /**
@@ -252,8 +325,10 @@ void ViewTimeline::OnEditSetKeyframe(wxCommandEvent& event)
 void ViewTimeline::OnEditDeleteKeyframe(wxCommandEvent& event)
 {
     auto picture = GetPicture();
+    picture->GetPrerenderer()->Stop();
 
     picture->GetTimeline()->ClearKeyframe();
+    picture->UpdateObservers(ChangeKeyframes);
     picture->SetAnimationTime(picture->GetAnimationTime());
 }
 
@@ -263,7 +338,7 @@ void ViewTimeline::OnEditDeleteKeyframe(wxCommandEvent& event)
  */
 void ViewTimeline::OnPlayPlay(wxCommandEvent& event)
 {
-    if(mPlaying)
+    if(mClock.IsRunning())
     {
         // If already playing
         return;
@@ -274,8 +349,8 @@ void ViewTimeline::OnPlayPlay(wxCommandEvent& event)
     auto frameRate = timeline->GetFrameRate();
     auto time = timeline->GetCurrentTime();
 
-    mStopWatch.Start(lround(time * 1000));
-    mTimer.Start(1000 / frameRate);
+    mClock.Start(time, frameRate);
+    mTimer.StartOnce(1);
 }
 
 /**
@@ -284,7 +359,7 @@ void ViewTimeline::OnPlayPlay(wxCommandEvent& event)
  */
 void ViewTimeline::OnPlayPlayFromBeginning(wxCommandEvent& event)
 {
-    if(mPlaying)
+    if(mClock.IsRunning())
     {
         Stop();
     }
@@ -295,8 +370,8 @@ void ViewTimeline::OnPlayPlayFromBeginning(wxCommandEvent& event)
 
     auto frameRate = timeline->GetFrameRate();
 
-    mStopWatch.Start(0);
-    mTimer.Start(1000 / frameRate);
+    mClock.Start(0, frameRate);
+    mTimer.StartOnce(1);
 }
 
 /**
@@ -310,24 +385,58 @@ void ViewTimeline::OnPlayStop(wxCommandEvent& event)
 
 
 /**
- * Handle timer events
+ * Handle timer events.
+ *
+ * Presents the frame that is due now, skipping any that
+ * came due while the last one was presented, then waits
+ * for the next frame to come due.
  * @param event timer event
  */
 void ViewTimeline::OnTimer(wxTimerEvent& event)
 {
-    auto timeline = GetPicture()->GetTimeline();
+    if (!mClock.IsRunning())
+    {
+        return;
+    }
 
-    auto newTime = mStopWatch.Time() / 1000.0;
-    auto frameRate = timeline->GetFrameRate();
+    auto timeline = GetPicture()->GetTimeline();
 
-    int frame = (int)lround(newTime * frameRate);
+    int frame = mClock.Tick(mClock.GetElapsed());
     if(frame >= timeline->GetNumFrames())
     {
-        frame = timeline->GetNumFrames();
         Stop();
+        GetPicture()->SetAnimationTime(timeline->GetDuration());
+        return;
     }
 
-    GetPicture()->SetAnimationTime(newTime);
+    auto prerenderer = GetPicture()->GetPrerenderer();
+    if (frame >= 0 && prerenderer->IsEnabled())
+    {
+        if (!prerenderer->IsRunning())
+        {
+            // Just started, or an edit stopped the worker and
+            // threw away what it had rendered ahead
+            prerenderer->Start(frame);
+            prerenderer->WaitFor(frame);
+        }
+
+        if (prerenderer->Present(frame))
+        {
+            GetPicture()->UpdateObservers(ChangeTime | ChangeGeometry);
+        }
+        else
+        {
+            mClock.Drop();
+        }
+    }
+    else if (frame >= 0)
+    {
+        // Prerendering may have been turned off while playing
+        prerenderer->Stop();
+        GetPicture()->SetAnimationTime((double)frame / mClock.GetFrameRate());
+    }
+
+    mTimer.StartOnce(mClock.NextDelay(mClock.GetElapsed()));
 }
 
 
@@ -336,9 +445,14 @@ void ViewTimeline::OnTimer(wxTimerEvent& event)
  */
 void ViewTimeline::Stop()
 {
-    mPlaying = false;
     mTimer.Stop();
-    mStopWatch.Pause();
+    GetPicture()->GetPrerenderer()->Stop();
+    if (mClock.IsRunning())
+    {
+        mClock.Stop();
+        wxLogStatus(L"Played %d frames, %d dropped, %d late",
+                mClock.GetPresented(), mClock.GetDropped(), mClock.GetLate());
+    }
 }
 
 
@@ -349,13 +463,15 @@ void ViewTimeline::Stop()
 void ViewTimeline::OnFileSaveAs(wxCommandEvent& event)
 {
     wxFileDialog saveFileDialog(this, _("Save Animation file"), "", "",
-            "Animation Files (*.anim)|*.anim", wxFD_SAVE|wxFD_OVERWRITE_PROMPT);
+            "Animation Files (*.anim)|*.anim|Binary Animation Files (*.animb)|*.animb",
+            wxFD_SAVE|wxFD_OVERWRITE_PROMPT);
     if (saveFileDialog.ShowModal() == wxID_CANCEL)
     {
         return;
     }
 
     auto filename = saveFileDialog.GetPath();
+    GetPicture()->GetPrerenderer()->Stop();
     GetPicture()->Save(filename);
 }
 
@@ -366,13 +482,18 @@ void ViewTimeline::OnFileSaveAs(wxCommandEvent& event)
 void ViewTimeline::OnFileOpen(wxCommandEvent& event)
 {
     wxFileDialog loadFileDialog(this, _("Load Animation file"), "", "",
-            "Animation Files (*.anim)|*.anim", wxFD_OPEN);
+            "Animation Files (*.anim;*.animb)|*.anim;*.animb", wxFD_OPEN);
     if (loadFileDialog.ShowModal() == wxID_CANCEL)
     {
         return;
     }
 
     auto filename = loadFileDialog.GetPath();
-    GetPicture()->Load(filename);
+    Stop();
+    if (!GetPicture()->Load(filename))
+    {
+        wxMessageBox(L"Unable to load Animation file");
+    }
+
     Refresh();
 }
\ No newline at end of file
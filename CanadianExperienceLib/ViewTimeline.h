@@ -9,6 +9,9 @@
 #define CANADIANEXPERIENCE_VIEWTIMELINE_H
 
 #include "PictureObserver.h"
+#include "RepaintScheduler.h"
+#include "TimelineRuler.h"
+#include "PlaybackClock.h"
 
 /**
  * View class for the timeline area of the screen.
@@ -30,23 +33,33 @@ private:
     void OnFileSaveAs(wxCommandEvent& event);
     void OnFileOpen(wxCommandEvent& event);
 
+    wxRect PointerRect(int x);
+    double GetPointerTime();
+    void DrawKeyframes(std::shared_ptr<wxGraphicsContext> graphics, int left, int right);
+
     /// Bitmap image for the pointer
     std::unique_ptr<wxImage> mPointerImage;
 
     /// Graphics bitmap to display
     wxGraphicsBitmap mPointerBitmap;
 
+    /// Where the pointer was last drawn on the timeline
+    int mPointerX = BorderLeft;
+
+    /// The tick mark ruler, cached in strips
+    TimelineRuler mRuler;
+
     /// Flag to indicate we are moving the pointer
     bool mMovingPointer = false;
 
-    /// The timer that allows for playing the animation
+    /// The timer that presents the next frame when it is due
     wxTimer mTimer;
 
-    /// Stopwatch used to measure elapsed time
-    wxStopWatch mStopWatch;
+    /// Paces playback and counts dropped and late frames
+    PlaybackClock mClock;
 
-    /// Are we playing?
-    bool mPlaying = false;
+    /// Coalesces repaints when the picture changes
+    RepaintScheduler mRepaint;
 
 public:
     static const int Height = 90;      ///< Height to make this window
@@ -55,11 +68,19 @@ public:
     ViewTimeline(wxFrame* parent, std::wstring imagesDir);
 
     void UpdateObserver() override;
+    void OnPictureChanged(int changes, const wxRect &region) override;
 
 
 
     void Stop();
 
+    /**
+     * Get the playback clock, which has the frame
+     * statistics for the current or last playback
+     * @return Playback clock
+     */
+    const PlaybackClock &GetPlaybackClock() const { return mClock; }
+
 
 };
 
@@ -0,0 +1,207 @@
+/**
+ * @file main.cpp
+ * @author Shawn_Porto
+ *
+ * Renders frames of an animation to images without a window.
+ *
+ * The scene is the one the application shows, built by the
+ * PictureFactory, with the animation file loaded into it.
+ * Frames are written as a numbered PNG sequence or as one
+ * raw stream of 8 bit RGBA pixels, frame after frame.
+ */
+
+#include <pch.h>
+#include <wx/init.h>
+#include <wx/cmdline.h>
+#include <wx/filename.h>
+
+#include <cstdio>
+#include <thread>
+
+#include <Picture.h>
+#include <PictureFactory.h>
+#include <Timeline.h>
+#include <BatchRenderer.h>
+
+/// File name pattern of the PNG sequence unless given
+const wxString DefaultPngPattern = L"frame%05d.png";
+
+/// Output of the raw stream unless given, standard output
+const wxString StandardOutput = L"-";
+
+/// The command line options
+static const wxCmdLineEntryDesc CommandLine[] = {
+    {wxCMD_LINE_SWITCH, "h", "help", "show this help", wxCMD_LINE_VAL_NONE, wxCMD_LINE_OPTION_HELP},
+    {wxCMD_LINE_OPTION, "r", "resources", "resources directory, the directory of this program if not given"},
+    {wxCMD_LINE_OPTION, "s", "start", "first frame to render, 0 if not given", wxCMD_LINE_VAL_NUMBER},
+    {wxCMD_LINE_OPTION, "e", "end", "last frame to render, the end of the animation if not given", wxCMD_LINE_VAL_NUMBER},
+    {wxCMD_LINE_OPTION, "j", "threads", "number of threads, one for each core if not given", wxCMD_LINE_VAL_NUMBER},
+    {wxCMD_LINE_OPTION, "o", "output", "PNG file name pattern such as frame%05d.png, or the raw stream file, - for standard output"},
+    {wxCMD_LINE_SWITCH, nullptr, "raw", "write a raw RGBA stream instead of PNG files"},
+    {wxCMD_LINE_OPTION, nullptr, "scale", "resolution relative to the picture size, 1 if not given", wxCMD_LINE_VAL_DOUBLE},
+    {wxCMD_LINE_PARAM, nullptr, nullptr, "animation file", wxCMD_LINE_VAL_STRING},
+    wxCMD_LINE_DESC_END
+};
+
+/**
+ * Create the application's scene with an animation loaded
+ * @param resourcesDir Resources directory
+ * @param animation Animation file to load
+ * @return The picture, nullptr if the animation could not be loaded
+ */
+static std::shared_ptr<Picture> CreatePicture(const std::wstring &resourcesDir, const wxString &animation)
+{
+    PictureFactory factory;
+    auto picture = factory.Create(resourcesDir);
+    if (!picture->Load(animation))
+    {
+        fprintf(stderr, "Unable to load animation file %s\n", (const char *)animation.utf8_str());
+        return nullptr;
+    }
+
+    return picture;
+}
+
+/**
+ * Main entry point. Nothing here creates a window or
+ * runs an event loop, so no display is needed.
+ * @param argc Number of arguments
+ * @param argv The arguments
+ * @return 0 if every frame was written
+ */
+int main(int argc, char **argv)
+{
+    // Images, graphics contexts and the render threads
+    // all need the toolkit initialized first
+    wxInitializer initializer(argc, argv);
+    if (!initializer.IsOk())
+    {
+        fprintf(stderr, "Unable to initialize wxWidgets\n");
+        return 1;
+    }
+
+    wxInitAllImageHandlers();
+
+    wxCmdLineParser parser(CommandLine, argc, argv);
+    if (parser.Parse() != 0)
+    {
+        return 1;
+    }
+
+    wxString animation = parser.GetParam(0);
+    if (!wxFileExists(animation))
+    {
+        fprintf(stderr, "Animation file %s does not exist\n", (const char *)animation.utf8_str());
+        return 1;
+    }
+
+    wxString resourcesDir;
+    if (!parser.Found(L"r", &resourcesDir))
+    {
+        resourcesDir = wxFileName(wxString(argv[0])).GetPath();
+        if (resourcesDir.IsEmpty())
+        {
+            resourcesDir = L".";
+        }
+    }
+
+    // Missing images and music would be reported in message boxes
+    if (!wxDirExists(resourcesDir + L"/images") || !wxDirExists(resourcesDir + L"/audio"))
+    {
+        fprintf(stderr, "%s is not a resources directory\n", (const char *)resourcesDir.utf8_str());
+        return 1;
+    }
+
+    // A picture to find out how long the animation is
+    auto picture = CreatePicture(resourcesDir.ToStdWstring(), animation);
+    if (picture == nullptr)
+    {
+        return 1;
+    }
+
+    int numFrames = picture->GetTimeline()->GetNumFrames();
+    auto size = picture->GetSize();
+    picture.reset();
+
+    long first = 0;
+    long last = numFrames - 1;
+    long threads = std::max(1u, std::thread::hardware_concurrency());
+    double scale = 1;
+    parser.Found(L"s", &first);
+    parser.Found(L"e", &last);
+    parser.Found(L"j", &threads);
+    parser.Found(L"scale", &scale);
+
+    first = std::max(first, 0L);
+    last = std::min(last, (long)numFrames - 1);
+    threads = std::max(threads, 1L);
+    if (last < first)
+    {
+        fprintf(stderr, "There are no frames from %ld to %ld\n", first, last);
+        return 1;
+    }
+
+    bool raw = parser.Found(L"raw");
+    wxString output = raw ? StandardOutput : DefaultPngPattern;
+    parser.Found(L"o", &output);
+
+    FILE *stream = nullptr;
+    if (raw)
+    {
+        stream = output == StandardOutput ? stdout : fopen(output.utf8_str(), "wb");
+        if (stream == nullptr)
+        {
+            fprintf(stderr, "Unable to write %s\n", (const char *)output.utf8_str());
+            return 1;
+        }
+    }
+
+    BatchRenderer renderer([&resourcesDir, &animation]() {
+        return CreatePicture(resourcesDir.ToStdWstring(), animation);
+    });
+    renderer.SetNumThreads((int)threads);
+    renderer.SetScale(scale);
+
+    // The first frame not written yet
+    long stopped = first;
+    std::vector<unsigned char> rgba;
+    bool ok = renderer.Render((int)first, (int)last, [&](int frame, const wxImage &image) {
+        if (raw)
+        {
+            BatchRenderer::ToRgba(image, rgba);
+            if (fwrite(rgba.data(), 1, rgba.size(), stream) != rgba.size())
+            {
+                fprintf(stderr, "Unable to write frame %d\n", frame);
+                return false;
+            }
+        }
+        else
+        {
+            wxString filename = wxString::Format(output, frame);
+            if (!image.SaveFile(filename, wxBITMAP_TYPE_PNG))
+            {
+                fprintf(stderr, "Unable to write %s\n", (const char *)filename.utf8_str());
+                return false;
+            }
+        }
+
+        stopped = frame + 1;
+        return true;
+    });
+
+    if (stream != nullptr && stream != stdout)
+    {
+        fclose(stream);
+    }
+
+    if (!ok)
+    {
+        fprintf(stderr, "Rendering stopped at frame %ld\n", stopped);
+        return 1;
+    }
+
+    fprintf(stderr, "Rendered frames %ld to %ld at %dx%d on %ld threads\n", first, last,
+            std::max(1, (int)(size.GetWidth() * scale)), std::max(1, (int)(size.GetHeight() * scale)),
+            std::min(threads, (last - first) / BatchBlockFrames + 1));
+    return 0;
+}
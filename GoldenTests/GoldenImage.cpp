@@ -0,0 +1,243 @@
+/**
+ * @file GoldenImage.cpp
+ * @author Shawn_Porto
+ */
+
+#include <pch.h>
+#include "gtest/gtest.h"
+
+#include <bitset>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+#include "GoldenImage.h"
+
+/// Width and height of the grid the perceptual hash samples
+const int HashGridSize = 16;
+
+/// Environment variable that records new goldens instead of comparing
+const std::wstring GoldenUpdateVariable = L"GOLDEN_UPDATE";
+
+/**
+ * Get the goldens, loading them from the goldens file the first time
+ * @return Map from golden name to perceptual hash
+ */
+static std::map<std::string, std::string> &Goldens()
+{
+    static std::map<std::string, std::string> goldens;
+    static bool loaded = false;
+
+    if (!loaded)
+    {
+        loaded = true;
+
+        std::ifstream file(GOLDEN_FILE);
+        std::string line;
+        while (std::getline(file, line))
+        {
+            if (line.empty() || line[0] == '#')
+            {
+                continue;
+            }
+
+            std::istringstream stream(line);
+            std::string name, hash;
+            if (stream >> name >> hash)
+            {
+                goldens[name] = hash;
+            }
+        }
+    }
+
+    return goldens;
+}
+
+/**
+ * Write the goldens back to the goldens file
+ */
+static void SaveGoldens()
+{
+    std::ofstream file(GOLDEN_FILE);
+    file << "# Perceptual hashes of the golden frames. Regenerate with GOLDEN_UPDATE=1 GoldenTests_run" << std::endl;
+    for (auto &golden : Goldens())
+    {
+        file << golden.first << " " << golden.second << std::endl;
+    }
+}
+
+/**
+ * Render something into an offscreen image.
+ *
+ * This uses a graphics context on a wxImage, so it
+ * needs no window or display server.
+ * @param size Size of the image in pixels
+ * @param draw Function that does the drawing
+ * @return The rendered image
+ */
+wxImage RenderOffscreen(wxSize size, std::function<void(std::shared_ptr<wxGraphicsContext>)> draw)
+{
+    wxImage image(size.GetWidth(), size.GetHeight());
+    image.SetRGB(wxRect(size), 255, 255, 255);
+
+    {
+        // The image is updated when the context is destroyed
+        auto graphics = std::shared_ptr<wxGraphicsContext>(wxGraphicsContext::Create(image));
+        draw(graphics);
+    }
+
+    return image;
+}
+
+/**
+ * Compute a perceptual (average) hash of an image.
+ *
+ * The image is reduced to a grid of average luminance
+ * values and each cell contributes one bit: whether it
+ * is brighter than the mean.
+ * @param image Image to hash
+ * @return Hash as a string of hex digits
+ */
+std::string PerceptualHash(const wxImage &image)
+{
+    int wid = image.GetWidth();
+    int hit = image.GetHeight();
+
+    double cells[HashGridSize][HashGridSize] = {};
+    int counts[HashGridSize][HashGridSize] = {};
+
+    for (int y = 0; y < hit; y++)
+    {
+        int cy = y * HashGridSize / hit;
+        for (int x = 0; x < wid; x++)
+        {
+            int cx = x * HashGridSize / wid;
+            cells[cy][cx] += 0.299 * image.GetRed(x, y) + 0.587 * image.GetGreen(x, y) + 0.114 * image.GetBlue(x, y);
+            counts[cy][cx]++;
+        }
+    }
+
+    double mean = 0;
+    for (int cy = 0; cy < HashGridSize; cy++)
+    {
+        for (int cx = 0; cx < HashGridSize; cx++)
+        {
+            if (counts[cy][cx] > 0)
+            {
+                cells[cy][cx] /= counts[cy][cx];
+            }
+            mean += cells[cy][cx];
+        }
+    }
+    mean /= HashGridSize * HashGridSize;
+
+    std::ostringstream hash;
+    for (int cy = 0; cy < HashGridSize; cy++)
+    {
+        for (int cx = 0; cx < HashGridSize; cx += 4)
+        {
+            int digit = 0;
+            for (int b = 0; b < 4; b++)
+            {
+                digit = (digit << 1) | (cells[cy][cx + b] > mean ? 1 : 0);
+            }
+            hash << "0123456789abcdef"[digit];
+        }
+    }
+
+    return hash.str();
+}
+
+/**
+ * Number of bits that differ between two perceptual hashes
+ * @param hash1 First hash
+ * @param hash2 Second hash
+ * @return Hamming distance, or the number of bits in the longer hash if the lengths differ
+ */
+int HashDistance(const std::string &hash1, const std::string &hash2)
+{
+    if (hash1.size() != hash2.size())
+    {
+        return (int)std::max(hash1.size(), hash2.size()) * 4;
+    }
+
+    int distance = 0;
+    for (size_t i = 0; i < hash1.size(); i++)
+    {
+        int d1 = std::stoi(hash1.substr(i, 1), nullptr, 16);
+        int d2 = std::stoi(hash2.substr(i, 1), nullptr, 16);
+        distance += (int)std::bitset<4>(d1 ^ d2).count();
+    }
+
+    return distance;
+}
+
+/**
+ * Count the pixels that differ between two images
+ * @param image1 First image
+ * @param image2 Second image
+ * @return Number of pixels with any channel different, or -1 if the sizes differ
+ */
+int CountDifferentPixels(const wxImage &image1, const wxImage &image2)
+{
+    if (image1.GetSize() != image2.GetSize())
+    {
+        return -1;
+    }
+
+    auto data1 = image1.GetData();
+    auto data2 = image2.GetData();
+    int numPixels = image1.GetWidth() * image1.GetHeight();
+
+    int different = 0;
+    for (int i = 0; i < numPixels; i++)
+    {
+        if (data1[i * 3] != data2[i * 3] ||
+            data1[i * 3 + 1] != data2[i * 3 + 1] ||
+            data1[i * 3 + 2] != data2[i * 3 + 2])
+        {
+            different++;
+        }
+    }
+
+    return different;
+}
+
+/**
+ * Compare an image to its golden.
+ *
+ * With GOLDEN_UPDATE set the golden is recorded instead.
+ * A test without a recorded golden fails, so a golden that
+ * was never recorded cannot pass unnoticed. When the
+ * comparison fails the image is written to name-actual.png
+ * in the working directory for inspection.
+ * @param name Name of the golden
+ * @param image Rendered image
+ */
+void CheckGolden(const std::string &name, const wxImage &image)
+{
+    auto hash = PerceptualHash(image);
+    auto &goldens = Goldens();
+
+    if (wxGetEnv(GoldenUpdateVariable, nullptr))
+    {
+        goldens[name] = hash;
+        SaveGoldens();
+        return;
+    }
+
+    auto golden = goldens.find(name);
+    if (golden == goldens.end())
+    {
+        ADD_FAILURE() << "No golden recorded for " << name << ", run with GOLDEN_UPDATE=1 to record it";
+        return;
+    }
+
+    int distance = HashDistance(golden->second, hash);
+    if (distance > GoldenHashTolerance)
+    {
+        image.SaveFile(name + "-actual.png", wxBITMAP_TYPE_PNG);
+    }
+
+    EXPECT_LE(distance, GoldenHashTolerance) << "Golden " << name << " expected " << golden->second << " got " << hash;
+}
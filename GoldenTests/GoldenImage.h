@@ -0,0 +1,39 @@
+/**
+ * @file GoldenImage.h
+ * @author Shawn_Porto
+ *
+ * Offscreen rendering and golden image comparison for the golden tests.
+ *
+ * Goldens are stored as perceptual hashes in goldens.txt so small
+ * antialiasing differences between Cairo versions do not fail the
+ * tests while real changes in what is drawn do. Run the tests with
+ * the GOLDEN_UPDATE environment variable set to record new goldens.
+ */
+
+#ifndef CANADIANEXPERIENCE_GOLDENIMAGE_H
+#define CANADIANEXPERIENCE_GOLDENIMAGE_H
+
+#include <functional>
+#include <memory>
+#include <string>
+
+/// Resources directory relative to the test working directory
+const std::wstring GoldenResourcesDir = L".";
+
+/// Frame rate the goldens are rendered at
+const int GoldenFrameRate = 30;
+
+/// Largest Hamming distance between perceptual hashes that still matches
+const int GoldenHashTolerance = 6;
+
+wxImage RenderOffscreen(wxSize size, std::function<void(std::shared_ptr<wxGraphicsContext>)> draw);
+
+std::string PerceptualHash(const wxImage &image);
+
+int HashDistance(const std::string &hash1, const std::string &hash2);
+
+int CountDifferentPixels(const wxImage &image1, const wxImage &image2);
+
+void CheckGolden(const std::string &name, const wxImage &image);
+
+#endif //CANADIANEXPERIENCE_GOLDENIMAGE_H
@@ -0,0 +1,70 @@
+/**
+ * @file GoldenMachineTest.cpp
+ * @author Shawn_Porto
+ *
+ * Golden frames for machines 1 and 2
+ */
+
+#include <pch.h>
+#include "gtest/gtest.h"
+
+#include <machine-api.h>
+
+#include "GoldenImage.h"
+
+/// Size of the machine golden images
+const wxSize MachineImageSize(600, 600);
+
+/// Where the machine is placed in the golden images
+const wxPoint MachineLocation(300, 550);
+
+/// Frames the machines are checked at
+const int MachineFrames[] = {0, 15, 45, 90, 150, 300};
+
+/**
+ * Render a machine at a frame, playing it forward from the start
+ * @param machineNumber Machine to render
+ * @param frame Frame to render
+ * @return The rendered image
+ */
+static wxImage RenderMachineFrame(int machineNumber, int frame)
+{
+    MachineSystemFactory factory(GoldenResourcesDir);
+    auto system = factory.CreateMachineSystem();
+    system->ChooseMachine(machineNumber);
+    system->SetFrameRate(GoldenFrameRate);
+    system->SetLocation(MachineLocation);
+
+    system->SetMachineFrame(frame);
+
+    return RenderOffscreen(MachineImageSize, [system](std::shared_ptr<wxGraphicsContext> graphics) {
+        system->DrawMachine(graphics);
+    });
+}
+
+TEST(GoldenMachineTest, Machine1)
+{
+    for (auto frame : MachineFrames)
+    {
+        CheckGolden("machine1-frame" + std::to_string(frame), RenderMachineFrame(1, frame));
+    }
+}
+
+TEST(GoldenMachineTest, Machine2)
+{
+    for (auto frame : MachineFrames)
+    {
+        CheckGolden("machine2-frame" + std::to_string(frame), RenderMachineFrame(2, frame));
+    }
+}
+
+TEST(GoldenMachineTest, HashSensitivity)
+{
+    // The hash has to tell an empty frame from a drawn machine,
+    // otherwise the goldens would prove nothing.
+    auto empty = RenderOffscreen(MachineImageSize, [](std::shared_ptr<wxGraphicsContext> graphics) {});
+    auto machine = RenderMachineFrame(1, 0);
+
+    ASSERT_GT(HashDistance(PerceptualHash(empty), PerceptualHash(machine)), GoldenHashTolerance);
+    ASSERT_EQ(0, HashDistance(PerceptualHash(machine), PerceptualHash(RenderMachineFrame(1, 0))));
+}
@@ -0,0 +1,38 @@
+/**
+ * @file GoldenPictureTest.cpp
+ * @author Shawn_Porto
+ *
+ * Golden frames for the default scene playing the stored animation
+ */
+
+#include <pch.h>
+#include "gtest/gtest.h"
+
+#include <Picture.h>
+#include <PictureFactory.h>
+
+#include "GoldenImage.h"
+
+/// Frames of the stored animation that are checked
+const int PictureFrames[] = {0, 150, 300, 450, 600, 750, 899};
+
+TEST(GoldenPictureTest, MainMovie)
+{
+    ASSERT_TRUE(wxFileExists(GOLDEN_ANIMATION));
+
+    PictureFactory factory;
+    auto picture = factory.Create(GoldenResourcesDir);
+    ASSERT_TRUE(picture->Load(GOLDEN_ANIMATION));
+
+    auto timeline = picture->GetTimeline();
+    for (auto frame : PictureFrames)
+    {
+        picture->SetAnimationTime((double)frame / timeline->GetFrameRate());
+
+        auto image = RenderOffscreen(picture->GetSize(), [picture](std::shared_ptr<wxGraphicsContext> graphics) {
+            picture->Draw(graphics);
+        });
+
+        CheckGolden("picture-frame" + std::to_string(frame), image);
+    }
+}
@@ -0,0 +1,147 @@
+/**
+ * @file SeekDeterminismTest.cpp
+ * @author Shawn_Porto
+ *
+ * Seeking to a frame in any order has to produce exactly
+ * the same image as playing up to it frame by frame.
+ */
+
+#include <pch.h>
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <map>
+#include <random>
+
+#include <machine-api.h>
+#include <Picture.h>
+#include <PictureFactory.h>
+
+#include "GoldenImage.h"
+
+/// Size of the machine images
+const wxSize SeekImageSize(600, 600);
+
+/// Where the machine is placed in the images
+const wxPoint SeekMachineLocation(300, 550);
+
+/// Last frame checked for the machines
+const int SeekMachineLastFrame = 450;
+
+/// Spacing of the frames checked for the machines
+const int SeekMachineFrameSpacing = 15;
+
+/// Seed for the random seek order, fixed so failures reproduce
+const unsigned SeekSeed = 335;
+
+/**
+ * Render the current state of a machine
+ * @param system Machine system to render
+ * @return The rendered image
+ */
+static wxImage RenderMachine(std::shared_ptr<IMachineSystem> system)
+{
+    return RenderOffscreen(SeekImageSize, [system](std::shared_ptr<wxGraphicsContext> graphics) {
+        system->DrawMachine(graphics);
+    });
+}
+
+/**
+ * Check one machine: sequential playback against shuffled seeks
+ * @param machineNumber Machine to check
+ */
+static void CheckMachineSeeks(int machineNumber)
+{
+    MachineSystemFactory factory(GoldenResourcesDir);
+
+    // Sequential playback, one frame at a time
+    auto sequential = factory.CreateMachineSystem();
+    sequential->ChooseMachine(machineNumber);
+    sequential->SetFrameRate(GoldenFrameRate);
+    sequential->SetLocation(SeekMachineLocation);
+
+    std::map<int, wxImage> expected;
+    for (int frame = 0; frame <= SeekMachineLastFrame; frame++)
+    {
+        sequential->SetMachineFrame(frame);
+        if (frame % SeekMachineFrameSpacing == 0)
+        {
+            expected[frame] = RenderMachine(sequential);
+        }
+    }
+
+    // The same frames, visited in random order without drawing in between
+    std::vector<int> frames;
+    for (auto &entry : expected)
+    {
+        frames.push_back(entry.first);
+    }
+
+    std::mt19937 random(SeekSeed);
+    std::shuffle(frames.begin(), frames.end(), random);
+
+    auto seeking = factory.CreateMachineSystem();
+    seeking->ChooseMachine(machineNumber);
+    seeking->SetFrameRate(GoldenFrameRate);
+    seeking->SetLocation(SeekMachineLocation);
+
+    for (auto frame : frames)
+    {
+        seeking->SetMachineFrame(frame);
+        ASSERT_EQ(0, CountDifferentPixels(expected[frame], RenderMachine(seeking)))
+            << "Machine " << machineNumber << " differs at frame " << frame;
+    }
+}
+
+TEST(SeekDeterminismTest, Machine1)
+{
+    CheckMachineSeeks(1);
+}
+
+TEST(SeekDeterminismTest, Machine2)
+{
+    CheckMachineSeeks(2);
+}
+
+TEST(SeekDeterminismTest, Picture)
+{
+    ASSERT_TRUE(wxFileExists(GOLDEN_ANIMATION));
+
+    PictureFactory factory;
+    auto picture = factory.Create(GoldenResourcesDir);
+    ASSERT_TRUE(picture->Load(GOLDEN_ANIMATION));
+
+    auto timeline = picture->GetTimeline();
+    auto render = [picture]() {
+        return RenderOffscreen(picture->GetSize(), [picture](std::shared_ptr<wxGraphicsContext> graphics) {
+            picture->Draw(graphics);
+        });
+    };
+
+    // Sequential playback. The machines step through every
+    // frame in between when they are drawn at a checkpoint.
+    std::map<int, wxImage> expected;
+    for (int frame = 0; frame < timeline->GetNumFrames(); frame++)
+    {
+        picture->SetAnimationTime((double)frame / timeline->GetFrameRate());
+        if (frame % 100 == 0)
+        {
+            expected[frame] = render();
+        }
+    }
+
+    std::vector<int> frames;
+    for (auto &entry : expected)
+    {
+        frames.push_back(entry.first);
+    }
+
+    std::mt19937 random(SeekSeed);
+    std::shuffle(frames.begin(), frames.end(), random);
+
+    for (auto frame : frames)
+    {
+        picture->SetAnimationTime((double)frame / timeline->GetFrameRate());
+        ASSERT_EQ(0, CountDifferentPixels(expected[frame], render())) << "Picture differs at frame " << frame;
+    }
+}
@@ -0,0 +1,24 @@
+#include <pch.h>
+#include "gtest/gtest.h"
+#include <wx/filefn.h>
+
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+
+    // Rendering the golden frames needs the GUI toolkit initialized
+    wxApp::SetInstance(new wxApp());
+    int wxArgc = 1;
+    if (!wxEntryStart(wxArgc, argv))
+    {
+        return 1;
+    }
+
+    wxSetWorkingDirectory(L"..");
+    wxInitAllImageHandlers();
+
+    int result = RUN_ALL_TESTS();
+
+    wxEntryCleanup();
+    return result;
+}
@@ -110,3 +110,25 @@ void Box::Reset()
     mLidHeight = LidZeroAngleScale;
     mLidAngle = 0;
 }
+
+/**
+ * Add whether the box has opened and how far the lid has swung
+ * @param checkpoint Checkpoint to add to
+ */
+void Box::SaveCheckpoint(MachineCheckpoint &checkpoint)
+{
+    checkpoint.Add(mIsOpen);
+    checkpoint.Add(mLidAngle);
+    checkpoint.Add(mLidHeight);
+}
+
+/**
+ * Read back whether the box has opened and how far the lid has swung
+ * @param checkpoint Checkpoint to read from
+ */
+void Box::RestoreCheckpoint(MachineCheckpoint &checkpoint)
+{
+    mIsOpen = checkpoint.Next() != 0;
+    mLidAngle = checkpoint.Next();
+    mLidHeight = checkpoint.Next();
+}
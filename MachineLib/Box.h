@@ -41,12 +41,20 @@ public:
     /** Assignment operator disabled */
     void operator=(const Box &) = delete;
 
+    /**
+     * Get the type of this component for statistics
+     * @return Component type
+     */
+    ComponentType GetType() override {return ComponentType::Box;}
+
     void Draw(std::shared_ptr<wxGraphicsContext> graphics, int x, int y) override;
     void DrawLast(std::shared_ptr<wxGraphicsContext> graphics, int x, int y) override;
     void Open() override;
     void Advance(double delta) override;
     //void Update(double time) override;
     void Reset() override;
+    void SaveCheckpoint(MachineCheckpoint &checkpoint) override;
+    void RestoreCheckpoint(MachineCheckpoint &checkpoint) override;
 };
 
 
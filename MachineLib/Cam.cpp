@@ -48,18 +48,12 @@ void Cam::Draw(std::shared_ptr<wxGraphicsContext> graphics, int x, int y)
     double holeYPos = cos(angle) * CamDiameter/2;
     double holeHeight = sin(angle) * HoleSize;
 
-    if (holeYPos <= -CamDiameter/2 + holeHeight/2)
+    if (IsKeyInHole())
     {
         mKey.DrawPolygon(graphics, x, y - CamDiameter/2 + KeyDrop, 0);
-        if (!mIsKeyed)
-        {
-            OpenOpenables();
-            mIsKeyed = true;
-        }
     }
     else
     {
-        mIsKeyed = false;
         mKey.DrawPolygon(graphics, x, y - CamDiameter/2, 0);
     }
 
@@ -80,6 +74,11 @@ void Cam::OpenOpenables()
 {
     for (auto openable : mOpenables)
     {
+        if (GetStatistics() != nullptr)
+        {
+            GetStatistics()->AddOpenableEvent();
+        }
+
         openable->Open();
     }
 }
@@ -95,10 +94,71 @@ void Cam::AddOpenable(std::shared_ptr<IOpenable> openable)
 
 /**
  * Sets the cams rotation
+ *
+ * The openables are opened here, when the key first drops
+ * into the hole, so the machine state depends only on the
+ * simulation and not on which frames happen to be drawn.
  * @param rotation the rotation the cam is supposed to be at
  */
 void Cam::SetRotation(double rotation)
 {
     mRotation = rotation;
+
+    if (IsKeyInHole())
+    {
+        if (!mIsKeyed)
+        {
+            OpenOpenables();
+            mIsKeyed = true;
+        }
+    }
+    else
+    {
+        mIsKeyed = false;
+    }
+}
+
+/**
+ * Is the hole in the cam under the key at the current rotation?
+ * @return true if the key drops into the hole
+ */
+bool Cam::IsKeyInHole()
+{
+    double angle = mRotation * 2 * M_PI;
+    double holeYPos = cos(angle) * CamDiameter/2;
+    double holeHeight = sin(angle) * HoleSize;
+
+    return holeYPos <= -CamDiameter/2 + holeHeight/2;
+}
+
+/**
+ * Resets the cam to when time = 0
+ */
+void Cam::Reset()
+{
+    mRotation = 0;
+    mIsKeyed = false;
 }
 
+/**
+ * Add the rotation and whether the key is in the hole.
+ *
+ * Without the key state the update after a restore would
+ * open the openables again.
+ * @param checkpoint Checkpoint to add to
+ */
+void Cam::SaveCheckpoint(MachineCheckpoint &checkpoint)
+{
+    checkpoint.Add(mRotation);
+    checkpoint.Add(mIsKeyed);
+}
+
+/**
+ * Read back the rotation and whether the key is in the hole
+ * @param checkpoint Checkpoint to read from
+ */
+void Cam::RestoreCheckpoint(MachineCheckpoint &checkpoint)
+{
+    mRotation = checkpoint.Next();
+    mIsKeyed = checkpoint.Next() != 0;
+}
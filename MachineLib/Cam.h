@@ -40,10 +40,20 @@ public:
     /** Assignment operator disabled */
     void operator=(const Cam &) = delete;
 
+    /**
+     * Get the type of this component for statistics
+     * @return Component type
+     */
+    ComponentType GetType() override {return ComponentType::Cam;}
+
     void Draw(std::shared_ptr<wxGraphicsContext> graphics, int x, int y) override;
     void OpenOpenables();
     void AddOpenable(std::shared_ptr<IOpenable> openable);
     void SetRotation(double rotation) override;
+    void Reset() override;
+    void SaveCheckpoint(MachineCheckpoint &checkpoint) override;
+    void RestoreCheckpoint(MachineCheckpoint &checkpoint) override;
+    bool IsKeyInHole();
 };
 
 
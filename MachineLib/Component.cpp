@@ -5,3 +5,20 @@
 #include "pch.h"
 #include "Component.h"
 
+#include <wx/sound.h>
+
+/**
+ * Play a sound, or give it to the sound handler if there is one
+ * @param sound Sound to play
+ */
+void Component::PlaySound(wxSound* sound)
+{
+    if (mSoundHandler != nullptr)
+    {
+        (*mSoundHandler)(sound);
+    }
+    else
+    {
+        sound->Play();
+    }
+}
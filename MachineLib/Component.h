@@ -8,6 +8,9 @@
 #ifndef COMPONENT_H
 #define COMPONENT_H
 
+#include "MachineStatistics.h"
+#include "MachineCheckpoint.h"
+#include "IMachineAudio.h"
 
 /**
  * Component of Machine
@@ -17,6 +20,10 @@ class Component
 private:
     ///Position of the component
     wxPoint mPosition;
+    /// Statistics to report to or nullptr if none
+    MachineStatistics* mStatistics = nullptr;
+    /// Handler for the sounds of the component or nullptr to play them
+    const IMachineAudio::SoundHandler* mSoundHandler = nullptr;
 public:
     Component(){}
 
@@ -59,6 +66,19 @@ public:
      */
     virtual void Reset(){}
 
+    /**
+     * Add the state that depends on the history of the
+     * simulation to a checkpoint
+     * @param checkpoint Checkpoint to add to
+     */
+    virtual void SaveCheckpoint(MachineCheckpoint &checkpoint) {}
+
+    /**
+     * Read back the state SaveCheckpoint added
+     * @param checkpoint Checkpoint to read from
+     */
+    virtual void RestoreCheckpoint(MachineCheckpoint &checkpoint) {}
+
     /**
      * Get the current component position
      * @return position the component is at
@@ -70,6 +90,32 @@ public:
     * @param position position the component is at
     */
     virtual void SetPosition(wxPoint position) {mPosition = position;}
+
+    /**
+     * Get the type of this component for statistics
+     * @return Component type
+     */
+    virtual ComponentType GetType() = 0;
+
+    /**
+     * Set the statistics this component reports to
+     * @param statistics Statistics object or nullptr for none
+     */
+    virtual void SetStatistics(MachineStatistics* statistics) {mStatistics = statistics;}
+
+    /**
+     * Get the statistics this component reports to
+     * @return Statistics object or nullptr if none
+     */
+    MachineStatistics* GetStatistics() {return mStatistics;}
+
+    /**
+     * Set the handler this component gives its sounds to
+     * @param handler Handler or nullptr to play the sounds
+     */
+    void SetSoundHandler(const IMachineAudio::SoundHandler* handler) {mSoundHandler = handler;}
+
+    void PlaySound(wxSound* sound);
 };
 
 
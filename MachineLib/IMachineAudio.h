@@ -0,0 +1,42 @@
+/**
+ * @file IMachineAudio.h
+ * @author Shawn_Porto
+ *
+ * Interface for machine systems whose sounds can be redirected
+ */
+
+#ifndef IMACHINEAUDIO_H
+#define IMACHINEAUDIO_H
+
+#include <functional>
+
+class wxSound;
+
+/**
+ * Interface for machine systems whose sounds can be redirected.
+ *
+ * Normally a machine plays its sounds when the simulation
+ * reaches them. A handler set here is given each sound instead,
+ * on the thread that runs the simulation, so the caller decides
+ * when and where it is played, or drops it to keep the machine
+ * silent. IMachineSystem may not be changed, so machine systems
+ * that support this implement it alongside it. Users obtain it
+ * with a dynamic_pointer_cast from the IMachineSystem.
+ */
+class IMachineAudio
+{
+public:
+    /// Handler given each sound the machine would play
+    typedef std::function<void(wxSound *sound)> SoundHandler;
+
+    /// Destructor
+    virtual ~IMachineAudio() = default;
+
+    /**
+     * Give the sounds of the machine to a handler instead of playing them
+     * @param handler Handler for the sounds, or an empty handler to play them again
+     */
+    virtual void SetSoundHandler(const SoundHandler &handler) = 0;
+};
+
+#endif //IMACHINEAUDIO_H
@@ -0,0 +1,45 @@
+/**
+ * @file IMachineCheckpoint.h
+ * @author Shawn_Porto
+ *
+ * Interface for machine systems that can save and restore their simulation state
+ */
+
+#ifndef IMACHINECHECKPOINT_H
+#define IMACHINECHECKPOINT_H
+
+#include <memory>
+
+class MachineCheckpoint;
+
+/**
+ * Interface for machine systems that can save and restore their simulation state.
+ *
+ * Setting a machine system to an earlier frame replays the
+ * simulation from frame 0. Restoring a checkpoint taken at or
+ * before the frame first lets it replay from there instead.
+ * IMachineSystem may not be changed, so machine systems that
+ * support this implement it alongside it. Users obtain it with
+ * a dynamic_pointer_cast from the IMachineSystem.
+ */
+class IMachineCheckpoint
+{
+public:
+    /// Destructor
+    virtual ~IMachineCheckpoint() = default;
+
+    /**
+     * Save the simulation state at the current frame
+     * @return New checkpoint
+     */
+    virtual std::shared_ptr<MachineCheckpoint> SaveCheckpoint() = 0;
+
+    /**
+     * Put the machine back to the state of a checkpoint
+     * @param checkpoint Checkpoint to restore
+     * @return false if the checkpoint was taken of a different machine
+     */
+    virtual bool RestoreCheckpoint(const std::shared_ptr<MachineCheckpoint> &checkpoint) = 0;
+};
+
+#endif //IMACHINECHECKPOINT_H
@@ -0,0 +1,46 @@
+/**
+ * @file IMachineStatistics.h
+ * @author Shawn_Porto
+ *
+ * Interface for machine systems that can report their cost counters
+ */
+
+#ifndef IMACHINESTATISTICS_H
+#define IMACHINESTATISTICS_H
+
+class MachineStatistics;
+
+/**
+ * Interface for machine systems that can report their cost counters.
+ *
+ * IMachineSystem may not be changed, so machine systems that
+ * keep statistics implement this alongside it. Users obtain
+ * it with a dynamic_pointer_cast from the IMachineSystem.
+ */
+class IMachineStatistics
+{
+public:
+    /// Destructor
+    virtual ~IMachineStatistics() = default;
+
+    /**
+     * Get the statistics collected by this machine system
+     * @return Reference to the statistics
+     */
+    virtual const MachineStatistics &GetStatistics() = 0;
+
+    /**
+     * Reset all of the statistics to zero
+     */
+    virtual void ClearStatistics() = 0;
+
+    /**
+     * Start a new frame of the statistics. Call this once for
+     * each frame displayed, before the machine is set to it, so
+     * the last frame numbers cover all of the simulation steps
+     * and restores it took to get there.
+     */
+    virtual void BeginStatisticsFrame() = 0;
+};
+
+#endif //IMACHINESTATISTICS_H
@@ -6,6 +6,58 @@
 #include "pch.h"
 #include "Machine.h"
 
+/**
+ * Charges the time until it is destroyed to a component and
+ * phase. It does nothing when there are no statistics.
+ */
+class PhaseTimer
+{
+private:
+    /// Statistics to charge or nullptr if none
+    MachineStatistics* mStatistics;
+
+    /// Component the time is charged to
+    Component* mComponent;
+
+    /// Phase the time is charged to
+    MachinePhase mPhase;
+
+    /// Time the timer was started
+    MachineStatistics::Clock::time_point mStart;
+
+public:
+    /**
+     * Constructor, starts the timer
+     * @param statistics Statistics to charge or nullptr if none
+     * @param component Component the time is charged to
+     * @param phase Phase the time is charged to
+     */
+    PhaseTimer(MachineStatistics* statistics, Component* component, MachinePhase phase) :
+        mStatistics(statistics), mComponent(component), mPhase(phase)
+    {
+        if (mStatistics != nullptr)
+        {
+            mStart = MachineStatistics::Clock::now();
+        }
+    }
+
+    /**
+     * Destructor, charges the time
+     */
+    ~PhaseTimer()
+    {
+        if (mStatistics != nullptr)
+        {
+            mStatistics->AddTime(mComponent->GetType(), mPhase, mStart);
+        }
+    }
+
+    /** Copy constructor disabled */
+    PhaseTimer(const PhaseTimer &) = delete;
+    /** Assignment operator disabled */
+    void operator=(const PhaseTimer &) = delete;
+};
+
 /**
  * Constructor
  * @param location the location of the machine
@@ -22,6 +74,8 @@ Machine::Machine(wxPoint location) : mLocation(location)
 void Machine::AddComponent(const std::shared_ptr<Component>& component)
 {
     mComponents.push_back(component);
+    component->SetStatistics(mStatistics);
+    component->SetSoundHandler(mSoundHandler);
 }
 
 /**
@@ -34,10 +88,12 @@ void Machine::Draw(const std::shared_ptr<wxGraphicsContext>& graphics)
     graphics->Translate(mLocation.x, mLocation.y);
     for(auto component : mComponents)
     {
+        PhaseTimer timer(mStatistics, component.get(), MachinePhase::Draw);
         component->Draw(graphics, component->GetPosition().x, component->GetPosition().y);
     }
     for(auto component : mComponents)
     {
+        PhaseTimer timer(mStatistics, component.get(), MachinePhase::DrawLast);
         component->DrawLast(graphics, component->GetPosition().x, component->GetPosition().y);
     }
     graphics->PopState();
@@ -50,9 +106,11 @@ void Machine::Update()
 {
     for (const auto& component : mComponents)
     {
+        PhaseTimer timer(mStatistics, component.get(), MachinePhase::Update);
         component->Update(mTime);
     }
 }
+
 /**
  * Advances the machine by delta
  * @param delta the amount of time to advance the machine by
@@ -61,10 +119,37 @@ void Machine::Advance(double delta)
 {
     for (const auto& component : mComponents)
     {
+        PhaseTimer timer(mStatistics, component.get(), MachinePhase::Advance);
         component->Advance(delta);
     }
 }
 
+/**
+ * Set the statistics the machine and all of its components report to
+ * @param statistics Statistics object or nullptr for none
+ */
+void Machine::SetStatistics(MachineStatistics* statistics)
+{
+    mStatistics = statistics;
+    for (const auto& component : mComponents)
+    {
+        component->SetStatistics(statistics);
+    }
+}
+
+/**
+ * Set the handler the components of the machine give their sounds to
+ * @param handler Handler or nullptr to play the sounds
+ */
+void Machine::SetSoundHandler(const IMachineAudio::SoundHandler* handler)
+{
+    mSoundHandler = handler;
+    for (const auto& component : mComponents)
+    {
+        component->SetSoundHandler(handler);
+    }
+}
+
 /**
  * Resets the machine to where time = 0
  */
@@ -77,5 +162,27 @@ void Machine::Reset()
     }
 }
 
+/**
+ * Add the state of all of the components to a checkpoint
+ * @param checkpoint Checkpoint to add to
+ */
+void Machine::SaveCheckpoint(MachineCheckpoint &checkpoint)
+{
+    for (const auto& component : mComponents)
+    {
+        component->SaveCheckpoint(checkpoint);
+    }
+}
 
-
+/**
+ * Read back the state of all of the components from a checkpoint
+ * @param checkpoint Checkpoint to read from
+ */
+void Machine::RestoreCheckpoint(MachineCheckpoint &checkpoint)
+{
+    checkpoint.Rewind();
+    for (const auto& component : mComponents)
+    {
+        component->RestoreCheckpoint(checkpoint);
+    }
+}
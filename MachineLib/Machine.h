@@ -24,6 +24,10 @@ private:
     wxPoint mLocation;
     /// Components that this machine has
     std::vector<std::shared_ptr<Component>> mComponents;
+    /// Statistics to time the components into or nullptr if none
+    MachineStatistics* mStatistics = nullptr;
+    /// Handler for the sounds of the components or nullptr to play them
+    const IMachineAudio::SoundHandler* mSoundHandler = nullptr;
 public:
     Machine(wxPoint location);
 
@@ -63,6 +67,12 @@ public:
 
     void Reset();
     void Advance(double delta);
+
+    void SaveCheckpoint(MachineCheckpoint &checkpoint);
+    void RestoreCheckpoint(MachineCheckpoint &checkpoint);
+
+    void SetStatistics(MachineStatistics* statistics);
+    void SetSoundHandler(const IMachineAudio::SoundHandler* handler);
 };
 
 
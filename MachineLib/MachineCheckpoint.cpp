@@ -0,0 +1,32 @@
+/**
+ * @file MachineCheckpoint.cpp
+ * @author Shawn_Porto
+ */
+
+#include "pch.h"
+#include "MachineCheckpoint.h"
+
+/**
+ * Constructor
+ * @param machineNumber Machine number the checkpoint is taken of
+ * @param frame Frame the checkpoint is taken at
+ * @param time Machine time at the frame in seconds
+ */
+MachineCheckpoint::MachineCheckpoint(int machineNumber, int frame, double time) :
+    mMachineNumber(machineNumber), mFrame(frame), mTime(time)
+{
+}
+
+/**
+ * Read the next component value
+ * @return The value, or 0 if every value has been read
+ */
+double MachineCheckpoint::Next()
+{
+    if (mNext >= mValues.size())
+    {
+        return 0;
+    }
+
+    return mValues[mNext++];
+}
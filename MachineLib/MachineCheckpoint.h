@@ -0,0 +1,90 @@
+/**
+ * @file MachineCheckpoint.h
+ * @author Shawn_Porto
+ *
+ * The simulation state of a machine at one frame
+ */
+
+#ifndef MACHINECHECKPOINT_H
+#define MACHINECHECKPOINT_H
+
+#include <vector>
+
+/**
+ * The simulation state of a machine at one frame.
+ *
+ * Only the state that depends on the history of the
+ * simulation is kept, such as whether a box has opened
+ * and how far its lid has swung. Everything else follows
+ * from the machine time and is recomputed by an update
+ * when the checkpoint is restored. Components write their
+ * values with Add() and read them back in the same order
+ * with Next().
+ */
+class MachineCheckpoint
+{
+private:
+    /// Machine number the checkpoint was taken of
+    int mMachineNumber;
+
+    /// Frame the checkpoint was taken at
+    int mFrame;
+
+    /// Machine time at the frame in seconds
+    double mTime;
+
+    /// The component values in the order they were added
+    std::vector<double> mValues;
+
+    /// Position of the next value Next() returns
+    size_t mNext = 0;
+
+public:
+    MachineCheckpoint(int machineNumber, int frame, double time);
+
+    /// Default constructor (disabled)
+    MachineCheckpoint() = delete;
+    /** Copy constructor disabled */
+    MachineCheckpoint(const MachineCheckpoint &) = delete;
+    /** Assignment operator disabled */
+    void operator=(const MachineCheckpoint &) = delete;
+
+    /**
+     * Get the machine number the checkpoint was taken of
+     * @return Machine number
+     */
+    int GetMachineNumber() const {return mMachineNumber;}
+
+    /**
+     * Get the frame the checkpoint was taken at
+     * @return Frame number
+     */
+    int GetFrame() const {return mFrame;}
+
+    /**
+     * Get the machine time at the checkpoint
+     * @return Time in seconds
+     */
+    double GetTime() const {return mTime;}
+
+    /**
+     * Get the component values
+     * @return Values in the order they were added
+     */
+    const std::vector<double> &GetValues() const {return mValues;}
+
+    /**
+     * Add a component value
+     * @param value Value to add
+     */
+    void Add(double value) {mValues.push_back(value);}
+
+    double Next();
+
+    /**
+     * Start reading the values from the beginning
+     */
+    void Rewind() {mNext = 0;}
+};
+
+#endif //MACHINECHECKPOINT_H
@@ -0,0 +1,75 @@
+/**
+ * @file MachineStatistics.cpp
+ * @author Shawn_Porto
+ */
+
+#include "pch.h"
+#include "MachineStatistics.h"
+
+/// Names of the component types, in ComponentType order
+const wchar_t *ComponentTypeNames[ComponentTypeCount] = {
+        L"Box", L"Sparty", L"Crank", L"Shaft", L"Pulley", L"Cam", L"MusicBox"};
+
+/// Names of the phases, in MachinePhase order
+const wchar_t *MachinePhaseNames[MachinePhaseCount] = {
+        L"Update", L"Advance", L"Draw", L"DrawLast"};
+
+/**
+ * Reset all of the counters to zero
+ */
+void MachineStatistics::Clear()
+{
+    for (int t = 0; t < ComponentTypeCount; t++)
+    {
+        for (int p = 0; p < MachinePhaseCount; p++)
+        {
+            mCumulativeTime[t][p] = 0;
+            mFrameTime[t][p] = 0;
+            mCalls[t][p] = 0;
+        }
+    }
+
+    mRotationPropagations = 0;
+    mFrameRotationPropagations = 0;
+    mOpenableEvents = 0;
+    mFrameOpenableEvents = 0;
+    mFrames = 0;
+}
+
+/**
+ * Start a new frame, zeroing the last frame counters
+ */
+void MachineStatistics::BeginFrame()
+{
+    for (int t = 0; t < ComponentTypeCount; t++)
+    {
+        for (int p = 0; p < MachinePhaseCount; p++)
+        {
+            mFrameTime[t][p] = 0;
+        }
+    }
+
+    mFrameRotationPropagations = 0;
+    mFrameOpenableEvents = 0;
+    mFrames++;
+}
+
+/**
+ * Get a display name for a component type
+ * @param type Component type
+ * @return Name of the type
+ */
+const wchar_t *MachineStatistics::GetComponentTypeName(ComponentType type)
+{
+    return ComponentTypeNames[(int)type];
+}
+
+/**
+ * Get a display name for a phase
+ * @param phase Phase
+ * @return Name of the phase
+ */
+const wchar_t *MachineStatistics::GetPhaseName(MachinePhase phase)
+{
+    return MachinePhaseNames[(int)phase];
+}
@@ -0,0 +1,168 @@
+/**
+ * @file MachineStatistics.h
+ * @author Shawn_Porto
+ *
+ * Per-component cost counters for a machine system
+ */
+
+#ifndef MACHINESTATISTICS_H
+#define MACHINESTATISTICS_H
+
+#include <chrono>
+#include <cstdint>
+
+/**
+ * The kinds of components a machine can be built from
+ */
+enum class ComponentType {Box, Sparty, Crank, Shaft, Pulley, Cam, MusicBox};
+
+/// Number of values in ComponentType
+const int ComponentTypeCount = 7;
+
+/**
+ * The component calls the machine times
+ */
+enum class MachinePhase {Update, Advance, Draw, DrawLast};
+
+/// Number of values in MachinePhase
+const int MachinePhaseCount = 4;
+
+/**
+ * Per-component cost counters for a machine system.
+ *
+ * Time is accumulated for each component type and each
+ * phase (Update, Advance, Draw, DrawLast) both since the
+ * last Clear() and for the last frame only. A frame begins
+ * once for each frame displayed, however many times the
+ * machine system is set to a frame to get there, so the last
+ * frame numbers include every simulation step and restore
+ * taken to reach that frame plus the draw that follows.
+ *
+ * Times are inclusive: rotation propagated from a crank
+ * into the shafts it drives is charged to the crank.
+ */
+class MachineStatistics
+{
+public:
+    /// Clock used to time the component calls
+    using Clock = std::chrono::steady_clock;
+
+private:
+    /// Cumulative seconds spent by type and phase
+    double mCumulativeTime[ComponentTypeCount][MachinePhaseCount] = {};
+
+    /// Seconds spent in the last frame by type and phase
+    double mFrameTime[ComponentTypeCount][MachinePhaseCount] = {};
+
+    /// Cumulative number of calls by type and phase
+    uint64_t mCalls[ComponentTypeCount][MachinePhaseCount] = {};
+
+    /// Cumulative number of rotations propagated from a source to a sink
+    uint64_t mRotationPropagations = 0;
+
+    /// Rotations propagated in the last frame
+    uint64_t mFrameRotationPropagations = 0;
+
+    /// Cumulative number of IOpenable open events
+    uint64_t mOpenableEvents = 0;
+
+    /// IOpenable open events in the last frame
+    uint64_t mFrameOpenableEvents = 0;
+
+    /// Number of frames since the last Clear()
+    uint64_t mFrames = 0;
+
+public:
+    MachineStatistics() = default;
+
+    /** Copy constructor disabled */
+    MachineStatistics(const MachineStatistics &) = delete;
+    /** Assignment operator disabled */
+    void operator=(const MachineStatistics &) = delete;
+
+    void Clear();
+    void BeginFrame();
+
+    /**
+     * Charge the time since a start point to a component type and phase
+     * @param type Component type
+     * @param phase Phase the time was spent in
+     * @param start Time the call started
+     */
+    void AddTime(ComponentType type, MachinePhase phase, Clock::time_point start)
+    {
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        mCumulativeTime[(int)type][(int)phase] += seconds;
+        mFrameTime[(int)type][(int)phase] += seconds;
+        mCalls[(int)type][(int)phase]++;
+    }
+
+    /**
+     * Count one rotation passed from a source to a sink
+     */
+    void AddRotationPropagation() { mRotationPropagations++; mFrameRotationPropagations++; }
+
+    /**
+     * Count one IOpenable open event
+     */
+    void AddOpenableEvent() { mOpenableEvents++; mFrameOpenableEvents++; }
+
+    /**
+     * Get the cumulative time spent by a component type in a phase
+     * @param type Component type
+     * @param phase Phase
+     * @return Time in seconds
+     */
+    double GetCumulativeTime(ComponentType type, MachinePhase phase) const { return mCumulativeTime[(int)type][(int)phase]; }
+
+    /**
+     * Get the time spent by a component type in a phase during the last frame
+     * @param type Component type
+     * @param phase Phase
+     * @return Time in seconds
+     */
+    double GetLastFrameTime(ComponentType type, MachinePhase phase) const { return mFrameTime[(int)type][(int)phase]; }
+
+    /**
+     * Get the cumulative number of calls to a component type in a phase
+     * @param type Component type
+     * @param phase Phase
+     * @return Number of calls
+     */
+    uint64_t GetCalls(ComponentType type, MachinePhase phase) const { return mCalls[(int)type][(int)phase]; }
+
+    /**
+     * Get the cumulative number of rotation propagations
+     * @return Number of times a rotation source set a sink
+     */
+    uint64_t GetRotationPropagations() const { return mRotationPropagations; }
+
+    /**
+     * Get the number of rotation propagations in the last frame
+     * @return Number of times a rotation source set a sink
+     */
+    uint64_t GetLastFrameRotationPropagations() const { return mFrameRotationPropagations; }
+
+    /**
+     * Get the cumulative number of IOpenable events
+     * @return Number of times an openable was opened
+     */
+    uint64_t GetOpenableEvents() const { return mOpenableEvents; }
+
+    /**
+     * Get the number of IOpenable events in the last frame
+     * @return Number of times an openable was opened
+     */
+    uint64_t GetLastFrameOpenableEvents() const { return mFrameOpenableEvents; }
+
+    /**
+     * Get the number of frames counted
+     * @return Frames since the last clear
+     */
+    uint64_t GetFrames() const { return mFrames; }
+
+    static const wchar_t *GetComponentTypeName(ComponentType type);
+    static const wchar_t *GetPhaseName(MachinePhase phase);
+};
+
+#endif //MACHINESTATISTICS_H
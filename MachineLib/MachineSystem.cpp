@@ -49,6 +49,40 @@ void MachineSystem::SetMachineFrame(int frame)
     }
 }
 
+/**
+ * Save the simulation state at the current frame
+ * @return New checkpoint
+ */
+std::shared_ptr<MachineCheckpoint> MachineSystem::SaveCheckpoint()
+{
+    auto checkpoint = std::make_shared<MachineCheckpoint>(mNumber, mFrame, mTime);
+    mMachine->SaveCheckpoint(*checkpoint);
+    return checkpoint;
+}
+
+/**
+ * Put the machine back to the state of a checkpoint.
+ *
+ * The state that follows from the time, such as the
+ * rotation of the shafts, is recomputed by an update.
+ * @param checkpoint Checkpoint to restore
+ * @return false if the checkpoint was taken of a different machine
+ */
+bool MachineSystem::RestoreCheckpoint(const std::shared_ptr<MachineCheckpoint> &checkpoint)
+{
+    if (checkpoint->GetMachineNumber() != mNumber)
+    {
+        return false;
+    }
+
+    mFrame = checkpoint->GetFrame();
+    mTime = checkpoint->GetTime();
+    mMachine->SetTime(mTime);
+    mMachine->RestoreCheckpoint(*checkpoint);
+    mMachine->Update();
+    return true;
+}
+
 /**
 * Set the machine number
 * @param machine An integer number. Each number makes a different machine
@@ -77,6 +111,9 @@ void MachineSystem::ChooseMachine(int machine)
                 break;
             }
     }
+
+    mMachine->SetStatistics(&mStatistics);
+    mMachine->SetSoundHandler(mSoundHandler ? &mSoundHandler : nullptr);
 }
 
 /**
@@ -87,3 +124,16 @@ void MachineSystem::SetFlag(int flag)
 {
 }
 
+
+/**
+ * Give the sounds of the machine to a handler instead of playing them.
+ *
+ * The handler is kept here, so it also applies to
+ * machines chosen later.
+ * @param handler Handler for the sounds, or an empty handler to play them again
+ */
+void MachineSystem::SetSoundHandler(const SoundHandler &handler)
+{
+    mSoundHandler = handler;
+    mMachine->SetSoundHandler(mSoundHandler ? &mSoundHandler : nullptr);
+}
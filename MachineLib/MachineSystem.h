@@ -8,12 +8,17 @@
 #ifndef MACHINESYSTEM_H
 #define MACHINESYSTEM_H
 #include "IMachineSystem.h"
+#include "IMachineStatistics.h"
+#include "IMachineCheckpoint.h"
+#include "IMachineAudio.h"
 #include "Machine.h"
+#include "MachineStatistics.h"
 
 /**
  * The System that will handle changing machines and setting framedata
  */
-class MachineSystem : public IMachineSystem
+class MachineSystem : public IMachineSystem, public IMachineStatistics, public IMachineCheckpoint,
+        public IMachineAudio
 {
 private:
     ///Images directory
@@ -30,6 +35,10 @@ private:
     double mTime = 0;
     /// Current machine in the system
     std::shared_ptr<Machine> mMachine;
+    /// Cost counters for the components of the machine
+    MachineStatistics mStatistics;
+    /// Handler for the sounds of the machine, empty to play them
+    SoundHandler mSoundHandler;
 public:
     ///Constructor
     MachineSystem(std::wstring mResourcesDir);
@@ -84,6 +93,27 @@ public:
 
     void SetFlag(int flag) override;
 
+    /**
+     * Get the statistics collected by this machine system
+     * @return Reference to the statistics
+     */
+    const MachineStatistics &GetStatistics() override {return mStatistics;}
+
+    /**
+     * Reset all of the statistics to zero
+     */
+    void ClearStatistics() override {mStatistics.Clear();}
+
+    /**
+     * Start a new frame of the statistics
+     */
+    void BeginStatisticsFrame() override {mStatistics.BeginFrame();}
+
+    std::shared_ptr<MachineCheckpoint> SaveCheckpoint() override;
+    bool RestoreCheckpoint(const std::shared_ptr<MachineCheckpoint> &checkpoint) override;
+
+    void SetSoundHandler(const SoundHandler &handler) override;
+
 };
 
 
@@ -125,7 +125,7 @@ void MusicBox::Update(double time)
     {
         if (mNotes[mNextNoteTime]->IsOk())
         {
-            mNotes[mNextNoteTime]->Play();
+            PlaySound(mNotes[mNextNoteTime]);
         }
         mNextNoteTime = mNoteTimes[mNextNoteTime];
         if (mNextNoteTime == -1)
@@ -142,3 +142,22 @@ void MusicBox::Reset()
 
     mNextNoteTime = mFirstNote;
 }
+
+/**
+ * Add the next note to play, so the notes
+ * before it are not played again on restore
+ * @param checkpoint Checkpoint to add to
+ */
+void MusicBox::SaveCheckpoint(MachineCheckpoint &checkpoint)
+{
+    checkpoint.Add(mNextNoteTime);
+}
+
+/**
+ * Read back the next note to play
+ * @param checkpoint Checkpoint to read from
+ */
+void MusicBox::RestoreCheckpoint(MachineCheckpoint &checkpoint)
+{
+    mNextNoteTime = checkpoint.Next();
+}
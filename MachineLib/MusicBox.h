@@ -48,10 +48,18 @@ public:
     /** Assignment operator disabled */
     void operator=(const MusicBox &) = delete;
 
+    /**
+     * Get the type of this component for statistics
+     * @return Component type
+     */
+    ComponentType GetType() override {return ComponentType::MusicBox;}
+
     void Draw(std::shared_ptr<wxGraphicsContext> graphics, int x, int y) override;
     void SetRotation(double rotation) override;
     void Update(double time) override;
     void Reset() override;
+    void SaveCheckpoint(MachineCheckpoint &checkpoint) override;
+    void RestoreCheckpoint(MachineCheckpoint &checkpoint) override;
 };
 
 
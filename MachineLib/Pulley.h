@@ -48,6 +48,22 @@ public:
     /// @return the radius of the pulley
     double GetRadius() {  return mRadius; }
 
+    /**
+     * Get the type of this component for statistics
+     * @return Component type
+     */
+    ComponentType GetType() override {return ComponentType::Pulley;}
+
+    /**
+     * Set the statistics this component and its rotation source report to
+     * @param statistics Statistics object or nullptr for none
+     */
+    void SetStatistics(MachineStatistics* statistics) override
+    {
+        Component::SetStatistics(statistics);
+        mSource.SetStatistics(statistics);
+    }
+
     void Draw(std::shared_ptr<wxGraphicsContext> graphics, int x, int y) override;
     void ConnectTo(const std::shared_ptr<Pulley>& other);
     void SetRotation(double rotation) override;
@@ -7,6 +7,7 @@
 #include "RotationSource.h"
 
 #include "IRotationSink.h"
+#include "MachineStatistics.h"
 
 /**
  * Constructor
@@ -33,6 +34,11 @@ void RotationSource::SetRotation(double rotation)
 {
     for (auto sink : mRotationSinks)
     {
+        if (mStatistics != nullptr)
+        {
+            mStatistics->AddRotationPropagation();
+        }
+
         sink->SetRotation(rotation);
     }
 }
@@ -9,6 +9,7 @@
 #define ROTATIONSOURCE_H
 
 class IRotationSink;
+class MachineStatistics;
 
 /**
  * Rotation source that connects to all the rotation sinks
@@ -18,6 +19,8 @@ class RotationSource
 private:
     /// Vector of rotation sinks that this source controls
     std::vector<std::shared_ptr<IRotationSink>> mRotationSinks;
+    /// Statistics to count propagations in or nullptr if none
+    MachineStatistics* mStatistics = nullptr;
 public:
     RotationSource();
 
@@ -28,6 +31,12 @@ public:
 
     void AddSink(std::shared_ptr<IRotationSink> sink);
     void SetRotation(double rotation);
+
+    /**
+     * Set the statistics this source counts propagations in
+     * @param statistics Statistics object or nullptr for none
+     */
+    void SetStatistics(MachineStatistics* statistics) {mStatistics = statistics;}
 };
 
 
@@ -38,6 +38,22 @@ public:
     /// @return Pointer to RotationSource object
     RotationSource *GetSource() { return &mSource; }
 
+    /**
+     * Get the type of this component for statistics
+     * @return Component type
+     */
+    ComponentType GetType() override {return ComponentType::Shaft;}
+
+    /**
+     * Set the statistics this component and its rotation source report to
+     * @param statistics Statistics object or nullptr for none
+     */
+    void SetStatistics(MachineStatistics* statistics) override
+    {
+        Component::SetStatistics(statistics);
+        mSource.SetStatistics(statistics);
+    }
+
     void Draw(std::shared_ptr<wxGraphicsContext> graphics, int x, int y) override;
     void SetRotation(double rotation) override;
 
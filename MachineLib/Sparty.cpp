@@ -124,3 +124,23 @@ void Sparty::Advance(double delta)
         }
     }
 }
+
+/**
+ * Add whether the sparty has popped up and how far the spring has stretched
+ * @param checkpoint Checkpoint to add to
+ */
+void Sparty::SaveCheckpoint(MachineCheckpoint &checkpoint)
+{
+    checkpoint.Add(mCompressed);
+    checkpoint.Add(mSpringLength);
+}
+
+/**
+ * Read back whether the sparty has popped up and how far the spring has stretched
+ * @param checkpoint Checkpoint to read from
+ */
+void Sparty::RestoreCheckpoint(MachineCheckpoint &checkpoint)
+{
+    mCompressed = checkpoint.Next() != 0;
+    mSpringLength = checkpoint.Next();
+}
@@ -37,12 +37,20 @@ public:
     /** Assignment operator disabled */
     void operator=(const Sparty &) = delete;
 
+    /**
+     * Get the type of this component for statistics
+     * @return Component type
+     */
+    ComponentType GetType() override {return ComponentType::Sparty;}
+
     void Draw(std::shared_ptr<wxGraphicsContext> graphics, int x, int y) override;
     void DrawSpring(std::shared_ptr<wxGraphicsContext> graphics, int x, int y, double length, double width,
                     int numLinks);
     void Open() override;
     //void Update(double time) override;
     void Reset() override;
+    void SaveCheckpoint(MachineCheckpoint &checkpoint) override;
+    void RestoreCheckpoint(MachineCheckpoint &checkpoint) override;
     void Advance(double delta) override;
 };
 
@@ -0,0 +1,75 @@
+/**
+ * @file CamTest.cpp
+ * @author Shawn_Porto
+ */
+
+#include "pch.h"
+#include "gtest/gtest.h"
+
+#include <Cam.h>
+#include <IOpenable.h>
+#include <MachineStatistics.h>
+
+/**
+ * An openable that counts how many times it was opened
+ */
+class CountingOpenable : public IOpenable {
+public:
+    /// Number of times Open was called
+    int mOpened = 0;
+
+    /**
+     * Open the openable
+     */
+    void Open() override { mOpened++; }
+};
+
+TEST(CamTest, KeyInHole)
+{
+    Cam cam(L".");
+
+    // The hole is at the bottom at half a turn
+    cam.SetRotation(0);
+    ASSERT_FALSE(cam.IsKeyInHole());
+    cam.SetRotation(0.5);
+    ASSERT_TRUE(cam.IsKeyInHole());
+    cam.SetRotation(0.75);
+    ASSERT_FALSE(cam.IsKeyInHole());
+    cam.SetRotation(1.5);
+    ASSERT_TRUE(cam.IsKeyInHole());
+}
+
+TEST(CamTest, OpensWithoutDrawing)
+{
+    Cam cam(L".");
+    auto openable = std::make_shared<CountingOpenable>();
+    cam.AddOpenable(openable);
+
+    MachineStatistics statistics;
+    cam.SetStatistics(&statistics);
+
+    // Turning the cam opens the openables when the key
+    // first drops in, and nothing is ever drawn
+    cam.SetRotation(0.25);
+    ASSERT_EQ(0, openable->mOpened);
+    cam.SetRotation(0.5);
+    ASSERT_EQ(1, openable->mOpened);
+
+    // Staying in the hole does not open again
+    cam.SetRotation(0.5);
+    cam.SetRotation(0.5);
+    ASSERT_EQ(1, openable->mOpened);
+
+    // Leaving the hole and coming back around opens again
+    cam.SetRotation(1.0);
+    ASSERT_EQ(1, openable->mOpened);
+    cam.SetRotation(1.5);
+    ASSERT_EQ(2, openable->mOpened);
+    ASSERT_EQ(2u, statistics.GetOpenableEvents());
+
+    // After a reset the key is out of the hole, so it opens again
+    cam.Reset();
+    ASSERT_FALSE(cam.IsKeyInHole());
+    cam.SetRotation(0.5);
+    ASSERT_EQ(3, openable->mOpened);
+}
@@ -0,0 +1,52 @@
+/**
+ * @file MachineCheckpointTest.cpp
+ * @author Shawn_Porto
+ */
+
+#include "pch.h"
+#include "gtest/gtest.h"
+
+#include <MachineSystem.h>
+#include <MachineCheckpoint.h>
+
+TEST(MachineCheckpointTest, RestoreMatchesReplay)
+{
+    for (int number = 1; number <= 2; number++)
+    {
+        MachineSystem system(L".");
+        system.ChooseMachine(number);
+        system.SetFrameRate(30);
+
+        system.SetMachineFrame(600);
+        auto checkpoint = system.SaveCheckpoint();
+        ASSERT_EQ(number, checkpoint->GetMachineNumber());
+        ASSERT_EQ(600, checkpoint->GetFrame());
+
+        system.SetMachineFrame(900);
+        ASSERT_TRUE(system.RestoreCheckpoint(checkpoint));
+        ASSERT_DOUBLE_EQ(20.0, system.GetMachineTime());
+
+        // Resuming from the checkpoint ends up where replaying from the start does
+        system.SetMachineFrame(750);
+        auto resumed = system.SaveCheckpoint();
+
+        MachineSystem replayed(L".");
+        replayed.ChooseMachine(number);
+        replayed.SetFrameRate(30);
+        replayed.SetMachineFrame(750);
+
+        ASSERT_EQ(replayed.SaveCheckpoint()->GetValues(), resumed->GetValues());
+        ASSERT_DOUBLE_EQ(replayed.GetMachineTime(), system.GetMachineTime());
+    }
+}
+
+TEST(MachineCheckpointTest, OtherMachine)
+{
+    MachineSystem system(L".");
+    system.ChooseMachine(1);
+    system.SetMachineFrame(30);
+    auto checkpoint = system.SaveCheckpoint();
+
+    system.ChooseMachine(2);
+    ASSERT_FALSE(system.RestoreCheckpoint(checkpoint));
+}
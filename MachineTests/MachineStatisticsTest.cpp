@@ -0,0 +1,98 @@
+/**
+ * @file MachineStatisticsTest.cpp
+ * @author Shawn_Porto
+ */
+
+#include "pch.h"
+#include "gtest/gtest.h"
+
+#include <MachineSystemFactory.h>
+#include <IMachineSystem.h>
+#include <IMachineStatistics.h>
+#include <MachineStatistics.h>
+
+TEST(MachineStatisticsTest, Counters)
+{
+    MachineStatistics statistics;
+
+    ASSERT_EQ(0u, statistics.GetCalls(ComponentType::Cam, MachinePhase::Draw));
+    ASSERT_EQ(0.0, statistics.GetCumulativeTime(ComponentType::Cam, MachinePhase::Draw));
+
+    statistics.BeginFrame();
+    statistics.AddTime(ComponentType::Cam, MachinePhase::Draw, MachineStatistics::Clock::now());
+    statistics.AddRotationPropagation();
+    statistics.AddOpenableEvent();
+
+    ASSERT_EQ(1u, statistics.GetCalls(ComponentType::Cam, MachinePhase::Draw));
+    ASSERT_EQ(0u, statistics.GetCalls(ComponentType::Box, MachinePhase::Draw));
+    ASSERT_EQ(0u, statistics.GetCalls(ComponentType::Cam, MachinePhase::DrawLast));
+    ASSERT_LE(0.0, statistics.GetCumulativeTime(ComponentType::Cam, MachinePhase::Draw));
+    ASSERT_EQ(1u, statistics.GetRotationPropagations());
+    ASSERT_EQ(1u, statistics.GetLastFrameRotationPropagations());
+    ASSERT_EQ(1u, statistics.GetOpenableEvents());
+    ASSERT_EQ(1u, statistics.GetLastFrameOpenableEvents());
+
+    // A new frame clears only the last frame counters
+    statistics.BeginFrame();
+    ASSERT_EQ(2u, statistics.GetFrames());
+    ASSERT_EQ(0.0, statistics.GetLastFrameTime(ComponentType::Cam, MachinePhase::Draw));
+    ASSERT_EQ(0u, statistics.GetLastFrameRotationPropagations());
+    ASSERT_EQ(0u, statistics.GetLastFrameOpenableEvents());
+    ASSERT_EQ(1u, statistics.GetRotationPropagations());
+    ASSERT_EQ(1u, statistics.GetCalls(ComponentType::Cam, MachinePhase::Draw));
+
+    statistics.Clear();
+    ASSERT_EQ(0u, statistics.GetFrames());
+    ASSERT_EQ(0u, statistics.GetCalls(ComponentType::Cam, MachinePhase::Draw));
+    ASSERT_EQ(0u, statistics.GetRotationPropagations());
+    ASSERT_EQ(0u, statistics.GetOpenableEvents());
+}
+
+TEST(MachineStatisticsTest, Names)
+{
+    ASSERT_EQ(std::wstring(L"Box"), MachineStatistics::GetComponentTypeName(ComponentType::Box));
+    ASSERT_EQ(std::wstring(L"MusicBox"), MachineStatistics::GetComponentTypeName(ComponentType::MusicBox));
+    ASSERT_EQ(std::wstring(L"Update"), MachineStatistics::GetPhaseName(MachinePhase::Update));
+    ASSERT_EQ(std::wstring(L"DrawLast"), MachineStatistics::GetPhaseName(MachinePhase::DrawLast));
+}
+
+TEST(MachineStatisticsTest, MachineSystem)
+{
+    MachineSystemFactory factory(L".");
+    auto machine = factory.CreateMachineSystem();
+
+    auto statistics = std::dynamic_pointer_cast<IMachineStatistics>(machine);
+    ASSERT_NE(nullptr, statistics);
+
+    machine->ChooseMachine(1);
+    machine->SetFrameRate(30);
+    statistics->BeginStatisticsFrame();
+    machine->SetMachineFrame(30);
+
+    auto &stats = statistics->GetStatistics();
+    ASSERT_EQ(1u, stats.GetFrames());
+
+    // Every component is updated and advanced once per step
+    ASSERT_EQ(30u, stats.GetCalls(ComponentType::Crank, MachinePhase::Update));
+    ASSERT_EQ(30u, stats.GetCalls(ComponentType::Crank, MachinePhase::Advance));
+    ASSERT_EQ(60u, stats.GetCalls(ComponentType::Shaft, MachinePhase::Update));
+    ASSERT_EQ(0u, stats.GetCalls(ComponentType::Crank, MachinePhase::Draw));
+
+    // The crank drives the rest of the machine
+    ASSERT_LT(0u, stats.GetRotationPropagations());
+    ASSERT_EQ(stats.GetRotationPropagations(), stats.GetLastFrameRotationPropagations());
+
+    // Setting the frame does not start a statistics frame
+    machine->SetMachineFrame(31);
+    ASSERT_EQ(1u, stats.GetFrames());
+    ASSERT_EQ(31u, stats.GetCalls(ComponentType::Crank, MachinePhase::Update));
+
+    // Nothing to do when the frame does not change
+    statistics->BeginStatisticsFrame();
+    machine->SetMachineFrame(31);
+    ASSERT_EQ(2u, stats.GetFrames());
+    ASSERT_EQ(0u, stats.GetLastFrameRotationPropagations());
+
+    statistics->ClearStatistics();
+    ASSERT_EQ(0u, stats.GetCalls(ComponentType::Crank, MachinePhase::Update));
+}
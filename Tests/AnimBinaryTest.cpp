@@ -0,0 +1,258 @@
+/**
+ * @file AnimBinaryTest.cpp
+ * @author Shawn_Porto
+ */
+
+#include <pch.h>
+#include "gtest/gtest.h"
+
+#include <wx/filename.h>
+#include <wx/file.h>
+
+#include <functional>
+
+#include <AnimBinary.h>
+#include <AnimChannelAngle.h>
+#include <AnimChannelPoint.h>
+#include <Timeline.h>
+
+/**
+ * Get a name for a temporary binary animation file
+ * @return Filename that does not exist yet
+ */
+static std::wstring TempAnimFile()
+{
+    auto name = wxFileName::CreateTempFileName(L"anim-binary-test");
+    wxRemoveFile(name);
+    return (name + L".animb").ToStdWstring();
+}
+
+TEST(AnimBinaryTest, SaveLoad)
+{
+    Timeline timeline;
+    AnimChannelAngle angle;
+    AnimChannelPoint point;
+    AnimChannelAngle empty;
+    angle.SetName(L"actor:arm");
+    point.SetName(L"actor:position");
+    empty.SetName(L"actor:leg");
+    timeline.AddChannel(&angle);
+    timeline.AddChannel(&point);
+    timeline.AddChannel(&empty);
+
+    timeline.SetNumFrames(450);
+    timeline.SetFrameRate(32);
+    for (int k = 0; k < 100; k++)
+    {
+        angle.SetKeyframe(k * 4, k * 0.25);
+        point.SetKeyframe(k * 3, wxPoint(k, -k * 2));
+    }
+
+    AnimBinary binary;
+    binary.AddMachine(30, 2);
+    binary.AddMachine(100, 1);
+
+    auto filename = TempAnimFile();
+    ASSERT_TRUE(binary.Save(filename, &timeline));
+    ASSERT_TRUE(AnimBinary::IsBinaryFile(filename));
+
+    // Load into a fresh timeline, with the channels added in another order
+    Timeline loaded;
+    AnimChannelPoint loadedPoint;
+    AnimChannelAngle loadedAngle;
+    AnimChannelAngle loadedEmpty;
+    loadedPoint.SetName(L"actor:position");
+    loadedAngle.SetName(L"actor:arm");
+    loadedEmpty.SetName(L"actor:leg");
+    loaded.AddChannel(&loadedPoint);
+    loaded.AddChannel(&loadedAngle);
+    loaded.AddChannel(&loadedEmpty);
+
+    AnimBinary loader;
+    ASSERT_TRUE(loader.Load(filename, &loaded));
+    wxRemoveFile(filename);
+
+    ASSERT_EQ(450, loaded.GetNumFrames());
+    ASSERT_EQ(32, loaded.GetFrameRate());
+
+    ASSERT_EQ(100, loadedAngle.GetNumKeyframes());
+    ASSERT_EQ(100, loadedPoint.GetNumKeyframes());
+    ASSERT_FALSE(loadedEmpty.IsValid());
+    for (int k = 0; k < 100; k++)
+    {
+        ASSERT_EQ(k * 4, loadedAngle.GetKeyframeFrame(k));
+        ASSERT_EQ(k * 0.25, loadedAngle.GetKeyframeAngle(k));
+        ASSERT_EQ(k * 3, loadedPoint.GetKeyframeFrame(k));
+        ASSERT_EQ(wxPoint(k, -k * 2), loadedPoint.GetKeyframePoint(k));
+    }
+
+    ASSERT_EQ(2u, loader.GetMachines().size());
+    ASSERT_EQ(30, loader.GetMachines()[0].mFrameStart);
+    ASSERT_EQ(2, loader.GetMachines()[0].mMachineNumber);
+    ASSERT_EQ(100, loader.GetMachines()[1].mFrameStart);
+    ASSERT_EQ(1, loader.GetMachines()[1].mMachineNumber);
+
+    // The loaded timeline is evaluated and seeks as usual
+    loaded.SetCurrentTime(2.0 / 32);
+    ASSERT_NEAR(0.125, loadedAngle.GetAngle(), 0.00001);
+}
+
+TEST(AnimBinaryTest, Rejects)
+{
+    Timeline timeline;
+    AnimChannelAngle angle;
+    angle.SetName(L"angle");
+    timeline.AddChannel(&angle);
+    angle.SetKeyframe(10, 1.0);
+
+    // Not a binary animation file
+    auto filename = TempAnimFile();
+    {
+        wxFile file;
+        ASSERT_TRUE(file.Create(filename, true));
+        std::string xml = "<?xml version=\"1.0\"?><anim/>";
+        file.Write(xml.c_str(), xml.size());
+    }
+
+    AnimBinary binary;
+    ASSERT_FALSE(AnimBinary::IsBinaryFile(filename));
+    ASSERT_FALSE(binary.Load(filename, &timeline));
+
+    // A truncated file is rejected and leaves the timeline alone
+    ASSERT_TRUE(binary.Save(filename, &timeline));
+    {
+        wxFile file(filename, wxFile::read_write);
+        ASSERT_TRUE(file.IsOpened());
+        std::vector<char> data(file.Length());
+        file.Read(data.data(), data.size());
+        file.Close();
+
+        ASSERT_TRUE(file.Create(filename, true));
+        file.Write(data.data(), data.size() - 8);
+    }
+
+    ASSERT_TRUE(AnimBinary::IsBinaryFile(filename));
+    ASSERT_FALSE(binary.Load(filename, &timeline));
+    ASSERT_EQ(1, angle.GetNumKeyframes());
+
+    wxRemoveFile(filename);
+    ASSERT_FALSE(AnimBinary::IsBinaryFile(filename));
+}
+
+TEST(AnimBinaryTest, RejectsUnsortedFrames)
+{
+    Timeline saved;
+    AnimChannelAngle savedFirst;
+    AnimChannelAngle savedSecond;
+    savedFirst.SetName(L"first");
+    savedSecond.SetName(L"second");
+    saved.AddChannel(&savedFirst);
+    saved.AddChannel(&savedSecond);
+    saved.SetNumFrames(600);
+    saved.SetFrameRate(24);
+    for (int k = 0; k < 4; k++)
+    {
+        savedFirst.SetKeyframe(k * 10, k * 1.0);
+        savedSecond.SetKeyframe(k * 20, k * 2.0);
+    }
+
+    AnimBinary binary;
+    auto filename = TempAnimFile();
+    ASSERT_TRUE(binary.Save(filename, &saved));
+
+    // Swap two keyframe frames of the second channel
+    {
+        wxFile file(filename, wxFile::read_write);
+        ASSERT_TRUE(file.IsOpened());
+        std::vector<char> data(file.Length());
+        file.Read(data.data(), data.size());
+        file.Close();
+
+        auto header = (const AnimBinaryHeader *)data.data();
+        auto entries = (const AnimBinaryChannel *)(data.data() + header->mChannelsOffset);
+        ASSERT_EQ(2u, header->mNumChannels);
+        auto frames = (int32_t *)(data.data() + entries[1].mFramesOffset);
+        std::swap(frames[1], frames[2]);
+
+        ASSERT_TRUE(file.Create(filename, true));
+        file.Write(data.data(), data.size());
+    }
+
+    // The file is rejected before the timeline is cleared,
+    // even though the first channel would have loaded
+    Timeline timeline;
+    AnimChannelAngle first;
+    AnimChannelAngle second;
+    first.SetName(L"first");
+    second.SetName(L"second");
+    timeline.AddChannel(&first);
+    timeline.AddChannel(&second);
+    timeline.SetNumFrames(300);
+    timeline.SetFrameRate(30);
+    first.SetKeyframe(5, 0.5);
+    second.SetKeyframe(7, 0.7);
+
+    ASSERT_FALSE(binary.Load(filename, &timeline));
+    wxRemoveFile(filename);
+
+    ASSERT_EQ(300, timeline.GetNumFrames());
+    ASSERT_EQ(30, timeline.GetFrameRate());
+    ASSERT_EQ(1, first.GetNumKeyframes());
+    ASSERT_EQ(5, first.GetKeyframeFrame(0));
+    ASSERT_EQ(1, second.GetNumKeyframes());
+    ASSERT_EQ(7, second.GetKeyframeFrame(0));
+}
+
+TEST(AnimBinaryTest, RejectsHeader)
+{
+    Timeline timeline;
+    AnimChannelAngle angle;
+    angle.SetName(L"angle");
+    timeline.AddChannel(&angle);
+    timeline.SetNumFrames(200);
+    angle.SetKeyframe(10, 1.0);
+
+    AnimBinary binary;
+    auto filename = TempAnimFile();
+    ASSERT_TRUE(binary.Save(filename, &timeline));
+
+    std::vector<char> data;
+    {
+        wxFile file(filename, wxFile::read);
+        ASSERT_TRUE(file.IsOpened());
+        data.resize(file.Length());
+        file.Read(data.data(), data.size());
+    }
+
+    auto header = (AnimBinaryHeader *)data.data();
+    ASSERT_EQ(AnimBinaryByteOrder, header->mByteOrder);
+
+    // Write a copy of the file with a changed header and try to load it
+    auto loadChanged = [&](std::function<void(AnimBinaryHeader *)> change) {
+        auto changed = data;
+        change((AnimBinaryHeader *)changed.data());
+
+        wxFile file;
+        EXPECT_TRUE(file.Create(filename, true));
+        file.Write(changed.data(), changed.size());
+        file.Close();
+
+        return binary.Load(filename, &timeline);
+    };
+
+    // Written on a machine of the other byte order
+    ASSERT_FALSE(loadChanged([](AnimBinaryHeader *h) { h->mByteOrder = 0x04030201; }));
+
+    // Frame counts that are negative, zero or absurd
+    ASSERT_FALSE(loadChanged([](AnimBinaryHeader *h) { h->mNumFrames = -5; }));
+    ASSERT_FALSE(loadChanged([](AnimBinaryHeader *h) { h->mNumFrames = 0; }));
+    ASSERT_FALSE(loadChanged([](AnimBinaryHeader *h) { h->mNumFrames = AnimBinaryMaxFrames + 1; }));
+
+    // None of them touched the timeline
+    ASSERT_EQ(200, timeline.GetNumFrames());
+    ASSERT_EQ(1, angle.GetNumKeyframes());
+
+    // The unchanged file still loads
+    ASSERT_TRUE(loadChanged([](AnimBinaryHeader *h) {}));
+    wxRemoveFile(filename);
+}
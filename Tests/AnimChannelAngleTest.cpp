@@ -7,10 +7,205 @@
 #include "gtest/gtest.h"
 
 #include <AnimChannelAngle.h>
+#include <Timeline.h>
+
+#include <thread>
 
 TEST(AnimChannelAngleTest, Name)
 {
     AnimChannelAngle channel;
     channel.SetName(L"abcdexx");
     ASSERT_EQ(std::wstring(L"abcdexx"), channel.GetName());
-}
\ No newline at end of file
+}
+
+/**
+ * Set a keyframe on a channel at a frame
+ * @param timeline Timeline the channel is on
+ * @param channel Channel to set the keyframe on
+ * @param frame Frame to set the keyframe at
+ * @param angle Angle for the keyframe
+ */
+static void SetKeyframeAt(Timeline &timeline, AnimChannelAngle &channel, int frame, double angle)
+{
+    timeline.SetCurrentTime((double)frame / timeline.GetFrameRate());
+    channel.SetKeyframe(angle);
+}
+
+TEST(AnimChannelAngleTest, Keyframes)
+{
+    Timeline timeline;
+    AnimChannelAngle channel;
+    timeline.AddChannel(&channel);
+
+    ASSERT_FALSE(channel.IsValid());
+
+    // Set keyframes out of order, they are kept sorted
+    SetKeyframeAt(timeline, channel, 60, 2.0);
+    SetKeyframeAt(timeline, channel, 0, 0.0);
+    SetKeyframeAt(timeline, channel, 30, 1.0);
+    SetKeyframeAt(timeline, channel, 90, 3.0);
+
+    ASSERT_TRUE(channel.IsValid());
+    ASSERT_EQ(4, channel.GetNumKeyframes());
+    for (int k = 0; k < 4; k++)
+    {
+        ASSERT_EQ(k * 30, channel.GetKeyframeFrame(k));
+        ASSERT_NEAR(k, channel.GetKeyframeAngle(k), 0.00001);
+    }
+
+    // Setting a keyframe on an existing frame replaces it
+    SetKeyframeAt(timeline, channel, 30, 1.5);
+    ASSERT_EQ(4, channel.GetNumKeyframes());
+    ASSERT_NEAR(1.5, channel.GetKeyframeAngle(1), 0.00001);
+    SetKeyframeAt(timeline, channel, 30, 1.0);
+}
+
+TEST(AnimChannelAngleTest, Seek)
+{
+    Timeline timeline;
+    AnimChannelAngle channel;
+    timeline.AddChannel(&channel);
+
+    // A power of two rate, so frame / rate * rate gives back the frame exactly
+    timeline.SetFrameRate(32);
+
+    for (int k = 0; k <= 100; k++)
+    {
+        SetKeyframeAt(timeline, channel, k * 10, k * 0.1);
+    }
+
+    // Seek around in no particular order. Between keyframes
+    // the angle is tweened linearly.
+    int frames[] = {505, 3, 999, 1000, 250, 251, 10, 0, 777, 1200, 5};
+    for (auto frame : frames)
+    {
+        timeline.SetCurrentTime((double)frame / timeline.GetFrameRate());
+        double expected = frame >= 1000 ? 10.0 : frame * 0.01;
+        ASSERT_NEAR(expected, channel.GetAngle(), 0.00001) << "Frame " << frame;
+    }
+
+    // Play through frame by frame
+    for (int frame = 0; frame <= 1000; frame++)
+    {
+        timeline.SetCurrentTime((double)frame / timeline.GetFrameRate());
+        ASSERT_NEAR(frame * 0.01, channel.GetAngle(), 0.00001) << "Frame " << frame;
+    }
+}
+
+TEST(AnimChannelAngleTest, Evaluate)
+{
+    Timeline timeline;
+    AnimChannelAngle channel;
+    timeline.AddChannel(&channel);
+
+    ASSERT_NEAR(0, channel.Evaluate(1.0), 0.00001);
+
+    for (int k = 0; k <= 20; k++)
+    {
+        SetKeyframeAt(timeline, channel, 10 + k * 7, k * 0.3);
+    }
+
+    timeline.SetCurrentTime(50.0 / timeline.GetFrameRate());
+    double current = channel.GetAngle();
+
+    // Evaluate agrees with setting the time, before, between and after the keyframes
+    std::vector<double> expected;
+    for (int frame = 0; frame <= 200; frame++)
+    {
+        timeline.SetCurrentTime((double)frame / timeline.GetFrameRate());
+        expected.push_back(channel.GetAngle());
+    }
+
+    timeline.SetCurrentTime(50.0 / timeline.GetFrameRate());
+    for (int frame = 0; frame <= 200; frame++)
+    {
+        ASSERT_NEAR(expected[frame], channel.Evaluate((double)frame / timeline.GetFrameRate()), 0.00001) << "Frame " << frame;
+    }
+
+    // Several threads evaluate different frames at once
+    // without disturbing the current angle
+    std::vector<double> results(4 * 201);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; i++)
+    {
+        threads.emplace_back([&, i] {
+            for (int frame = 200; frame >= 0; frame--)
+            {
+                results[i * 201 + frame] = channel.Evaluate((double)frame / timeline.GetFrameRate());
+            }
+        });
+    }
+
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    for (int i = 0; i < (int)results.size(); i++)
+    {
+        ASSERT_NEAR(expected[i % 201], results[i], 0.00001);
+    }
+
+    ASSERT_NEAR(current, channel.GetAngle(), 0.00001);
+}
+
+TEST(AnimChannelAngleTest, ClearKeyframe)
+{
+    Timeline timeline;
+    AnimChannelAngle channel;
+    timeline.AddChannel(&channel);
+
+    SetKeyframeAt(timeline, channel, 0, 0.0);
+    SetKeyframeAt(timeline, channel, 30, 1.0);
+    SetKeyframeAt(timeline, channel, 60, 2.0);
+
+    // Not on a keyframe, nothing happens
+    timeline.SetCurrentTime(15.0 / timeline.GetFrameRate());
+    channel.ClearKeyframe();
+    ASSERT_EQ(3, channel.GetNumKeyframes());
+
+    // On a keyframe, it is removed
+    timeline.SetCurrentTime(30.0 / timeline.GetFrameRate());
+    channel.ClearKeyframe();
+    ASSERT_EQ(2, channel.GetNumKeyframes());
+    ASSERT_EQ(60, channel.GetKeyframeFrame(1));
+    ASSERT_NEAR(2.0, channel.GetKeyframeAngle(1), 0.00001);
+
+    // And the angle now tweens across the gap
+    timeline.SetCurrentTime(30.0 / timeline.GetFrameRate());
+    ASSERT_NEAR(1.0, channel.GetAngle(), 0.00001);
+
+    channel.Clear();
+    ASSERT_FALSE(channel.IsValid());
+}
+
+TEST(AnimChannelAngleTest, SaveLoad)
+{
+    Timeline timeline;
+    AnimChannelAngle channel;
+    channel.SetName(L"angle");
+    timeline.AddChannel(&channel);
+
+    SetKeyframeAt(timeline, channel, 0, 0.25);
+    SetKeyframeAt(timeline, channel, 45, -1.5);
+
+    wxXmlNode root(wxXML_ELEMENT_NODE, L"anim");
+    timeline.Save(&root);
+
+    // The file format is a channel with keyframe children
+    auto channelNode = root.GetChildren();
+    ASSERT_EQ(wxString(L"channel"), channelNode->GetName());
+    ASSERT_EQ(wxString(L"angle"), channelNode->GetAttribute(L"name", L""));
+    auto keyframeNode = channelNode->GetChildren();
+    ASSERT_EQ(wxString(L"keyframe"), keyframeNode->GetName());
+    ASSERT_EQ(wxString(L"0"), keyframeNode->GetAttribute(L"frame", L""));
+    keyframeNode = keyframeNode->GetNext();
+    ASSERT_EQ(wxString(L"45"), keyframeNode->GetAttribute(L"frame", L""));
+    ASSERT_EQ(nullptr, keyframeNode->GetNext());
+
+    timeline.Load(&root);
+    ASSERT_EQ(2, channel.GetNumKeyframes());
+    ASSERT_EQ(45, channel.GetKeyframeFrame(1));
+    ASSERT_NEAR(0.25, channel.GetKeyframeAngle(0), 0.00001);
+    ASSERT_NEAR(-1.5, channel.GetKeyframeAngle(1), 0.00001);
+}
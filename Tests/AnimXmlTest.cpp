@@ -0,0 +1,196 @@
+/**
+ * @file AnimXmlTest.cpp
+ * @author Shawn_Porto
+ */
+
+#include <pch.h>
+#include "gtest/gtest.h"
+
+#include <wx/filename.h>
+#include <wx/file.h>
+
+#include <AnimXmlReader.h>
+#include <AnimXmlWriter.h>
+#include <AnimChannelAngle.h>
+#include <AnimChannelPoint.h>
+#include <Timeline.h>
+#include <Picture.h>
+
+/**
+ * Get a name for a temporary XML animation file
+ * @return Filename that does not exist yet
+ */
+static std::wstring TempAnimFile()
+{
+    auto name = wxFileName::CreateTempFileName(L"anim-xml-test");
+    wxRemoveFile(name);
+    return (name + L".anim").ToStdWstring();
+}
+
+/**
+ * Write text to a file
+ * @param filename File to write
+ * @param text Contents of the file
+ */
+static void WriteFile(const std::wstring &filename, const std::string &text)
+{
+    wxFile file;
+    ASSERT_TRUE(file.Create(filename, true));
+    file.Write(text.c_str(), text.size());
+}
+
+TEST(AnimXmlTest, SaveLoad)
+{
+    Timeline timeline;
+    AnimChannelAngle angle;
+    AnimChannelPoint point;
+    angle.SetName(L"Harold & \"Sparty\" <arm>");
+    point.SetName(L"Harold:position");
+    timeline.AddChannel(&angle);
+    timeline.AddChannel(&point);
+
+    timeline.SetNumFrames(900);
+    for (int k = 0; k < 5000; k++)
+    {
+        angle.SetKeyframe(k * 2, k * 0.5);
+        point.SetKeyframe(k * 3, wxPoint(k, -k));
+    }
+
+    auto filename = TempAnimFile();
+    AnimXmlWriter writer;
+    ASSERT_TRUE(writer.Open(filename));
+
+    wxXmlNode root(wxXML_ELEMENT_NODE, L"anim");
+    timeline.XmlSaveAttributes(&root);
+    writer.StartElement(&root);
+    timeline.Save(&writer);
+    writer.EndElement();
+    ASSERT_TRUE(writer.Close());
+
+    Timeline loaded;
+    AnimChannelAngle loadedAngle;
+    AnimChannelPoint loadedPoint;
+    loadedAngle.SetName(angle.GetName());
+    loadedPoint.SetName(point.GetName());
+    loaded.AddChannel(&loadedPoint);
+    loaded.AddChannel(&loadedAngle);
+
+    int numElements = 0;
+    AnimXmlReader reader;
+    ASSERT_TRUE(reader.Parse(filename, [&](wxXmlNode *element, int depth) {
+        if (depth == 0)
+        {
+            loaded.XmlStartLoad(element);
+        }
+        else
+        {
+            loaded.XmlLoadElement(element, depth);
+        }
+        numElements++;
+    }));
+    loaded.XmlEndLoad();
+    wxRemoveFile(filename);
+
+    // The root, two channels and their keyframes
+    ASSERT_EQ(1 + 2 + 10000, numElements);
+    ASSERT_EQ(900, loaded.GetNumFrames());
+    ASSERT_EQ(5000, loadedAngle.GetNumKeyframes());
+    ASSERT_EQ(5000, loadedPoint.GetNumKeyframes());
+    for (int k = 0; k < 5000; k++)
+    {
+        ASSERT_EQ(k * 2, loadedAngle.GetKeyframeFrame(k));
+        ASSERT_NEAR(k * 0.5, loadedAngle.GetKeyframeAngle(k), 0.00001);
+        ASSERT_EQ(k * 3, loadedPoint.GetKeyframeFrame(k));
+        ASSERT_EQ(wxPoint(k, -k), loadedPoint.GetKeyframePoint(k));
+    }
+}
+
+TEST(AnimXmlTest, Reader)
+{
+    auto filename = TempAnimFile();
+    WriteFile(filename, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                        "<!-- comment with <tags> -->\n"
+                        "<anim a='1 &lt; 2' b=\"&#65;&#x42;&amp;\">\n"
+                        "  <channel name=\"x > y\">text</channel>\n"
+                        "  <empty/>\n"
+                        "</anim>\n");
+
+    std::vector<std::wstring> names;
+    std::vector<int> depths;
+    AnimXmlReader reader;
+    ASSERT_TRUE(reader.Parse(filename, [&](wxXmlNode *element, int depth) {
+        names.push_back(element->GetName().ToStdWstring());
+        depths.push_back(depth);
+        if (depth == 0)
+        {
+            ASSERT_EQ(wxString(L"1 < 2"), element->GetAttribute(L"a", L""));
+            ASSERT_EQ(wxString(L"AB&"), element->GetAttribute(L"b", L""));
+        }
+        else if (names.back() == L"channel")
+        {
+            ASSERT_EQ(wxString(L"x > y"), element->GetAttribute(L"name", L""));
+        }
+    }));
+
+    ASSERT_EQ((std::vector<std::wstring>{L"anim", L"channel", L"empty"}), names);
+    ASSERT_EQ((std::vector<int>{0, 1, 1}), depths);
+
+    // Malformed files are rejected
+    auto noop = [](wxXmlNode *element, int depth) {};
+
+    WriteFile(filename, "<anim><channel></anim>");
+    ASSERT_FALSE(reader.Parse(filename, noop));
+
+    WriteFile(filename, "<anim><channel name=\"x\"");
+    ASSERT_FALSE(reader.Parse(filename, noop));
+
+    WriteFile(filename, "<anim b=\"&bogus;\"/>");
+    ASSERT_FALSE(reader.Parse(filename, noop));
+
+    WriteFile(filename, "");
+    ASSERT_FALSE(reader.Parse(filename, noop));
+
+    wxRemoveFile(filename);
+    ASSERT_FALSE(reader.Parse(filename, noop));
+}
+
+TEST(AnimXmlTest, TruncatedLeavesAnimation)
+{
+    AnimChannelAngle channel;
+    channel.SetName(L"a");
+
+    Picture picture;
+    auto timeline = picture.GetTimeline();
+    timeline->AddChannel(&channel);
+    timeline->SetNumFrames(120);
+    timeline->SetFrameRate(24);
+    channel.SetKeyframe(0, 1.0);
+    channel.SetKeyframe(60, 2.0);
+
+    // The file is cut off partway through a channel, after
+    // its root and some keyframes have already been read
+    auto filename = TempAnimFile();
+    WriteFile(filename, "<?xml version=\"1.0\"?>\n<anim numframes=\"900\" framerate=\"30\">"
+                        "<channel name=\"a\"><keyframe frame=\"5\" angle=\"7\"/>"
+                        "<keyframe frame=\"10\" angle=\"8\"/><keyframe fr");
+    ASSERT_FALSE(picture.Load(filename));
+
+    ASSERT_EQ(120, timeline->GetNumFrames());
+    ASSERT_EQ(24, timeline->GetFrameRate());
+    ASSERT_EQ(2, channel.GetNumKeyframes());
+    ASSERT_EQ(60, channel.GetKeyframeFrame(1));
+    ASSERT_NEAR(2.0, channel.GetKeyframeAngle(1), 0.00001);
+
+    // The same file complete replaces the animation
+    WriteFile(filename, "<?xml version=\"1.0\"?>\n<anim numframes=\"900\" framerate=\"30\">"
+                        "<channel name=\"a\"><keyframe frame=\"5\" angle=\"7\"/>"
+                        "<keyframe frame=\"10\" angle=\"8\"/></channel></anim>");
+    ASSERT_TRUE(picture.Load(filename));
+
+    ASSERT_EQ(900, timeline->GetNumFrames());
+    ASSERT_EQ(30, timeline->GetFrameRate());
+    ASSERT_EQ(2, channel.GetNumKeyframes());
+    ASSERT_EQ(10, channel.GetKeyframeFrame(1));
+
+    wxRemoveFile(filename);
+}
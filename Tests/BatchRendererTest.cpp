@@ -0,0 +1,149 @@
+/**
+ * @file BatchRendererTest.cpp
+ * @author Shawn_Porto
+ */
+
+#include <pch.h>
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <mutex>
+
+#include <BatchRenderer.h>
+#include <Picture.h>
+#include <Actor.h>
+#include <PolyDrawable.h>
+
+/// Frames in the test animation
+const int BatchTestFrames = 100;
+
+/**
+ * Create a small picture with a square that moves across it
+ * @return The picture
+ */
+static std::shared_ptr<Picture> CreateMovingSquare()
+{
+    auto picture = std::make_shared<Picture>();
+    picture->SetSize(wxSize(64, 48));
+
+    auto actor = std::make_shared<Actor>(L"Square");
+    auto square = std::make_shared<PolyDrawable>(L"Square");
+    square->SetColor(*wxBLACK);
+    square->AddPoint(wxPoint(0, 0));
+    square->AddPoint(wxPoint(8, 0));
+    square->AddPoint(wxPoint(8, 8));
+    square->AddPoint(wxPoint(0, 8));
+    actor->AddDrawable(square);
+    actor->SetRoot(square);
+    picture->AddActor(actor);
+
+    auto timeline = picture->GetTimeline();
+    timeline->SetNumFrames(BatchTestFrames);
+
+    actor->SetPosition(wxPoint(0, 10));
+    actor->SetKeyframe();
+    picture->SetAnimationTime((double)BatchTestFrames / timeline->GetFrameRate());
+    actor->SetPosition(wxPoint(56, 30));
+    actor->SetKeyframe();
+    return picture;
+}
+
+TEST(BatchRendererTest, InOrder)
+{
+    std::atomic<int> created = 0;
+    BatchRenderer renderer([&created]() {
+        created++;
+        return CreateMovingSquare();
+    });
+    renderer.SetNumThreads(3);
+
+    // A single picture rendering the same frames
+    auto picture = CreateMovingSquare();
+    auto frameRate = picture->GetTimeline()->GetFrameRate();
+
+    int next = 5;
+    ASSERT_TRUE(renderer.Render(5, BatchTestFrames, [&](int frame, const wxImage &image) {
+        EXPECT_EQ(next, frame);
+        next++;
+
+        picture->SetAnimationTime((double)frame / frameRate);
+        auto expected = picture->RenderImage();
+        EXPECT_EQ(expected.GetSize(), image.GetSize());
+        EXPECT_EQ(0, memcmp(expected.GetData(), image.GetData(), expected.GetWidth() * expected.GetHeight() * 3));
+        return true;
+    }));
+
+    ASSERT_EQ(BatchTestFrames + 1, next);
+
+    // Every thread has its own picture
+    ASSERT_EQ(3, created);
+}
+
+TEST(BatchRendererTest, Stop)
+{
+    BatchRenderer renderer(CreateMovingSquare);
+    renderer.SetNumThreads(4);
+    renderer.SetScale(0.5);
+
+    int count = 0;
+    ASSERT_FALSE(renderer.Render(0, BatchTestFrames, [&count](int frame, const wxImage &image) {
+        EXPECT_EQ(wxSize(32, 24), image.GetSize());
+        return ++count < 10;
+    }));
+    ASSERT_EQ(10, count);
+
+    // Nothing to render
+    ASSERT_TRUE(renderer.Render(10, 9, [](int frame, const wxImage &image) { return false; }));
+}
+
+TEST(BatchRendererTest, NoPicture)
+{
+    BatchRenderer renderer([]() { return std::shared_ptr<Picture>(); });
+    renderer.SetNumThreads(2);
+
+    int count = 0;
+    ASSERT_FALSE(renderer.Render(0, 40, [&count](int frame, const wxImage &image) {
+        count++;
+        return true;
+    }));
+    ASSERT_EQ(0, count);
+}
+
+TEST(BatchRendererTest, Silent)
+{
+    std::mutex mutex;
+    std::vector<std::shared_ptr<Picture>> pictures;
+    BatchRenderer renderer([&mutex, &pictures]() {
+        auto picture = CreateMovingSquare();
+        std::lock_guard<std::mutex> lock(mutex);
+        pictures.push_back(picture);
+        return picture;
+    });
+    renderer.SetNumThreads(2);
+
+    ASSERT_TRUE(renderer.Render(0, BatchTestFrames, [](int frame, const wxImage &image) { return true; }));
+
+    // The machines of every picture give their sounds
+    // to a handler instead of playing them
+    ASSERT_EQ(2u, pictures.size());
+    for (auto &picture : pictures)
+    {
+        ASSERT_TRUE(picture->GetMachineSoundHandler());
+    }
+}
+
+TEST(BatchRendererTest, Rgba)
+{
+    wxImage image(2, 1);
+    image.SetRGB(0, 0, 10, 20, 30);
+    image.SetRGB(1, 0, 40, 50, 60);
+
+    std::vector<unsigned char> rgba;
+    BatchRenderer::ToRgba(image, rgba);
+    ASSERT_EQ((std::vector<unsigned char>{10, 20, 30, 255, 40, 50, 60, 255}), rgba);
+
+    image.InitAlpha();
+    image.SetAlpha(1, 0, 128);
+    BatchRenderer::ToRgba(image, rgba);
+    ASSERT_EQ(128, rgba[7]);
+}
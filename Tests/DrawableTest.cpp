@@ -71,4 +71,69 @@ TEST(DrawableTest, Association)
 
     ASSERT_EQ(&body, arm->GetParent());
     ASSERT_EQ(&body, leg->GetParent());
-}
\ No newline at end of file
+}
+
+TEST(DrawableTest, Placement)
+{
+    DrawableMock body(L"Body");
+    auto arm = std::make_shared<DrawableMock>(L"Arm");
+    auto hand = std::make_shared<DrawableMock>(L"Hand");
+    body.AddChild(arm);
+    arm->AddChild(hand);
+
+    arm->SetPosition(wxPoint(100, 0));
+    hand->SetPosition(wxPoint(50, 0));
+
+    body.Place(wxPoint(10, 20), 0);
+    ASSERT_EQ(wxPoint(160, 20), hand->PlacePoint(wxPoint(0, 0)));
+
+    // Placing again with nothing changed keeps the placement
+    body.Place(wxPoint(10, 20), 0);
+    ASSERT_EQ(wxPoint(160, 20), hand->PlacePoint(wxPoint(0, 0)));
+
+    // Rotating an ancestor moves everything below it
+    arm->SetRotation(M_PI / 2);
+    body.Place(wxPoint(10, 20), 0);
+    ASSERT_EQ(wxPoint(110, -30), hand->PlacePoint(wxPoint(0, 0)));
+    ASSERT_EQ(wxPoint(110, -40), hand->PlacePoint(wxPoint(10, 0)));
+
+    // Moving only the leaf
+    hand->SetPosition(wxPoint(20, 0));
+    body.Place(wxPoint(10, 20), 0);
+    ASSERT_EQ(wxPoint(110, 0), hand->PlacePoint(wxPoint(0, 0)));
+
+    // A new offset for the root
+    body.Place(wxPoint(0, 0), 0);
+    ASSERT_EQ(wxPoint(100, -20), hand->PlacePoint(wxPoint(0, 0)));
+}
+
+TEST(DrawableTest, PlacementCount)
+{
+    DrawableMock body(L"Body");
+    auto arm = std::make_shared<DrawableMock>(L"Arm");
+    body.AddChild(arm);
+
+    body.Place(wxPoint(0, 0), 0);
+    int bodyPlacement = body.GetPlacement();
+    int armPlacement = arm->GetPlacement();
+
+    // Nothing moved, so the placement is unchanged
+    body.Place(wxPoint(0, 0), 0);
+    ASSERT_EQ(bodyPlacement, body.GetPlacement());
+    ASSERT_EQ(armPlacement, arm->GetPlacement());
+
+    // Moving the child changes only its placement
+    arm->SetPosition(wxPoint(10, 0));
+    body.Place(wxPoint(0, 0), 0);
+    ASSERT_EQ(bodyPlacement, body.GetPlacement());
+    ASSERT_NE(armPlacement, arm->GetPlacement());
+    ASSERT_EQ(wxPoint(10, 0), arm->GetPlacedPosition());
+
+    // Rotating the parent changes both
+    armPlacement = arm->GetPlacement();
+    body.SetRotation(0.5);
+    body.Place(wxPoint(0, 0), 0);
+    ASSERT_NE(bodyPlacement, body.GetPlacement());
+    ASSERT_NE(armPlacement, arm->GetPlacement());
+    ASSERT_NEAR(0.5, arm->GetPlacedRotation(), 0.000001);
+}
@@ -0,0 +1,251 @@
+/**
+ * @file FramePrerendererTest.cpp
+ * @author Shawn_Porto
+ */
+
+#include <pch.h>
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <chrono>
+#include <wx/sound.h>
+
+#include <Picture.h>
+#include <PictureObserver.h>
+#include <FramePrerenderer.h>
+#include <Actor.h>
+#include <Drawable.h>
+
+/**
+ * Observer that records whether it was told of a change
+ */
+class PrerenderObserver : public PictureObserver
+{
+public:
+    void UpdateObserver() override { mUpdated = true; }
+
+    /// Was the observer told of a change?
+    bool mUpdated = false;
+};
+
+/**
+ * Stands in for a machine. Each time it is drawn it makes the
+ * sound of the current frame, the way a music box is advanced
+ * and plays its notes when its machine is drawn.
+ */
+class SoundDrawable : public Drawable
+{
+public:
+    /**
+     * Constructor
+     * @param picture Picture the sounds are handled by
+     * @param sounds A sound for each frame
+     */
+    SoundDrawable(Picture *picture, std::vector<wxSound> &sounds) :
+        Drawable(L"Sound"), mPicture(picture), mSounds(sounds) {}
+
+    /**
+     * Make the sound of the current frame
+     * @param graphics Graphics context, not used
+     */
+    void Draw(std::shared_ptr<wxGraphicsContext> graphics) override
+    {
+        auto sound = &mSounds[mPicture->GetTimeline()->GetCurrentFrame()];
+        auto &handler = mPicture->GetMachineSoundHandler();
+        if (handler)
+        {
+            handler(sound);
+        }
+        else
+        {
+            mPlayed++;
+        }
+    }
+
+    /**
+     * Hit test, nothing is hit
+     * @param pos Position to test
+     * @return false
+     */
+    bool HitTest(wxPoint pos) override { return false; }
+
+    /// Picture the sounds are handled by
+    Picture *mPicture;
+
+    /// A sound for each frame
+    std::vector<wxSound> &mSounds;
+
+    /// Number of sounds played directly, without a handler
+    std::atomic<int> mPlayed{0};
+};
+
+/**
+ * Wait until the prerenderer has buffered a number of frames
+ * @param prerenderer Prerenderer to wait on
+ * @param count Number of frames
+ * @return true if they were buffered within a few seconds
+ */
+static bool WaitForBuffered(FramePrerenderer *prerenderer, int count)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (prerenderer->GetNumBuffered() < count)
+    {
+        if (std::chrono::steady_clock::now() > deadline)
+        {
+            return false;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    return true;
+}
+
+TEST(FramePrerendererTest, Playback)
+{
+    auto picture = std::make_shared<Picture>();
+    picture->SetSize(wxSize(64, 32));
+
+    PrerenderObserver observer;
+    observer.SetPicture(picture);
+
+    auto prerenderer = picture->GetPrerenderer();
+    prerenderer->SetDepth(3);
+    prerenderer->SetScale(0.5);
+
+    prerenderer->Start(10);
+    ASSERT_TRUE(prerenderer->IsRunning());
+    ASSERT_TRUE(prerenderer->WaitFor(10));
+
+    // The buffer fills up to its depth and no further
+    ASSERT_TRUE(WaitForBuffered(prerenderer, 3));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    ASSERT_EQ(3, prerenderer->GetNumBuffered());
+
+    ASSERT_TRUE(prerenderer->Present(10));
+    ASSERT_EQ(10, prerenderer->GetPresentedFrame());
+    ASSERT_TRUE(prerenderer->GetPresented().IsOk());
+
+    // Frame 11 was due while 10 was shown, so it is skipped
+    ASSERT_TRUE(WaitForBuffered(prerenderer, 3));
+    ASSERT_TRUE(prerenderer->Present(12));
+    ASSERT_EQ(12, prerenderer->GetPresentedFrame());
+
+    // A frame the worker has not got to yet is dropped, and the
+    // worker skips ahead to the frames after it
+    ASSERT_FALSE(prerenderer->Present(100));
+    ASSERT_TRUE(prerenderer->WaitFor(101));
+    ASSERT_TRUE(prerenderer->Present(101));
+
+    // The worker never tells the observers, it is not their thread
+    ASSERT_FALSE(observer.mUpdated);
+
+    // Stopping leaves the picture at the frame presented
+    prerenderer->Stop();
+    ASSERT_FALSE(prerenderer->IsRunning());
+    ASSERT_EQ(-1, prerenderer->GetPresentedFrame());
+    ASSERT_EQ(101, picture->GetTimeline()->GetCurrentFrame());
+    ASSERT_TRUE(observer.mUpdated);
+}
+
+TEST(FramePrerendererTest, End)
+{
+    auto picture = std::make_shared<Picture>();
+    picture->SetSize(wxSize(16, 16));
+
+    auto timeline = picture->GetTimeline();
+    auto prerenderer = picture->GetPrerenderer();
+
+    // Nothing is rendered past the end of the animation
+    prerenderer->Start(timeline->GetNumFrames() - 1);
+    ASSERT_TRUE(prerenderer->WaitFor(timeline->GetNumFrames() - 1));
+    ASSERT_FALSE(prerenderer->WaitFor(timeline->GetNumFrames()));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    ASSERT_EQ(1, prerenderer->GetNumBuffered());
+
+    // Stopping before anything is presented returns to the start
+    prerenderer->Stop();
+    ASSERT_EQ(timeline->GetNumFrames() - 1, timeline->GetCurrentFrame());
+
+    // Destroying the picture while the worker runs stops it
+    prerenderer->Start(0);
+}
+
+TEST(FramePrerendererTest, LastFrame)
+{
+    auto picture = std::make_shared<Picture>();
+    picture->SetSize(wxSize(16, 16));
+
+    auto timeline = picture->GetTimeline();
+    auto prerenderer = picture->GetPrerenderer();
+    int numFrames = timeline->GetNumFrames();
+
+    // The last frame handed out is the last frame of the animation
+    prerenderer->Start(numFrames - 3);
+    ASSERT_TRUE(WaitForBuffered(prerenderer, 3));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    ASSERT_EQ(3, prerenderer->GetNumBuffered());
+
+    ASSERT_TRUE(prerenderer->Present(numFrames - 1));
+    ASSERT_EQ(numFrames - 1, prerenderer->GetPresentedFrame());
+    ASSERT_EQ(0, prerenderer->GetNumBuffered());
+
+    // Nothing after it is ever rendered
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    ASSERT_EQ(0, prerenderer->GetNumBuffered());
+    ASSERT_FALSE(prerenderer->Present(numFrames));
+    ASSERT_EQ(numFrames - 1, prerenderer->GetPresentedFrame());
+
+    prerenderer->Stop();
+    ASSERT_EQ(numFrames - 1, timeline->GetCurrentFrame());
+}
+
+TEST(FramePrerendererTest, Sounds)
+{
+    auto picture = std::make_shared<Picture>();
+    picture->SetSize(wxSize(16, 16));
+
+    std::vector<wxSound> sounds(picture->GetTimeline()->GetNumFrames() + 1);
+    auto drawable = std::make_shared<SoundDrawable>(picture.get(), sounds);
+    auto actor = std::make_shared<Actor>(L"Machine");
+    actor->AddDrawable(drawable);
+    actor->SetRoot(drawable);
+    picture->AddActor(actor);
+
+    // The frames whose sounds were played, in order
+    std::vector<int> played;
+    auto prerenderer = picture->GetPrerenderer();
+    prerenderer->SetSoundPlayer([&played, &sounds](wxSound *sound) {
+        played.push_back((int)(sound - sounds.data()));
+    });
+    prerenderer->SetDepth(4);
+
+    // Rendering ahead plays nothing
+    prerenderer->Start(10);
+    ASSERT_TRUE(WaitForBuffered(prerenderer, 4));
+    ASSERT_TRUE(played.empty());
+
+    // A frame's sounds are played when it is presented
+    ASSERT_TRUE(prerenderer->Present(10));
+    ASSERT_EQ((std::vector<int>{10}), played);
+
+    // Frames that are skipped still make their sounds, late
+    ASSERT_TRUE(WaitForBuffered(prerenderer, 4));
+    ASSERT_TRUE(prerenderer->Present(12));
+    ASSERT_EQ((std::vector<int>{10, 11, 12}), played);
+
+    ASSERT_TRUE(WaitForBuffered(prerenderer, 4));
+    ASSERT_FALSE(prerenderer->Present(50));
+    ASSERT_EQ((std::vector<int>{10, 11, 12, 13, 14, 15, 16}), played);
+
+    ASSERT_TRUE(prerenderer->WaitFor(51));
+    ASSERT_TRUE(prerenderer->Present(51));
+    ASSERT_EQ(51, played.back());
+
+    // No sound was played on the worker
+    ASSERT_EQ(0, drawable->mPlayed.load());
+
+    // Once stopped the machines play their own sounds again
+    prerenderer->Stop();
+    ASSERT_FALSE(picture->GetMachineSoundHandler());
+}
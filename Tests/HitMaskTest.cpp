@@ -0,0 +1,83 @@
+/**
+ * @file HitMaskTest.cpp
+ * @author Shawn_Porto
+ */
+
+#include <pch.h>
+#include "gtest/gtest.h"
+
+#include <HitMask.h>
+
+/**
+ * Check the mask agrees with wxImage::IsTransparent everywhere
+ * @param image Image the mask was built from
+ * @param mask The mask
+ */
+static void CheckAgainstImage(const wxImage &image, const HitMask &mask)
+{
+    ASSERT_EQ(image.GetWidth(), mask.GetWidth());
+    ASSERT_EQ(image.GetHeight(), mask.GetHeight());
+
+    for (int y = 0; y < image.GetHeight(); y++)
+    {
+        for (int x = 0; x < image.GetWidth(); x++)
+        {
+            ASSERT_EQ(!image.IsTransparent(x, y), mask.Contains(x, y)) << "At " << x << ", " << y;
+        }
+    }
+}
+
+TEST(HitMaskTest, Alpha)
+{
+    // Wider than one word so rows span several words
+    wxImage image(150, 20);
+    image.InitAlpha();
+    for (int y = 0; y < image.GetHeight(); y++)
+    {
+        for (int x = 0; x < image.GetWidth(); x++)
+        {
+            image.SetAlpha(x, y, (x * 7 + y * 13) % 256);
+        }
+    }
+
+    HitMask mask;
+    mask.Build(image);
+    CheckAgainstImage(image, mask);
+
+    // Outside the image is never drawn
+    ASSERT_FALSE(mask.Contains(-1, 0));
+    ASSERT_FALSE(mask.Contains(0, -1));
+    ASSERT_FALSE(mask.Contains(150, 0));
+    ASSERT_FALSE(mask.Contains(0, 20));
+}
+
+TEST(HitMaskTest, Mask)
+{
+    wxImage image(70, 10);
+    image.SetRGB(wxRect(0, 0, 70, 10), 10, 20, 30);
+    image.SetRGB(wxRect(5, 2, 40, 4), 255, 0, 255);
+    image.SetMaskColour(255, 0, 255);
+
+    HitMask mask;
+    mask.Build(image);
+    CheckAgainstImage(image, mask);
+
+    ASSERT_TRUE(mask.Contains(0, 0));
+    ASSERT_FALSE(mask.Contains(5, 2));
+}
+
+TEST(HitMaskTest, Opaque)
+{
+    wxImage image(30, 30);
+
+    HitMask mask;
+    mask.Build(image);
+    CheckAgainstImage(image, mask);
+    ASSERT_TRUE(mask.Contains(29, 29));
+
+    // An image that did not load has nothing to hit
+    HitMask empty;
+    empty.Build(wxImage());
+    ASSERT_EQ(0, empty.GetWidth());
+    ASSERT_FALSE(empty.Contains(0, 0));
+}
@@ -0,0 +1,102 @@
+/**
+ * @file KeyframeSummaryTest.cpp
+ * @author Shawn_Porto
+ */
+
+#include <pch.h>
+#include "gtest/gtest.h"
+
+#include <random>
+
+#include <KeyframeSummary.h>
+
+TEST(KeyframeSummaryTest, Empty)
+{
+    KeyframeSummary summary;
+    ASSERT_EQ(0, summary.GetTotal().count);
+    ASSERT_EQ(0, summary.GetTotal().max);
+    ASSERT_EQ(0, summary.Summarize(0, 1000).count);
+
+    // Removing what was never added does nothing
+    summary.Remove(10);
+    summary.Remove(-1);
+    ASSERT_EQ(0, summary.GetTotal().count);
+}
+
+TEST(KeyframeSummaryTest, AddRemove)
+{
+    KeyframeSummary summary;
+    summary.Add(10);
+    summary.Add(10);
+    summary.Add(11);
+    summary.Add(300);
+
+    ASSERT_EQ(4, summary.GetTotal().count);
+    ASSERT_EQ(2, summary.GetTotal().max);
+
+    ASSERT_EQ(2, summary.Summarize(10, 11).count);
+    ASSERT_EQ(3, summary.Summarize(0, 12).count);
+    ASSERT_EQ(1, summary.Summarize(11, 300).count);
+    ASSERT_EQ(1, summary.Summarize(11, 300).max);
+    ASSERT_EQ(2, summary.Summarize(11, 301).count);
+    ASSERT_EQ(0, summary.Summarize(12, 300).count);
+
+    summary.Remove(10);
+    ASSERT_EQ(1, summary.GetTotal().max);
+    ASSERT_EQ(1, summary.Summarize(10, 11).count);
+
+    // Growing past the capacity keeps what is there
+    summary.Add(100000);
+    ASSERT_GE(summary.GetCapacity(), 100001);
+    ASSERT_EQ(4, summary.GetTotal().count);
+    ASSERT_EQ(2, summary.Summarize(0, 100).count);
+    ASSERT_EQ(1, summary.Summarize(100000, 100001).count);
+
+    summary.Clear();
+    ASSERT_EQ(0, summary.GetTotal().count);
+}
+
+TEST(KeyframeSummaryTest, MatchesCounting)
+{
+    // Random keyframes against counting them one at a time
+    const int frames = 3000;
+    std::vector<int> counts(frames);
+    KeyframeSummary summary;
+
+    std::mt19937 random(44);
+    std::uniform_int_distribution<int> frame(0, frames - 1);
+    for (int i = 0; i < 2000; i++)
+    {
+        int f = frame(random);
+        if (counts[f] > 0 && i % 3 == 0)
+        {
+            summary.Remove(f);
+            counts[f]--;
+        }
+        else
+        {
+            summary.Add(f);
+            counts[f]++;
+        }
+    }
+
+    for (int i = 0; i < 200; i++)
+    {
+        int a = frame(random);
+        int b = frame(random);
+        int first = std::min(a, b);
+        int end = std::max(a, b) + 1;
+
+        int count = 0;
+        int max = 0;
+        for (int f = first; f < end; f++)
+        {
+            count += counts[f];
+            max = std::max(max, counts[f]);
+        }
+
+        auto bucket = summary.Summarize(first, end);
+        ASSERT_EQ(count, bucket.count) << first << " to " << end;
+        ASSERT_EQ(max, bucket.max) << first << " to " << end;
+    }
+}
@@ -0,0 +1,229 @@
+/**
+ * @file MachineStateCacheTest.cpp
+ * @author Shawn_Porto
+ */
+
+#include <pch.h>
+#include "gtest/gtest.h"
+
+#include "../MachineLib/IMachineSystem.h"
+#include <MachineStateCache.h>
+#include "../MachineLib/IMachineCheckpoint.h"
+#include "../MachineLib/MachineCheckpoint.h"
+#include "../MachineLib/IMachineStatistics.h"
+#include "../MachineLib/MachineStatistics.h"
+
+/**
+ * Machine system whose state depends on every step it took,
+ * like a box lid that swings a little each frame
+ */
+class CheckpointedSystem : public IMachineSystem, public IMachineCheckpoint
+{
+public:
+    int mNumber = 1;
+    int mFrame = 0;
+    double mSum = 0;
+    int mSteps = 0;
+    int mRestores = 0;
+
+    void SetLocation(wxPoint location) override {}
+    wxPoint GetLocation() override { return wxPoint(0, 0); }
+    void DrawMachine(std::shared_ptr<wxGraphicsContext> graphics) override {}
+    void SetFrameRate(double rate) override {}
+    void ChooseMachine(int machine) override { mNumber = machine; mFrame = 0; mSum = 0; }
+    int GetMachineNumber() override { return mNumber; }
+    double GetMachineTime() override { return mFrame / 30.0; }
+    void SetFlag(int flag) override {}
+
+    void SetMachineFrame(int frame) override
+    {
+        if (frame < mFrame)
+        {
+            mFrame = 0;
+            mSum = 0;
+        }
+
+        while (mFrame < frame)
+        {
+            mFrame++;
+            mSum += mFrame;
+            mSteps++;
+        }
+    }
+
+    std::shared_ptr<MachineCheckpoint> SaveCheckpoint() override
+    {
+        auto checkpoint = std::make_shared<MachineCheckpoint>(mNumber, mFrame, GetMachineTime());
+        checkpoint->Add(mSum);
+        return checkpoint;
+    }
+
+    bool RestoreCheckpoint(const std::shared_ptr<MachineCheckpoint> &checkpoint) override
+    {
+        if (checkpoint->GetMachineNumber() != mNumber)
+        {
+            return false;
+        }
+
+        checkpoint->Rewind();
+        mFrame = checkpoint->GetFrame();
+        mSum = checkpoint->Next();
+        mRestores++;
+        return true;
+    }
+
+    /// The state a machine run straight to its frame would have
+    double Expected() const { return (double)mFrame * (mFrame + 1) / 2; }
+};
+
+/**
+ * Checkpointed machine system that counts the
+ * statistics frames it is told to begin
+ */
+class CountingSystem : public CheckpointedSystem, public IMachineStatistics
+{
+public:
+    int mStatisticsFrames = 0;
+    int mSetFrames = 0;
+    MachineStatistics mStatistics;
+
+    void SetMachineFrame(int frame) override
+    {
+        mSetFrames++;
+        CheckpointedSystem::SetMachineFrame(frame);
+    }
+
+    const MachineStatistics &GetStatistics() override { return mStatistics; }
+    void ClearStatistics() override {}
+    void BeginStatisticsFrame() override { mStatisticsFrames++; }
+};
+
+TEST(MachineStateCacheTest, Checkpoint)
+{
+    MachineCheckpoint checkpoint(2, 45, 1.5);
+    ASSERT_EQ(2, checkpoint.GetMachineNumber());
+    ASSERT_EQ(45, checkpoint.GetFrame());
+    ASSERT_DOUBLE_EQ(1.5, checkpoint.GetTime());
+
+    checkpoint.Add(3);
+    checkpoint.Add(true);
+    ASSERT_EQ(3.0, checkpoint.Next());
+    ASSERT_EQ(1.0, checkpoint.Next());
+
+    // Reading past the end gives zero
+    ASSERT_EQ(0.0, checkpoint.Next());
+
+    checkpoint.Rewind();
+    ASSERT_EQ(3.0, checkpoint.Next());
+}
+
+TEST(MachineStateCacheTest, StepBack)
+{
+    auto system = std::make_shared<CheckpointedSystem>();
+    MachineStateCache cache;
+    cache.SetSystem(system);
+    cache.SetFrameRate(30);
+
+    cache.SetMachineFrame(10000);
+    ASSERT_EQ(10000, system->mFrame);
+    ASSERT_EQ(10000, cache.GetLastSteps());
+    ASSERT_EQ(system->Expected(), system->mSum);
+
+    // Every evenly spaced frame passed was kept, plus the frame jumped to
+    ASSERT_EQ(10000 / MachineCheckpointSpacing + 1, cache.GetNumCheckpoints());
+
+    // Stepping back resumes from the checkpoint before the frame
+    for (int frame = 9999; frame > 9950; frame--)
+    {
+        cache.SetMachineFrame(frame);
+        ASSERT_EQ(frame, system->mFrame);
+        ASSERT_EQ(system->Expected(), system->mSum);
+        ASSERT_LT(cache.GetLastSteps(), MachineCheckpointSpacing);
+    }
+}
+
+TEST(MachineStateCacheTest, Scrub)
+{
+    auto system = std::make_shared<CheckpointedSystem>();
+    MachineStateCache cache;
+    cache.SetSystem(system);
+    cache.SetFrameRate(30);
+
+    cache.SetMachineFrame(5050);
+    cache.SetMachineFrame(5090);
+
+    // Going back to a frame that was visited needs no steps at all
+    cache.SetMachineFrame(5050);
+    ASSERT_EQ(0, cache.GetLastSteps());
+    ASSERT_EQ(system->Expected(), system->mSum);
+
+    // Playback forward does not fill the recent checkpoints
+    int checkpoints = cache.GetNumCheckpoints();
+    for (int frame = 5051; frame < 5099; frame++)
+    {
+        cache.SetMachineFrame(frame);
+        ASSERT_GE(1, cache.GetLastSteps());
+        ASSERT_EQ(system->Expected(), system->mSum);
+    }
+    ASSERT_EQ(checkpoints, cache.GetNumCheckpoints());
+
+    // Only a few recent checkpoints are kept
+    for (int frame = 1; frame < 40; frame++)
+    {
+        cache.SetMachineFrame(frame * 7);
+        ASSERT_EQ(system->Expected(), system->mSum);
+    }
+    ASSERT_GE(5100 / MachineCheckpointSpacing + 1 + MachineRecentCheckpoints, cache.GetNumCheckpoints());
+
+    // Frames before the machine starts are the machine at rest
+    cache.SetMachineFrame(-20);
+    ASSERT_EQ(0, system->mFrame);
+    ASSERT_EQ(0, system->mSum);
+}
+
+TEST(MachineStateCacheTest, Clear)
+{
+    auto system = std::make_shared<CheckpointedSystem>();
+    MachineStateCache cache;
+    cache.SetSystem(system);
+    cache.SetFrameRate(30);
+
+    cache.SetMachineFrame(500);
+    ASSERT_LT(1, cache.GetNumCheckpoints());
+
+    // A new machine does not use the old checkpoints
+    system->ChooseMachine(2);
+    cache.SetMachineFrame(450);
+    ASSERT_EQ(0, system->mRestores);
+    ASSERT_EQ(450, system->mFrame);
+    ASSERT_EQ(system->Expected(), system->mSum);
+
+    // Neither does a new frame rate
+    cache.SetFrameRate(24);
+    ASSERT_EQ(0, cache.GetNumCheckpoints());
+    cache.SetFrameRate(24);
+    cache.SetMachineFrame(300);
+    ASSERT_EQ(300, system->mFrame);
+    ASSERT_EQ(system->Expected(), system->mSum);
+}
+
+TEST(MachineStateCacheTest, StatisticsFrames)
+{
+    auto system = std::make_shared<CountingSystem>();
+    MachineStateCache cache;
+    cache.SetSystem(system);
+    cache.SetFrameRate(30);
+
+    // Reaching a frame takes many steps, but it is one frame
+    cache.SetMachineFrame(1000);
+    ASSERT_LT(1, system->mSetFrames);
+    ASSERT_EQ(1, system->mStatisticsFrames);
+
+    // So is stepping back from a checkpoint
+    cache.SetMachineFrame(950);
+    ASSERT_EQ(1, system->mRestores);
+    ASSERT_EQ(2, system->mStatisticsFrames);
+
+    cache.SetMachineFrame(951);
+    ASSERT_EQ(3, system->mStatisticsFrames);
+}
@@ -0,0 +1,127 @@
+/**
+ * @file PickIndexTest.cpp
+ * @author Shawn_Porto
+ */
+
+#include <pch.h>
+#include "gtest/gtest.h"
+
+#include <Picture.h>
+#include <Actor.h>
+#include <PolyDrawable.h>
+
+/**
+ * Create an actor that is a single square
+ * @param name Actor name
+ * @param position Actor position
+ * @param size Width and height of the square
+ * @return The actor
+ */
+static std::shared_ptr<Actor> CreateSquare(const std::wstring &name, wxPoint position, int size)
+{
+    auto actor = std::make_shared<Actor>(name);
+    actor->SetPosition(position);
+
+    auto square = std::make_shared<PolyDrawable>(name);
+    square->AddPoint(wxPoint(0, 0));
+    square->AddPoint(wxPoint(size, 0));
+    square->AddPoint(wxPoint(size, size));
+    square->AddPoint(wxPoint(0, size));
+
+    actor->AddDrawable(square);
+    actor->SetRoot(square);
+    return actor;
+}
+
+TEST(PickIndexTest, Bounds)
+{
+    auto actor = CreateSquare(L"Square", wxPoint(100, 200), 50);
+    auto square = actor->GetDrawables()[0];
+
+    actor->Place();
+    auto bounds = square->GetBounds();
+    ASSERT_TRUE(bounds.Contains(wxPoint(100, 200)));
+    ASSERT_TRUE(bounds.Contains(wxPoint(150, 250)));
+    ASSERT_FALSE(bounds.Contains(wxPoint(160, 200)));
+
+    // Rotated a quarter turn the square is above the position
+    square->SetRotation(M_PI / 2);
+    actor->Place();
+    bounds = square->GetBounds();
+    ASSERT_TRUE(bounds.Contains(wxPoint(125, 175)));
+    ASSERT_FALSE(bounds.Contains(wxPoint(125, 225)));
+}
+
+TEST(PickIndexTest, Pick)
+{
+    auto picture = std::make_shared<Picture>();
+
+    auto bottom = CreateSquare(L"Bottom", wxPoint(100, 100), 200);
+    auto top = CreateSquare(L"Top", wxPoint(250, 250), 200);
+    auto far = CreateSquare(L"Far", wxPoint(1000, 600), 50);
+    picture->AddActor(bottom);
+    picture->AddActor(top);
+    picture->AddActor(far);
+
+    std::shared_ptr<Actor> actor;
+
+    // Nothing here
+    ASSERT_EQ(nullptr, picture->HitTest(wxPoint(50, 50), actor));
+    ASSERT_EQ(nullptr, actor);
+
+    // Only the bottom square
+    ASSERT_EQ(bottom->GetDrawables()[0], picture->HitTest(wxPoint(150, 150), actor));
+    ASSERT_EQ(bottom, actor);
+
+    // Where they overlap the one drawn last is on top
+    ASSERT_EQ(top->GetDrawables()[0], picture->HitTest(wxPoint(275, 275), actor));
+    ASSERT_EQ(top, actor);
+
+    ASSERT_EQ(far->GetDrawables()[0], picture->HitTest(wxPoint(1025, 625), actor));
+
+    // Actors that are not clickable are skipped
+    top->SetClickable(false);
+    ASSERT_EQ(bottom->GetDrawables()[0], picture->HitTest(wxPoint(275, 275), actor));
+    top->SetClickable(true);
+
+    // Moving an actor refiles it without drawing
+    far->SetPosition(wxPoint(20, 20));
+    ASSERT_EQ(nullptr, picture->HitTest(wxPoint(1025, 625), actor));
+    ASSERT_EQ(far->GetDrawables()[0], picture->HitTest(wxPoint(30, 30), actor));
+
+    // Moving across cells into negative coordinates
+    far->SetPosition(wxPoint(-300, -300));
+    ASSERT_EQ(far->GetDrawables()[0], picture->HitTest(wxPoint(-275, -275), actor));
+    ASSERT_EQ(nullptr, picture->HitTest(wxPoint(30, 30), actor));
+}
+
+TEST(PickIndexTest, Animation)
+{
+    auto picture = std::make_shared<Picture>();
+    auto timeline = picture->GetTimeline();
+
+    auto still = CreateSquare(L"Still", wxPoint(100, 100), 50);
+    auto moving = CreateSquare(L"Moving", wxPoint(1000, 600), 50);
+    picture->AddActor(still);
+    picture->AddActor(moving);
+
+    // The moving actor goes to the top left at frame 10
+    picture->SetAnimationTime(0);
+    moving->SetKeyframe();
+    picture->SetAnimationTime(10.0 / timeline->GetFrameRate());
+    moving->SetPosition(wxPoint(20, 20));
+    moving->SetKeyframe();
+
+    std::shared_ptr<Actor> actor;
+
+    // Changing the time refiles only the actors that moved
+    picture->SetAnimationTime(0);
+    ASSERT_EQ(moving->GetDrawables()[0], picture->HitTest(wxPoint(1025, 625), actor));
+    ASSERT_EQ(nullptr, picture->HitTest(wxPoint(30, 30), actor));
+    ASSERT_EQ(still->GetDrawables()[0], picture->HitTest(wxPoint(125, 125), actor));
+
+    picture->SetAnimationTime(10.0 / timeline->GetFrameRate());
+    ASSERT_EQ(nullptr, picture->HitTest(wxPoint(1025, 625), actor));
+    ASSERT_EQ(moving->GetDrawables()[0], picture->HitTest(wxPoint(30, 30), actor));
+    ASSERT_EQ(still->GetDrawables()[0], picture->HitTest(wxPoint(125, 125), actor));
+}
@@ -7,6 +7,8 @@
 #include "gtest/gtest.h"
 #include <PictureObserver.h>
 #include <Picture.h>
+#include <Actor.h>
+#include <Drawable.h>
 
 class PictureObserverMock : public PictureObserver
 {
@@ -15,7 +17,22 @@ public:
 
     void UpdateObserver() override { mUpdated = true; }
 
+    void OnPictureChanged(int changes, const wxRect &region) override
+    {
+        mChanges |= changes;
+        mRegion = region;
+        PictureObserver::OnPictureChanged(changes, region);
+    }
+
+    /**
+     * Choose which changes the mock is told about
+     * @param changes Mask of PictureChange values
+     */
+    void SubscribeTo(int changes) { Subscribe(changes); }
+
     bool mUpdated = false;
+    int mChanges = 0;
+    wxRect mRegion;
 };
 
 TEST(PictureObserverTest, Construct) {
@@ -90,4 +107,91 @@ TEST(PictureObserverTest, DestroyedObservers)
     picture->UpdateObservers();
 
     ASSERT_TRUE(observer1.mUpdated);
-}
\ No newline at end of file
+}
+
+TEST(PictureObserverTest, Subscriptions)
+{
+    auto picture = std::make_shared<Picture>();
+
+    PictureObserverMock all;
+    all.SetPicture(picture);
+
+    PictureObserverMock geometry;
+    geometry.SubscribeTo(ChangeGeometry);
+    geometry.SetPicture(picture);
+
+    // Only the time changed, so the geometry observer is not told
+    picture->UpdateObservers(ChangeTime);
+    ASSERT_TRUE(all.mUpdated);
+    ASSERT_EQ(ChangeTime, all.mChanges);
+    ASSERT_FALSE(geometry.mUpdated);
+
+    picture->UpdateObservers(ChangeTime | ChangeGeometry, wxRect(10, 20, 30, 40));
+    ASSERT_TRUE(geometry.mUpdated);
+    ASSERT_EQ(ChangeTime | ChangeGeometry, geometry.mChanges);
+    ASSERT_EQ(wxRect(10, 20, 30, 40), geometry.mRegion);
+
+    // Everything is a change anybody listens to
+    PictureObserverMock machines;
+    machines.SubscribeTo(ChangeMachines);
+    machines.SetPicture(picture);
+    picture->UpdateObservers();
+    ASSERT_TRUE(machines.mUpdated);
+}
+
+TEST(PictureObserverTest, ChangedRegion)
+{
+    // The region covers where something was and where it is now
+    auto region = Picture::ChangedRegion(wxRect(10, 10, 20, 20), wxRect(50, 15, 20, 20));
+    ASSERT_TRUE(region.Contains(wxRect(10, 10, 20, 20)));
+    ASSERT_TRUE(region.Contains(wxRect(50, 15, 20, 20)));
+    ASSERT_TRUE(region.Contains(wxRect(30, 10, 20, 25)));
+
+    // Unknown bounds mean the whole picture
+    ASSERT_TRUE(Picture::ChangedRegion(wxRect(), wxRect(50, 15, 20, 20)).IsEmpty());
+    ASSERT_TRUE(Picture::ChangedRegion(wxRect(10, 10, 20, 20), wxRect()).IsEmpty());
+}
+
+/**
+ * A drawable that runs in place, like a machine
+ */
+class InPlaceDrawable : public Drawable
+{
+public:
+    InPlaceDrawable() : Drawable(L"InPlace") {}
+
+    void SetActor(Actor *actor) override
+    {
+        Drawable::SetActor(actor);
+        SetBounds(wxRect(100, 200, 50, 60));
+    }
+
+    void Draw(std::shared_ptr<wxGraphicsContext> graphics) override {}
+    bool HitTest(wxPoint pos) override { return false; }
+    bool ChangesWithTime() override { return true; }
+};
+
+TEST(PictureObserverTest, ChangesWithTime)
+{
+    auto picture = std::make_shared<Picture>();
+    auto actor = std::make_shared<Actor>(L"Machine");
+    actor->AddDrawable(std::make_shared<InPlaceDrawable>());
+    picture->AddActor(actor);
+    ASSERT_TRUE(actor->ChangesWithTime());
+
+    PictureObserverMock geometry;
+    geometry.SubscribeTo(ChangeGeometry);
+    geometry.SetPicture(picture);
+
+    // It never moves, but only where it is is repainted each frame
+    picture->SetAnimationTime(0.5);
+    ASSERT_TRUE(geometry.mUpdated);
+    ASSERT_TRUE(geometry.mRegion.Contains(wxRect(100, 200, 50, 60)));
+    ASSERT_TRUE(wxRect(90, 190, 70, 80).Contains(geometry.mRegion));
+
+    geometry.mUpdated = false;
+    picture->SetAnimationTime(1.0);
+    ASSERT_TRUE(geometry.mUpdated);
+    ASSERT_TRUE(geometry.mRegion.Contains(wxRect(100, 200, 50, 60)));
+    ASSERT_TRUE(wxRect(90, 190, 70, 80).Contains(geometry.mRegion));
+}
@@ -7,6 +7,7 @@
 #include "gtest/gtest.h"
 #include <Picture.h>
 #include <Actor.h>
+#include <PolyDrawable.h>
 
 using namespace std;
 
@@ -80,4 +81,110 @@ TEST(PictureTest, GetTimeline)
 
     Timeline *timeline = picture.GetTimeline();
     ASSERT_NE(nullptr, timeline);
-}
\ No newline at end of file
+}
+
+/**
+ * Create a picture of many actors with jointed arms
+ * whose positions and rotations are keyframed
+ * @param numActors Number of actors
+ * @return The picture
+ */
+static shared_ptr<Picture> CreateCrowd(int numActors)
+{
+    auto picture = make_shared<Picture>();
+    for (int a = 0; a < numActors; a++)
+    {
+        auto actor = make_shared<Actor>(L"Actor" + to_wstring(a));
+        actor->SetPosition(wxPoint(a * 10, 100));
+
+        shared_ptr<Drawable> parent;
+        for (int d = 0; d < 4; d++)
+        {
+            auto segment = make_shared<PolyDrawable>(L"Segment" + to_wstring(d));
+            segment->AddPoint(wxPoint(-5, 0));
+            segment->AddPoint(wxPoint(5, 0));
+            segment->AddPoint(wxPoint(5, 40));
+            segment->AddPoint(wxPoint(-5, 40));
+            actor->AddDrawable(segment);
+            if (parent == nullptr)
+            {
+                actor->SetRoot(segment);
+            }
+            else
+            {
+                segment->SetPosition(wxPoint(0, 40));
+                parent->AddChild(segment);
+            }
+
+            parent = segment;
+        }
+
+        picture->AddActor(actor);
+    }
+
+    auto timeline = picture->GetTimeline();
+    for (int frame = 0; frame <= 60; frame += 20)
+    {
+        picture->SetAnimationTime((double)frame / timeline->GetFrameRate());
+
+        int a = 0;
+        for (auto actor : *picture)
+        {
+            a++;
+            actor->SetPosition(wxPoint(a * 10 + frame, 100 + (a * frame) % 30));
+            int d = 0;
+            for (auto drawable : actor->GetDrawables())
+            {
+                d++;
+                drawable->SetRotation(0.01 * (a + d) * frame);
+            }
+
+            actor->SetKeyframe();
+        }
+    }
+
+    return picture;
+}
+
+TEST(PictureTest, ParallelAnimation)
+{
+    auto serial = CreateCrowd(200);
+    auto parallel = CreateCrowd(200);
+    serial->GetThreadPool()->SetNumThreads(1);
+    parallel->GetThreadPool()->SetNumThreads(4);
+
+    // Playing forward, stepping back, and jumping place
+    // every drawable exactly where a single thread does
+    for (int frame : {0, 1, 2, 13, 27, 26, 60, 5, 45})
+    {
+        double time = frame / 30.0;
+        serial->SetAnimationTime(time);
+        parallel->SetAnimationTime(time);
+
+        auto actor = parallel->begin();
+        for (auto expected : *serial)
+        {
+            auto drawables = (*actor)->GetDrawables();
+            auto expectedDrawables = expected->GetDrawables();
+            for (size_t d = 0; d < drawables.size(); d++)
+            {
+                ASSERT_EQ(expectedDrawables[d]->GetBounds(), drawables[d]->GetBounds());
+            }
+
+            ++actor;
+        }
+
+        shared_ptr<Actor> serialHit, parallelHit;
+        for (int x = 0; x < 2500; x += 37)
+        {
+            auto expected = serial->HitTest(wxPoint(x, 150), serialHit);
+            auto hit = parallel->HitTest(wxPoint(x, 150), parallelHit);
+            ASSERT_EQ(expected == nullptr, hit == nullptr);
+            if (hit != nullptr)
+            {
+                ASSERT_EQ(expected->GetName(), hit->GetName());
+                ASSERT_EQ(serialHit->GetName(), parallelHit->GetName());
+            }
+        }
+    }
+}
@@ -0,0 +1,86 @@
+/**
+ * @file PlaybackClockTest.cpp
+ * @author Shawn_Porto
+ */
+
+#include <pch.h>
+#include "gtest/gtest.h"
+
+#include <PlaybackClock.h>
+
+TEST(PlaybackClockTest, OnTime)
+{
+    PlaybackClock clock;
+    clock.Start(0, 30);
+    ASSERT_TRUE(clock.IsRunning());
+
+    // Frames presented right when they come due
+    for (int frame = 0; frame < 90; frame++)
+    {
+        ASSERT_EQ(frame, clock.Tick(frame / 30.0));
+    }
+
+    ASSERT_EQ(90, clock.GetPresented());
+    ASSERT_EQ(0, clock.GetDropped());
+    ASSERT_EQ(0, clock.GetLate());
+
+    // An early timer has nothing new to present
+    ASSERT_EQ(-1, clock.Tick(89.5 / 30.0));
+    ASSERT_EQ(90, clock.GetPresented());
+
+    clock.Stop();
+    ASSERT_FALSE(clock.IsRunning());
+}
+
+TEST(PlaybackClockTest, DroppedAndLate)
+{
+    PlaybackClock clock;
+    clock.Start(0, 30);
+
+    ASSERT_EQ(0, clock.Tick(0));
+
+    // A slow paint: frames 1 to 3 are skipped
+    ASSERT_EQ(4, clock.Tick(4.1 / 30.0));
+    ASSERT_EQ(3, clock.GetDropped());
+    ASSERT_EQ(0, clock.GetLate());
+
+    // Presented most of a frame after it was due
+    ASSERT_EQ(5, clock.Tick(5.8 / 30.0));
+    ASSERT_EQ(3, clock.GetDropped());
+    ASSERT_EQ(1, clock.GetLate());
+
+    // Starting again resets the statistics
+    clock.Start(0, 30);
+    ASSERT_EQ(0, clock.GetDropped());
+    ASSERT_EQ(0, clock.GetLate());
+    ASSERT_EQ(0, clock.GetPresented());
+}
+
+TEST(PlaybackClockTest, StartTime)
+{
+    // Starting part way through the animation
+    PlaybackClock clock;
+    clock.Start(2.0, 30);
+
+    ASSERT_EQ(60, clock.Tick(0));
+    ASSERT_EQ(61, clock.Tick(1.0 / 30.0));
+    ASSERT_EQ(0, clock.GetLate());
+}
+
+TEST(PlaybackClockTest, NextDelay)
+{
+    PlaybackClock clock;
+    clock.Start(0, 30);
+
+    // 30 frames a second is not a whole number of milliseconds
+    // apart, the delays follow the frames instead of drifting
+    ASSERT_EQ(0, clock.Tick(0));
+    ASSERT_EQ(34, clock.NextDelay(0));
+    ASSERT_EQ(1, clock.Tick(1.0 / 30.0));
+    ASSERT_EQ(34, clock.NextDelay(1.0 / 30.0));
+    ASSERT_EQ(2, clock.Tick(2.0 / 30.0));
+    ASSERT_EQ(33, clock.NextDelay(2.0 / 30.0 + 0.0005));
+
+    // Never less than a millisecond
+    ASSERT_EQ(1, clock.NextDelay(3.0 / 30.0));
+}
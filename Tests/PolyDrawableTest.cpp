@@ -69,6 +69,41 @@ TEST(PolyDrawableTest, HitTest)
     ASSERT_FALSE(poly1->HitTest(wxPoint(210, 490)));
 }
 
+TEST(PolyDrawableTest, HitTestMoved)
+{
+    wxBitmap bitmap(1000, 1000);
+    wxMemoryDC dc(bitmap);
+    auto graphics = std::shared_ptr<wxGraphicsContext>(wxGraphicsContext::Create( dc ));
+
+    auto actor = std::make_shared<Actor>(L"Square");
+
+    auto poly1 = std::make_shared<PolyDrawable>(L"Polygon");
+    poly1->AddPoint(wxPoint(0, 0));
+    poly1->AddPoint(wxPoint(100, 0));
+    poly1->AddPoint(wxPoint(100, 100));
+    poly1->AddPoint(wxPoint(0, 100));
+
+    actor->AddDrawable(poly1);
+    actor->SetRoot(poly1);
+
+    // Hit testing does not need the polygon to be drawn
+    ASSERT_EQ(poly1, actor->HitTest(wxPoint(50, 50)));
+
+    actor->Draw(graphics);
+    ASSERT_TRUE(poly1->HitTest(wxPoint(50, 50)));
+
+    // Moving the actor moves the hit area without new geometry
+    actor->SetPosition(wxPoint(300, 300));
+    actor->Draw(graphics);
+    ASSERT_FALSE(poly1->HitTest(wxPoint(50, 50)));
+    ASSERT_TRUE(poly1->HitTest(wxPoint(350, 350)));
+
+    // Adding a point rebuilds the geometry on the next draw
+    poly1->AddPoint(wxPoint(-100, 50));
+    actor->Draw(graphics);
+    ASSERT_TRUE(poly1->HitTest(wxPoint(230, 350)));
+}
+
 
 /** This tests that the animation of the rotation of a drawable works */
 TEST(PolyDrawableTest, Animation)
@@ -0,0 +1,23 @@
+/**
+ * @file RepaintSchedulerTest.cpp
+ * @author Shawn_Porto
+ */
+
+#include <pch.h>
+#include "gtest/gtest.h"
+
+#include <RepaintScheduler.h>
+
+TEST(RepaintSchedulerTest, Delay)
+{
+    // Right after a repaint we wait out the rest of the frame
+    ASSERT_EQ(RepaintInterval, RepaintScheduler::Delay(1000, 1000));
+    ASSERT_EQ(RepaintInterval - 5, RepaintScheduler::Delay(1005, 1000));
+
+    // Once a frame has passed the repaint happens right away
+    ASSERT_EQ(1, RepaintScheduler::Delay(1000 + RepaintInterval, 1000));
+    ASSERT_EQ(1, RepaintScheduler::Delay(5000, 1000));
+
+    // The very first request does not wait
+    ASSERT_EQ(1, RepaintScheduler::Delay(0, -RepaintInterval));
+}
@@ -0,0 +1,109 @@
+/**
+ * @file TextureAtlasTest.cpp
+ * @author Shawn_Porto
+ */
+
+#include <pch.h>
+#include "gtest/gtest.h"
+
+#include <TextureAtlas.h>
+
+/**
+ * Check that no two images on the same page overlap and
+ * that every image is inside its page.
+ * @param atlas Packed atlas to check
+ */
+static void CheckPacking(const TextureAtlas &atlas)
+{
+    for (int i = 0; i < atlas.GetNumImages(); i++)
+    {
+        auto &region = atlas.GetRegion(i);
+        ASSERT_GE(region.page, 0);
+        ASSERT_LT(region.page, atlas.GetNumPages());
+
+        auto size = atlas.GetPageSize(region.page);
+        ASSERT_GE(region.rect.GetLeft(), 0);
+        ASSERT_GE(region.rect.GetTop(), 0);
+        ASSERT_LE(region.rect.GetLeft() + region.rect.GetWidth(), size.GetWidth());
+        ASSERT_LE(region.rect.GetTop() + region.rect.GetHeight(), size.GetHeight());
+
+        for (int j = i + 1; j < atlas.GetNumImages(); j++)
+        {
+            auto &other = atlas.GetRegion(j);
+            if (other.page == region.page)
+            {
+                ASSERT_FALSE(region.rect.Intersects(other.rect)) << "Images " << i << " and " << j << " overlap";
+            }
+        }
+    }
+}
+
+TEST(TextureAtlasTest, Add)
+{
+    TextureAtlas atlas;
+    ASSERT_EQ(0, atlas.GetNumImages());
+
+    ASSERT_EQ(0, atlas.Add(L"a.png", wxImage(10, 20)));
+    ASSERT_EQ(1, atlas.Add(L"b.png", wxImage(30, 40)));
+
+    // The same file is only added once
+    ASSERT_EQ(0, atlas.Add(L"a.png", wxImage(10, 20)));
+    ASSERT_EQ(2, atlas.GetNumImages());
+
+    // Images that did not load are not added
+    ASSERT_EQ(-1, atlas.Add(L"missing.png", wxImage()));
+    ASSERT_EQ(2, atlas.GetNumImages());
+}
+
+TEST(TextureAtlasTest, Pack)
+{
+    TextureAtlas atlas;
+    for (int i = 0; i < 100; i++)
+    {
+        atlas.Add(L"image" + std::to_wstring(i) + L".png", wxImage(20 + (i * 37) % 150, 15 + (i * 53) % 200));
+    }
+
+    atlas.Pack();
+
+    // These all fit on one page
+    ASSERT_EQ(1, atlas.GetNumPages());
+    CheckPacking(atlas);
+
+    for (int i = 0; i < atlas.GetNumImages(); i++)
+    {
+        auto &rect = atlas.GetRegion(i).rect;
+        ASSERT_EQ(20 + (i * 37) % 150, rect.GetWidth());
+        ASSERT_EQ(15 + (i * 53) % 200, rect.GetHeight());
+    }
+}
+
+TEST(TextureAtlasTest, Pages)
+{
+    TextureAtlas atlas;
+
+    // More than a page worth of images
+    for (int i = 0; i < 40; i++)
+    {
+        atlas.Add(L"image" + std::to_wstring(i) + L".png", wxImage(500, 500));
+    }
+
+    // Larger than a page
+    atlas.Add(L"huge.png", wxImage(AtlasPageSize + 100, 100));
+
+    atlas.Pack();
+    CheckPacking(atlas);
+
+    ASSERT_EQ(4, atlas.GetNumPages());
+
+    auto &huge = atlas.GetRegion(40);
+    ASSERT_EQ(wxSize(AtlasPageSize + 100, 100), atlas.GetPageSize(huge.page));
+
+    for (int page = 0; page < atlas.GetNumPages(); page++)
+    {
+        if (page != huge.page)
+        {
+            ASSERT_LE(atlas.GetPageSize(page).GetWidth(), AtlasPageSize);
+            ASSERT_LE(atlas.GetPageSize(page).GetHeight(), AtlasPageSize);
+        }
+    }
+}
@@ -0,0 +1,83 @@
+/**
+ * @file ThreadPoolTest.cpp
+ * @author Shawn_Porto
+ */
+
+#include <pch.h>
+#include "gtest/gtest.h"
+
+#include <ThreadPool.h>
+
+TEST(ThreadPoolTest, EveryIndexOnce)
+{
+    ThreadPool pool;
+    pool.SetNumThreads(4);
+    ASSERT_EQ(4, pool.GetNumThreads());
+
+    std::vector<int> visits(10007);
+    for (int repeat = 0; repeat < 50; repeat++)
+    {
+        pool.ParallelFor((int)visits.size(), 64, [&visits](int first, int end) {
+            for (int i = first; i < end; i++)
+            {
+                visits[i]++;
+            }
+        });
+    }
+
+    for (auto count : visits)
+    {
+        ASSERT_EQ(50, count);
+    }
+}
+
+TEST(ThreadPoolTest, Blocks)
+{
+    ThreadPool pool;
+    pool.SetNumThreads(3);
+
+    // The blocks are the grain in size except the last
+    std::vector<int> sizes(10);
+    pool.ParallelFor(95, 10, [&sizes](int first, int end) {
+        sizes[first / 10] = end - first;
+    });
+
+    for (int i = 0; i < 9; i++)
+    {
+        ASSERT_EQ(10, sizes[i]);
+    }
+    ASSERT_EQ(5, sizes[9]);
+}
+
+TEST(ThreadPoolTest, Caller)
+{
+    ThreadPool pool;
+    pool.SetNumThreads(4);
+
+    // A loop that fits in one block runs on the caller
+    std::thread::id id;
+    pool.ParallelFor(10, 16, [&id](int first, int end) { id = std::this_thread::get_id(); });
+    ASSERT_EQ(std::this_thread::get_id(), id);
+
+    // So does every loop with one thread
+    pool.SetNumThreads(0);
+    ASSERT_EQ(1, pool.GetNumThreads());
+
+    std::vector<std::thread::id> ids(1000);
+    pool.ParallelFor((int)ids.size(), 1, [&ids](int first, int end) {
+        for (int i = first; i < end; i++)
+        {
+            ids[i] = std::this_thread::get_id();
+        }
+    });
+
+    for (auto threadId : ids)
+    {
+        ASSERT_EQ(std::this_thread::get_id(), threadId);
+    }
+
+    // Nothing to do
+    int calls = 0;
+    pool.ParallelFor(0, 1, [&calls](int first, int end) { calls++; });
+    ASSERT_EQ(0, calls);
+}
@@ -0,0 +1,70 @@
+/**
+ * @file TimelineRulerTest.cpp
+ * @author Shawn_Porto
+ */
+
+#include <pch.h>
+#include "gtest/gtest.h"
+
+#include <TimelineRuler.h>
+
+TEST(TimelineRulerTest, TickRange)
+{
+    int first, last;
+
+    // The whole timeline in view
+    ASSERT_TRUE(TimelineRuler::TickRange(0, 10000, 300, first, last));
+    ASSERT_EQ(0, first);
+    ASSERT_EQ(300, last);
+
+    // A slice in the middle, ticks exactly on the edges are included
+    ASSERT_TRUE(TimelineRuler::TickRange(BorderLeft + 10 * TickSpacing, BorderLeft + 20 * TickSpacing, 300, first, last));
+    ASSERT_EQ(10, first);
+    ASSERT_EQ(20, last);
+
+    // Edges between ticks
+    ASSERT_TRUE(TimelineRuler::TickRange(BorderLeft + 10 * TickSpacing + 1, BorderLeft + 20 * TickSpacing - 1, 300, first, last));
+    ASSERT_EQ(11, first);
+    ASSERT_EQ(19, last);
+
+    // Left of the start and past the end
+    ASSERT_TRUE(TimelineRuler::TickRange(-100, BorderLeft, 300, first, last));
+    ASSERT_EQ(0, first);
+    ASSERT_EQ(0, last);
+    ASSERT_FALSE(TimelineRuler::TickRange(-100, BorderLeft - 1, 300, first, last));
+    ASSERT_FALSE(TimelineRuler::TickRange(BorderLeft + 301 * TickSpacing, 100000, 300, first, last));
+}
+
+TEST(TimelineRulerTest, Strips)
+{
+    wxImage image(100, 100);
+    auto graphics = std::shared_ptr<wxGraphicsContext>(wxGraphicsContext::Create(image));
+
+    TimelineRuler ruler;
+    ruler.SetTimeline(3000, 30);
+
+    // Only the strips in view are rendered
+    ruler.Draw(graphics, 0, RulerStripWidth - 1);
+    ASSERT_EQ(1u, ruler.GetNumStrips());
+
+    ruler.Draw(graphics, RulerStripWidth / 2, RulerStripWidth * 3 / 2);
+    ASSERT_EQ(2u, ruler.GetNumStrips());
+
+    // The same timeline keeps them
+    ruler.SetTimeline(3000, 30);
+    ASSERT_EQ(2u, ruler.GetNumStrips());
+
+    // A new frame rate or length throws them away
+    ruler.SetTimeline(3000, 24);
+    ASSERT_EQ(0u, ruler.GetNumStrips());
+    ruler.Draw(graphics, 0, 100);
+    ruler.SetTimeline(2000, 24);
+    ASSERT_EQ(0u, ruler.GetNumStrips());
+
+    // Scrolling a long way only keeps a bounded number of strips
+    for (int strip = 0; strip < (int)RulerMaxStrips * 3; strip++)
+    {
+        ruler.Draw(graphics, strip * RulerStripWidth, strip * RulerStripWidth + 100);
+    }
+    ASSERT_LE(ruler.GetNumStrips(), RulerMaxStrips + 1);
+}
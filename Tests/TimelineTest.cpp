@@ -8,6 +8,36 @@
 
 #include <Timeline.h>
 #include <AnimChannelAngle.h>
+#include <AnimChannelObserver.h>
+
+#include <algorithm>
+
+/**
+ * Observer that counts how often a channel is pushed to it
+ */
+class CountingChannelObserver : public AnimChannelObserver {
+public:
+    /// Number of times the channel changed
+    int mChanged = 0;
+
+    /**
+     * Count a change
+     * @param channel Channel that changed
+     */
+    void OnChannelChanged(AnimChannel *channel) override { mChanged++; }
+};
+
+/**
+ * Is a channel in the changed list of a timeline?
+ * @param timeline Timeline to check
+ * @param channel Channel to look for
+ * @return true if the last SetCurrentTime evaluated the channel
+ */
+static bool Changed(Timeline &timeline, AnimChannel *channel)
+{
+    auto &changed = timeline.GetChangedChannels();
+    return std::find(changed.begin(), changed.end(), channel) != changed.end();
+}
 
 
 TEST(TimelineTest, NumFrames)
@@ -83,4 +113,171 @@ TEST(TimelineTest, Add)
 
     timeline.AddChannel(&channel);
     ASSERT_EQ(&timeline, channel.GetTimeline());
-}
\ No newline at end of file
+}
+
+TEST(TimelineTest, IntervalIndex)
+{
+    Timeline timeline;
+    timeline.SetFrameRate(32);
+
+    AnimChannelAngle animated;
+    AnimChannelAngle constant;
+    AnimChannelAngle empty;
+    timeline.AddChannel(&animated);
+    timeline.AddChannel(&constant);
+    timeline.AddChannel(&empty);
+
+    CountingChannelObserver observer;
+    animated.SetObserver(&observer);
+
+    // The animated channel changes from frame 32 to 64
+    timeline.SetCurrentTime(1);
+    animated.SetKeyframe(1.0);
+    constant.SetKeyframe(5.0);
+    timeline.SetCurrentTime(2);
+    animated.SetKeyframe(2.0);
+
+    // New keyframes evaluate every channel with keyframes
+    observer.mChanged = 0;
+    timeline.SetCurrentTime(0);
+    ASSERT_TRUE(Changed(timeline, &animated));
+    ASSERT_TRUE(Changed(timeline, &constant));
+    ASSERT_FALSE(Changed(timeline, &empty));
+    ASSERT_EQ(1, observer.mChanged);
+
+    // Before the first keyframe nothing changes
+    timeline.SetCurrentTime(0.5);
+    ASSERT_TRUE(timeline.GetChangedChannels().empty());
+
+    // Between the keyframes only the animated channel is evaluated
+    for (int frame = 32; frame <= 64; frame++)
+    {
+        timeline.SetCurrentTime(frame / 32.0);
+        ASSERT_TRUE(Changed(timeline, &animated));
+        ASSERT_FALSE(Changed(timeline, &constant));
+        ASSERT_NEAR(1.0 + (frame - 32) / 32.0, animated.GetAngle(), 0.00001);
+    }
+
+    // Stepping past the last keyframe evaluates it once more, then never
+    timeline.SetCurrentTime(65 / 32.0);
+    ASSERT_TRUE(Changed(timeline, &animated));
+    ASSERT_NEAR(2.0, animated.GetAngle(), 0.00001);
+    timeline.SetCurrentTime(80 / 32.0);
+    ASSERT_TRUE(timeline.GetChangedChannels().empty());
+
+    // The same time again does nothing
+    timeline.SetCurrentTime(80 / 32.0);
+    ASSERT_TRUE(timeline.GetChangedChannels().empty());
+
+    // Jumping across the whole animation gets the right value
+    timeline.SetCurrentTime(0);
+    ASSERT_NEAR(1.0, animated.GetAngle(), 0.00001);
+    timeline.SetCurrentTime(3);
+    ASSERT_NEAR(2.0, animated.GetAngle(), 0.00001);
+    timeline.SetCurrentTime(1.5);
+    ASSERT_NEAR(1.5, animated.GetAngle(), 0.00001);
+
+    // An invalidated channel is evaluated even when it is constant
+    constant.Invalidate();
+    timeline.SetCurrentTime(1.5);
+    ASSERT_TRUE(Changed(timeline, &constant));
+    ASSERT_FALSE(Changed(timeline, &animated));
+    ASSERT_NEAR(5.0, constant.GetAngle(), 0.00001);
+}
+
+TEST(TimelineTest, Load)
+{
+    Timeline timeline;
+    AnimChannelAngle channel1;
+    AnimChannelAngle channel2;
+    channel1.SetName(L"one");
+    channel2.SetName(L"two");
+    timeline.AddChannel(&channel1);
+    timeline.AddChannel(&channel2);
+
+    CountingChannelObserver observer;
+    channel2.SetObserver(&observer);
+
+    // Add a keyframe node to a channel node
+    auto keyframe = [](wxXmlNode *channelNode, const wchar_t *frame, const wchar_t *angle) {
+        auto node = new wxXmlNode(wxXML_ELEMENT_NODE, L"keyframe");
+        node->AddAttribute(L"frame", frame);
+        node->AddAttribute(L"angle", angle);
+        channelNode->AddChild(node);
+    };
+
+    wxXmlNode root(wxXML_ELEMENT_NODE, L"anim");
+    root.AddAttribute(L"numframes", L"600");
+    root.AddAttribute(L"framerate", L"30");
+
+    auto node = new wxXmlNode(wxXML_ELEMENT_NODE, L"channel");
+    node->AddAttribute(L"name", L"two");
+    root.AddChild(node);
+
+    // Out of order and repeated keyframes still end up sorted
+    keyframe(node, L"60", L"3.0");
+    keyframe(node, L"10", L"1.0");
+    keyframe(node, L"30", L"9.0");
+    keyframe(node, L"30", L"2.0");
+
+    node = new wxXmlNode(wxXML_ELEMENT_NODE, L"channel");
+    node->AddAttribute(L"name", L"missing");
+    root.AddChild(node);
+    keyframe(node, L"0", L"7.0");
+
+    timeline.Load(&root);
+
+    ASSERT_EQ(600, timeline.GetNumFrames());
+    ASSERT_FALSE(channel1.IsValid());
+    ASSERT_EQ(3, channel2.GetNumKeyframes());
+    ASSERT_EQ(10, channel2.GetKeyframeFrame(0));
+    ASSERT_EQ(30, channel2.GetKeyframeFrame(1));
+    ASSERT_EQ(60, channel2.GetKeyframeFrame(2));
+    ASSERT_NEAR(2.0, channel2.GetKeyframeAngle(1), 0.00001);
+
+    // The timeline is evaluated once, at time zero
+    ASSERT_EQ(1, observer.mChanged);
+    ASSERT_NEAR(0, timeline.GetCurrentTime(), 0.00001);
+    ASSERT_NEAR(1.0, channel2.GetAngle(), 0.00001);
+}
+
+TEST(TimelineTest, KeyframeSummary)
+{
+    Timeline timeline;
+    AnimChannelAngle channel1;
+    AnimChannelAngle channel2;
+    timeline.AddChannel(&channel1);
+    timeline.AddChannel(&channel2);
+
+    auto &summary = timeline.GetKeyframeSummary();
+
+    // Keyframes are counted as they are set
+    timeline.SetCurrentTime(1);
+    channel1.SetKeyframe(1.0);
+    channel2.SetKeyframe(2.0);
+    timeline.SetCurrentTime(2);
+    channel1.SetKeyframe(3.0);
+
+    ASSERT_EQ(3, summary.GetTotal().count);
+    ASSERT_EQ(2, summary.Summarize(30, 31).count);
+    ASSERT_EQ(1, summary.Summarize(60, 61).count);
+
+    // Replacing a keyframe does not count it twice
+    channel1.SetKeyframe(4.0);
+    ASSERT_EQ(3, summary.GetTotal().count);
+
+    // Clearing the keyframes on a frame
+    timeline.SetCurrentTime(1);
+    timeline.ClearKeyframe();
+    ASSERT_EQ(1, summary.GetTotal().count);
+    ASSERT_EQ(0, summary.Summarize(30, 31).count);
+
+    // Loading replaces a channel's keyframes
+    const int frames[] = {5, 6, 7};
+    const double angles[] = {0, 1, 2};
+    ASSERT_TRUE(channel2.LoadKeyframes(frames, angles, 3));
+    ASSERT_EQ(4, summary.GetTotal().count);
+
+    timeline.Clear();
+    ASSERT_EQ(0, summary.GetTotal().count);
+}
@@ -0,0 +1,116 @@
+/**
+ * @file TraceTest.cpp
+ * @author Shawn_Porto
+ */
+
+#include <pch.h>
+#include "gtest/gtest.h"
+
+#include <sstream>
+#include <thread>
+
+#include <Trace.h>
+
+using namespace std;
+
+/**
+ * Count the number of times a string occurs in another
+ * @param text Text to search
+ * @param pattern What we are looking for
+ * @return Number of occurrences
+ */
+static int CountOccurrences(const string &text, const string &pattern)
+{
+    int count = 0;
+    for (auto pos = text.find(pattern); pos != string::npos; pos = text.find(pattern, pos + 1))
+    {
+        count++;
+    }
+    return count;
+}
+
+/**
+ * Get the current trace as a string
+ * @return Chrome trace JSON
+ */
+static string TraceJson()
+{
+    stringstream stream;
+    Tracer::Get().Write(stream);
+    return stream.str();
+}
+
+TEST(TraceTest, Disabled)
+{
+    Tracer::SetEnabled(false);
+    Tracer::Get().Clear();
+
+    {
+        TraceSpan span("TraceTest::Disabled");
+    }
+
+    ASSERT_EQ(0, CountOccurrences(TraceJson(), "TraceTest::Disabled"));
+}
+
+TEST(TraceTest, Span)
+{
+    Tracer::Get().Clear();
+    Tracer::SetEnabled(true);
+
+    {
+        TraceSpan outer("TraceTest::Outer");
+        TraceSpan inner("TraceTest::Inner");
+    }
+
+    Tracer::SetEnabled(false);
+
+    auto json = TraceJson();
+    ASSERT_EQ(0u, json.find("{\"traceEvents\":["));
+    ASSERT_EQ(1, CountOccurrences(json, "\"name\":\"TraceTest::Outer\""));
+    ASSERT_EQ(1, CountOccurrences(json, "\"name\":\"TraceTest::Inner\""));
+    ASSERT_EQ(2, CountOccurrences(json, "\"ph\":\"X\""));
+
+    // Clearing discards what was recorded
+    Tracer::Get().Clear();
+    ASSERT_EQ(0, CountOccurrences(TraceJson(), "TraceTest::Outer"));
+}
+
+TEST(TraceTest, RingOverwrite)
+{
+    Tracer::Get().Clear();
+    Tracer::SetEnabled(true);
+
+    for (int i = 0; i < Tracer::BufferCapacity + 10; i++)
+    {
+        TraceSpan span("TraceTest::Ring");
+    }
+
+    Tracer::SetEnabled(false);
+
+    // Only the most recent spans are kept
+    ASSERT_EQ(Tracer::BufferCapacity, CountOccurrences(TraceJson(), "TraceTest::Ring"));
+    Tracer::Get().Clear();
+}
+
+TEST(TraceTest, Threads)
+{
+    Tracer::Get().Clear();
+    Tracer::SetEnabled(true);
+
+    auto worker = []() {
+        for (int i = 0; i < 100; i++)
+        {
+            TraceSpan span("TraceTest::Thread");
+        }
+    };
+
+    thread thread1(worker);
+    thread thread2(worker);
+    thread1.join();
+    thread2.join();
+
+    Tracer::SetEnabled(false);
+
+    ASSERT_EQ(200, CountOccurrences(TraceJson(), "TraceTest::Thread"));
+    Tracer::Get().Clear();
+}